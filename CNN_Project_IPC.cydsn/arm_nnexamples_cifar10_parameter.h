@@ -53,4 +53,15 @@
 #define IP1_IM_CH 32
 #define IP1_OUT 10
 
+/* Early-exit head after pool2: FC + softmax on the pool2 output. It is only
+   used when the weights header provides EXIT1_WT/EXIT1_BIAS and the
+   EXIT1_BIAS_LSHIFT/EXIT1_OUT_RSHIFT shifts, stored like IP1_WT in the
+   arm_fully_connected_q7_opt interleaved format. */
+#define EXIT1_DIM 8*8*16
+#define EXIT1_IM_DIM 8
+#define EXIT1_IM_CH 16
+#define EXIT1_OUT 10
+/* Softmax confidence (q7, 128 = 100%) needed to skip conv3/pool3/ip1 */
+#define EXIT1_THRESHOLD 115
+
 /* [] END OF FILE */
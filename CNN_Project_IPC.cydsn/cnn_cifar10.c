@@ -0,0 +1,1200 @@
+/******************************************************************************
+*   File Name: cnn_cifar10.c
+*
+* Description: CIFAR-10 CNN executed by CM4. Each layer is timed with the
+*              SysTick and, with CNN_TRACE, reported over the UART.
+*
+*              When the early-exit head is available (see cnn_cifar10.h),
+*              a small fully-connected layer + softmax runs on the pool2
+*              output. If its top confidence reaches the exit threshold the
+*              result is returned right away and conv3/pool3/ip1 are skipped.
+*
+*              The ReLU of conv2 and conv3 is fused into the dense
+*              convolutions, only the int4 and sparse kernels need the
+*              separate pass.
+*
+*              With CNN_ZERO_SKIP, the dense conv2 and conv3 skip the
+*              all-zero groups of input channels left by ReLU and pooling.
+*              CNN_ZERO_STATS counts how many there are per layer.
+*
+*              With CNN_BITMAP, pool1 writes a bitmap of its non-zero
+*              outputs and the packed values, and conv2 expands only the
+*              input rows its current output row needs. The bitmap takes
+*              the place of the dense pool1 output, the buffers keep
+*              their size.
+*
+*              With CNN_WEIGHT_STREAM, the conv2 and conv3 weights of
+*              CNN_Run are read block by block from a backing store
+*              (weight_stream.h) into a double buffer, overlapped with the
+*              computation. The other run functions keep the built-in
+*              weights and are ruled out by cnn_cifar10.h.
+*
+*              With CNN_SPARSE, conv2, conv3 and ip1 use the block-sparse
+*              weights generated by NN/Scripts/prune_model.py.
+*
+*              With CNN_INT4, they use the packed 4-bit weights generated
+*              by NN/Scripts/pack_int4.py instead.
+*
+*              With CNN_INCREMENTAL, CNN_RunIncremental keeps the output of
+*              each layer between frames and only recomputes the region
+*              affected by the pixels that changed.
+*
+*              With CNN_MIXED, CNN_RunMixed keeps each tensor in the q7 or
+*              q15 precision picked by NN/Scripts/select_precision.py. The
+*              layers with a q15 input or output run the mixed q7 weight /
+*              q15 activation kernels on the same weights.
+*
+*              The last layer keeps its int32 accumulators, the top classes
+*              are picked from them directly. Its input comes out of ReLU
+*              and pooling and is mostly zero, only the weight columns of
+*              the non-zero inputs are read. The softmax only runs when
+*              CNN_GetScores asks for the probabilities.
+*
+* Hardware Dependency: PSoC 6 BLE Pioneer kit CY8CKIT-062-BLE
+****************************************************************************/
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+#include "cnn_cifar10.h"
+
+/*******************************************************************************
+*            Global variables
+*******************************************************************************/
+extern volatile uint32_t SysTickCnt;     /* SysTick counter, see main_cm4.c */
+
+//Variable used to calculate delay for each CNN function
+uint32_t cnt_init = 0;
+uint32_t cnt_fin = 0; 
+uint32_t scale = 0;
+uint32_t t_initial = 0;
+uint32_t t_final = 0;
+uint32_t total_time_nano = 0;
+uint32_t sup_time_nano = 0;
+
+/* ReLU of conv2 and conv3, applied in the requantization of the dense kernels */
+static const arm_nn_act reluAct = { ARM_ACT_RELU, 0, 0 };
+
+/* Largest number of non-zero pool3 outputs for which ip1 only reads the
+   weight columns of the non-zero inputs. Above it the dense kernel is
+   faster. The sample images leave about 1 in 5 non-zero. */
+#define IP1_MAX_NNZ     (IP1_DIM / 4)
+
+/* Softmax confidence (q7, 128 = 100%) needed to take the early exit. A value
+   of 128 can never be reached and disables the early exit. */
+static uint8_t exitThreshold = EXIT1_THRESHOLD;
+
+/* Variant run by the next inferences, see CNN_SetVariant */
+static cnn_variant_t variant = CNN_VARIANT_FULL;
+
+/* Stride of conv2 in CNN_VARIANT_STRIDED, its output takes the place of pool2 */
+#define CONV2_STRIDED_STRIDE    (2 * CONV2_STRIDE)
+#if (CONV2_IM_DIM + 2 * CONV2_PADDING - CONV2_KER_DIM) / CONV2_STRIDED_STRIDE + 1 != POOL2_OUT_DIM
+    #error "conv2 at CONV2_STRIDED_STRIDE does not have the size of pool2"
+#endif
+
+/* Console output of the layer trace, see CNN_TRACE */
+#ifdef CNN_TRACE
+    #define CNN_PUTS(s)         Cy_SCB_UART_PutString(UART_HW, s)
+    #define CNN_PRINTF(...)     printf(__VA_ARGS__)
+#else
+    #define CNN_PUTS(s)         ((void) 0)
+    #define CNN_PRINTF(...)     ((void) 0)
+#endif
+
+/****************************************************************************
+*            Prototype Functions
+*****************************************************************************/
+void calculateDelay(uint32_t cnt_init, uint32_t cnt_fin, uint32_t scale);
+
+// include the input and weights
+static q7_t conv1_wt[CONV1_IM_CH * CONV1_KER_DIM * CONV1_KER_DIM * CONV1_OUT_CH] = CONV1_WT;
+static q7_t conv1_bias[CONV1_OUT_CH] = CONV1_BIAS;
+
+static q7_t conv2_wt[CONV2_IM_CH * CONV2_KER_DIM * CONV2_KER_DIM * CONV2_OUT_CH] = CONV2_WT;
+static q7_t conv2_bias[CONV2_OUT_CH] = CONV2_BIAS;
+
+static q7_t conv3_wt[CONV3_IM_CH * CONV3_KER_DIM * CONV3_KER_DIM * CONV3_OUT_CH] = CONV3_WT;
+static q7_t conv3_bias[CONV3_OUT_CH] = CONV3_BIAS;
+
+static q7_t ip1_wt[IP1_DIM * IP1_OUT] = IP1_WT;
+static q7_t ip1_bias[IP1_OUT] = IP1_BIAS;
+
+#ifdef CNN_SPARSE
+static q7_t     conv2_sp_wt[4 * CONV2_SP_NNZ] = CONV2_SP_WT;
+static uint16_t conv2_sp_idx[CONV2_SP_NNZ] = CONV2_SP_IDX;
+static uint16_t conv2_sp_ptr[CONV2_OUT_CH + 1] = CONV2_SP_PTR;
+
+static q7_t     conv3_sp_wt[4 * CONV3_SP_NNZ] = CONV3_SP_WT;
+static uint16_t conv3_sp_idx[CONV3_SP_NNZ] = CONV3_SP_IDX;
+static uint16_t conv3_sp_ptr[CONV3_OUT_CH + 1] = CONV3_SP_PTR;
+
+static q7_t     ip1_sp_wt[4 * IP1_SP_NNZ] = IP1_SP_WT;
+static uint16_t ip1_sp_idx[IP1_SP_NNZ] = IP1_SP_IDX;
+static uint16_t ip1_sp_ptr[IP1_OUT + 1] = IP1_SP_PTR;
+#endif
+
+#ifdef CNN_INT4
+/* const so that the packed weights stay in flash */
+static const q7_t    conv2_i4_wt[CONV2_IM_CH * CONV2_KER_DIM * CONV2_KER_DIM * CONV2_OUT_CH / 2] = CONV2_I4_WT;
+static const uint8_t conv2_i4_shift[CONV2_OUT_CH] = CONV2_I4_SHIFT;
+
+static const q7_t    conv3_i4_wt[CONV3_IM_CH * CONV3_KER_DIM * CONV3_KER_DIM * CONV3_OUT_CH / 2] = CONV3_I4_WT;
+static const uint8_t conv3_i4_shift[CONV3_OUT_CH] = CONV3_I4_SHIFT;
+
+static const q7_t    ip1_i4_wt[IP1_DIM * IP1_OUT / 2] = IP1_I4_WT;
+static const uint8_t ip1_i4_shift[IP1_OUT] = IP1_I4_SHIFT;
+#endif
+
+#ifdef CNN_EARLY_EXIT
+static q7_t exit1_wt[EXIT1_DIM * EXIT1_OUT] = EXIT1_WT;
+static q7_t exit1_bias[EXIT1_OUT] = EXIT1_BIAS;
+
+/* Softmax of the early-exit head, compared against the exit threshold */
+static q7_t exitProb[EXIT1_OUT];
+#endif
+
+#if defined(CNN_MIXED) && CONV3_Q15
+/* ip1 interleaved for arm_fully_connected_mat_q7_vec_q15_opt_q31, which pairs
+   the columns differently from arm_fully_connected_q7_opt */
+static q7_t ip1_vq15_wt[IP1_DIM * IP1_OUT] = IP1_WT_VEC_Q15;
+#endif
+
+//vector buffer: max(im2col buffer,average pool buffer, fully connected buffer)
+q7_t      col_buffer[2 * 5 * 5 * 32 * 2];
+
+#ifdef CNN_MIXED
+/* twice the room for the q15 tensors of CNN_RunMixed: conv output first,
+   pooled activations after it */
+q7_t      scratch_buffer[2 * 32 * 32 * 10 * 4];
+#else
+q7_t      scratch_buffer[32 * 32 * 10 * 4];
+#endif
+
+#ifdef CNN_WEIGHT_STREAM
+/* Default weight store, in the internal flash. With the weights in the QSPI
+   flash, pass its XIP address or another backend to CNN_SetWeightStore. */
+static const struct
+{
+    q7_t conv2[CNN_WS_CONV3_OFFSET];
+    q7_t conv3[CNN_WS_STORE_SIZE - CNN_WS_CONV3_OFFSET];
+} cnnWeightStore = { CONV2_WT, CONV3_WT };
+
+/* Double buffer, sized for a block of conv2 which has the larger filters */
+#define CNN_WS_BLOCK_SIZE   (CNN_WS_BLOCK_FILTERS * CONV2_IM_CH * CONV2_KER_DIM * CONV2_KER_DIM)
+static q31_t wsBuffer[2][CNN_WS_BLOCK_SIZE / 4];
+
+static ws_stream_t          weightStream;
+static const ws_backend_t  *wsBackend = &WS_MemBackend;
+static void                *wsStore = (void *) &cnnWeightStore;
+static ws_copy_store_t      wsCopyStore;
+#endif
+
+/* Scores of the last classification (accumulators of ip1 or of the early-exit
+   head) and the right-shift that brings them to q7, see CNN_GetScores */
+static q31_t    lastScores[IP1_OUT];
+static uint16_t lastScoresShift = IP1_OUT_RSHIFT;
+
+#ifdef CNN_INCREMENTAL
+/* Per-layer results of the previous frame, kept across calls so that only the
+   part of each layer whose receptive field changed is recomputed. The conv
+   caches hold the output after ReLU. */
+static q7_t inCache[CONV1_IM_DIM * CONV1_IM_DIM * CONV1_IM_CH];
+static q7_t conv1Cache[CONV1_OUT_DIM * CONV1_OUT_DIM * CONV1_OUT_CH];
+static q7_t pool1Cache[POOL1_OUT_DIM * POOL1_OUT_DIM * CONV1_OUT_CH];
+static q7_t conv2Cache[CONV2_OUT_DIM * CONV2_OUT_DIM * CONV2_OUT_CH];
+static q7_t pool2Cache[POOL2_OUT_DIM * POOL2_OUT_DIM * CONV2_OUT_CH];
+static q7_t conv3Cache[CONV3_OUT_DIM * CONV3_OUT_DIM * CONV3_OUT_CH];
+static q7_t pool3Cache[POOL3_OUT_DIM * POOL3_OUT_DIM * CONV3_OUT_CH];
+
+/* Caches are only valid after the first frame */
+static bool cacheValid = false;
+
+/* Part of pool2 not yet propagated to conv3, when the early exit was taken */
+static arm_nn_rect pool2Pending;
+
+/* Result of the previous frame, returned as is when the input is unchanged.
+   Changing the exit threshold invalidates it. */
+static cnn_result_t lastResult;
+static cnn_exit_t lastExit = CNN_EXIT_FULL;
+static bool       lastValid = false;
+#endif /* CNN_INCREMENTAL */
+
+/*******************************************************************************
+* Function Name: CNN_Preprocess
+********************************************************************************
+* Summary:
+*   Converts the 8-bit RGB image to q7, removing the mean of each channel.
+*
+*******************************************************************************/
+static void CNN_Preprocess(const uint8_t *image_data, q7_t *img_out)
+{
+    int mean_data[3] = INPUT_MEAN_SHIFT;
+    unsigned int scale_data[3] = INPUT_RIGHT_SHIFT;
+    
+    for (int i=0;i<32*32*3; i+=3) {
+        img_out[i] =   (q7_t)__SSAT( ((((int)image_data[i]   - mean_data[0])<<7) + (0x1<<(scale_data[0]-1)))
+                             >> scale_data[0], 8);
+        img_out[i+1] = (q7_t)__SSAT( ((((int)image_data[i+1] - mean_data[1])<<7) + (0x1<<(scale_data[1]-1)))
+                             >> scale_data[1], 8);
+        img_out[i+2] = (q7_t)__SSAT( ((((int)image_data[i+2] - mean_data[2])<<7) + (0x1<<(scale_data[2]-1)))
+                             >> scale_data[2], 8);
+    }
+}
+
+#ifdef CNN_MIXED
+/*******************************************************************************
+* Function Name: CNN_PreprocessQ15
+********************************************************************************
+* Summary:
+*   Same as CNN_Preprocess, but to q15 with frac more fractional bits.
+*
+*******************************************************************************/
+static void CNN_PreprocessQ15(const uint8_t *image_data, q15_t *img_out, uint16_t frac)
+{
+    int mean_data[3] = INPUT_MEAN_SHIFT;
+    unsigned int scale_data[3] = INPUT_RIGHT_SHIFT;
+    
+    for (int i=0;i<32*32*3; i++) {
+        unsigned int shift = scale_data[i % 3] - frac;
+        
+        img_out[i] = (q15_t)__SSAT( ((((int)image_data[i] - mean_data[i % 3])<<7) + ((0x1<<shift)>>1))
+                             >> shift, 16);
+    }
+}
+
+/*******************************************************************************
+* Function Name: CNN_MixedHandOver
+********************************************************************************
+* Summary:
+*   Brings the size pooled activations at act to the precision of the next
+*   layer. is_q15 tells how they were computed, out_q15 how the tensor is
+*   stored and next_q15 whether the next layer runs the q15 kernels. Both
+*   conversions are done in place, act has room for size q15 values.
+*
+*******************************************************************************/
+static void CNN_MixedHandOver(q7_t *act, uint32_t size, bool is_q15, bool out_q15, bool next_q15)
+{
+    if (is_q15 && !out_q15)
+    {
+        /* the q7 writes stay behind the q15 reads */
+        arm_q15_to_q7_shift((q15_t *) act, act, 0, size);
+    }
+    if (!out_q15 && next_q15)
+    {
+        /* from the upper half, the q15 writes stay behind the q7 reads */
+        memmove(act + size, act, size);
+        arm_q7_to_q15_shift(act + size, (q15_t *) act, 0, size);
+    }
+}
+#endif /* CNN_MIXED */
+
+#ifdef CNN_EARLY_EXIT
+/*******************************************************************************
+* Function Name: CNN_MaxConfidence
+********************************************************************************
+* Summary:
+*   Returns the largest softmax output, i.e. the confidence of the winning
+*   class. Softmax outputs are never negative.
+*
+*******************************************************************************/
+static uint8_t CNN_MaxConfidence(const q7_t *prob, uint16_t dim)
+{
+    q7_t max = 0;
+    
+    for (uint16_t i = 0; i < dim; i++)
+    {
+        if (prob[i] > max)
+        {
+            max = prob[i];
+        }
+    }
+    return (uint8_t) max;
+}
+#endif /* CNN_EARLY_EXIT */
+
+#ifdef CNN_ZERO_STATS
+/*******************************************************************************
+* Function Name: CNN_CountZeros
+********************************************************************************
+* Summary:
+*   Adds the all-zero groups of four channels in the input of a layer, the 
+*   part of the MACs the zero-skipping kernels leave out, to the counts of
+*   that layer. Nothing is printed on the inference path.
+*
+*******************************************************************************/
+static uint32_t zeroGroups[CNN_ZERO_LAYERS];
+static uint32_t channelGroups[CNN_ZERO_LAYERS];
+
+static void CNN_CountZeros(uint16_t layer, const q7_t *act, uint32_t size)
+{
+    zeroGroups[layer] += arm_nn_zero_groups_q7(act, size);
+    channelGroups[layer] += size / 4u;
+}
+
+/*******************************************************************************
+* Function Name: CNN_GetZeroGroups
+********************************************************************************
+* Summary:
+*   Copies the all-zero channel groups and the groups counted so far, for 
+*   the input of conv2, conv3 and ip1. conv2 is not counted with CNN_BITMAP.
+*
+*******************************************************************************/
+void CNN_GetZeroGroups(uint32_t *zeros, uint32_t *groups)
+{
+    for (uint16_t i = 0; i < CNN_ZERO_LAYERS; i++)
+    {
+        zeros[i] = zeroGroups[i];
+        groups[i] = channelGroups[i];
+    }
+}
+#endif /* CNN_ZERO_STATS */
+
+#ifdef CNN_BITMAP
+/*******************************************************************************
+* Function Name: CNN_PoolToBitmap
+********************************************************************************
+* Summary:
+*   Max-pools img_in into a bitmap tensor laid over buffer. When the
+*   non-zero values do not fit, the tensor is pooled densely into buffer
+*   instead and false is returned.
+*
+*******************************************************************************/
+static bool CNN_PoolToBitmap(q7_t *img_in, uint16_t dim_in, uint16_t ch, uint16_t dim_kernel, uint16_t padding,
+                             uint16_t stride, uint16_t dim_out, q7_t *buffer, uint32_t size, arm_nn_bitmap_q7 *bmp)
+{
+    if (arm_nn_bitmap_init_q7(bmp, dim_out, ch, buffer, size) == ARM_MATH_SUCCESS &&
+        arm_maxpool_q7_HWC_to_bitmap(img_in, dim_in, ch, dim_kernel, padding, stride, dim_out,
+                                     col_buffer, bmp) == ARM_MATH_SUCCESS)
+    {
+        CNN_PRINTF("Bitmap activations: %lu of %lu bytes\r\n", (unsigned long) arm_nn_bitmap_size_q7(bmp),
+                (unsigned long) dim_out * dim_out * ch);
+        return true;
+    }
+    
+    CNN_PUTS("Bitmap activations do not fit, pooling densely\r\n");
+    arm_maxpool_q7_HWC(img_in, dim_in, ch, dim_kernel, padding, stride, dim_out, NULL, buffer);
+    return false;
+}
+#endif /* CNN_BITMAP */
+
+#ifdef CNN_WEIGHT_STREAM
+/*******************************************************************************
+* Function Name: CNN_ConvStreamed
+********************************************************************************
+* Summary:
+*   Runs a fast convolution + ReLU with its weights streamed from offset of
+*   the store, CNN_WS_BLOCK_FILTERS output channels at a time. The first 
+*   block must already be prefetched. Once the last block is acquired, 
+*   next_size bytes at next_offset are prefetched for the next layer.
+*
+*******************************************************************************/
+static void CNN_ConvStreamed(uint32_t offset, const q7_t *img_in, uint16_t dim_in, uint16_t ch_in, 
+                             uint16_t ch_out, uint16_t dim_kernel, uint16_t padding, uint16_t stride,
+                             const q7_t *bias, uint16_t bias_shift, uint16_t out_shift, q7_t *img_out, 
+                             uint16_t dim_out, uint32_t next_offset, uint32_t next_size)
+{
+    uint32_t block = CNN_WS_BLOCK_FILTERS * ch_in * dim_kernel * dim_kernel;
+    
+    for (uint16_t f = 0; f < ch_out; f += CNN_WS_BLOCK_FILTERS)
+    {
+        const q7_t *wt = (const q7_t *) WS_Acquire(&weightStream);
+        
+        if (f + CNN_WS_BLOCK_FILTERS < ch_out)
+        {
+            WS_Prefetch(&weightStream, offset + (f + CNN_WS_BLOCK_FILTERS) * ch_in * dim_kernel * dim_kernel,
+                        block);
+        }
+        else if (next_size)
+        {
+            WS_Prefetch(&weightStream, next_offset, next_size);
+        }
+        
+        /* the filters of the block are a channel slice of the output */
+        arm_convolve_HWC_q7_fast_ex(img_in, dim_in, ch_in, ch_in, wt, CNN_WS_BLOCK_FILTERS, dim_kernel, padding, 
+                                    stride, bias + f, bias_shift, out_shift, img_out + f, dim_out, ch_out,
+                                    (q15_t *) col_buffer, NULL);
+    }
+    arm_relu_q7(img_out, dim_out * dim_out * ch_out);
+}
+
+/*******************************************************************************
+* Function Name: CNN_ReportStream
+********************************************************************************
+* Summary:
+*   Reports how many weight blocks were streamed by the run and how many 
+*   were not read yet when they were needed.
+*
+*******************************************************************************/
+static void CNN_ReportStream(void)
+{
+    CNN_PRINTF("Weight stream: %lu blocks, %lu bytes, %lu stalls, %lu us stalled\r\n",
+            (unsigned long) weightStream.stats.blocks, (unsigned long) weightStream.stats.bytes,
+            (unsigned long) weightStream.stats.stalls, (unsigned long) weightStream.stats.stallUs);
+}
+
+/*******************************************************************************
+* Function Name: CNN_SetWeightStore
+********************************************************************************
+* Summary:
+*   Streams the conv2 and conv3 weights of the next runs from another store,
+*   laid out as described by CNN_WS_CONV2_OFFSET and CNN_WS_CONV3_OFFSET.
+*
+*******************************************************************************/
+void CNN_SetWeightStore(const ws_backend_t *backend, void *store)
+{
+    WS_Flush(&weightStream);
+    wsBackend = backend;
+    wsStore = store;
+}
+
+/*******************************************************************************
+* Function Name: CNN_SetCopyEngine
+********************************************************************************
+* Summary:
+*   Reads the weight blocks through a copy engine, so the reads run in the
+*   background instead of on the CPU. store is a memory-mapped store laid 
+*   out as CNN_SetWeightStore expects, NULL selects the default one.
+*
+*******************************************************************************/
+void CNN_SetCopyEngine(ce_engine_t *engine, const void *store)
+{
+    wsCopyStore.engine = engine;
+    wsCopyStore.base = (store != NULL) ? (const uint8_t *) store : (const uint8_t *) &cnnWeightStore;
+    CNN_SetWeightStore(&WS_CopyBackend, &wsCopyStore);
+}
+#endif /* CNN_WEIGHT_STREAM */
+
+/*******************************************************************************
+* Function Name: CNN_GetScores
+********************************************************************************
+* Summary:
+*   Writes the softmax of the last classification to output_data, ten q7
+*   scores. The softmax is only computed here, a run itself stops at the
+*   top classes.
+*
+*******************************************************************************/
+void CNN_GetScores(q7_t *output_data)
+{
+    arm_softmax_q31_q7(lastScores, IP1_OUT, lastScoresShift, output_data);
+}
+
+/*******************************************************************************
+* Function Name: CNN_SetExitThreshold
+********************************************************************************
+* Summary:
+*   Sets the softmax confidence (q7, 0..128) the early-exit head must reach
+*   for conv3/pool3/ip1 to be skipped. 128 disables the early exit.
+*
+*******************************************************************************/
+void CNN_SetExitThreshold(uint8_t threshold)
+{
+    exitThreshold = threshold;
+#ifdef CNN_INCREMENTAL
+    lastValid = false;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: CNN_SetVariant
+********************************************************************************
+* Summary:
+*   Selects the variant of the network run by the next inferences. The 
+*   variants that use the early exit are ignored without the early-exit 
+*   head, CNN_VARIANT_LEVELS lists the ones built.
+*
+*******************************************************************************/
+void CNN_SetVariant(cnn_variant_t newVariant)
+{
+#ifdef CNN_EARLY_EXIT
+    static const uint8_t thresholds[CNN_VARIANT_IDS] = { EXIT1_THRESHOLD, CNN_FAST_THRESHOLD, 0, 128 };
+    
+    if ((uint32_t) newVariant >= CNN_VARIANT_IDS)
+    {
+        return;
+    }
+    CNN_SetExitThreshold(thresholds[newVariant]);
+#else
+    if (newVariant != CNN_VARIANT_FULL && newVariant != CNN_VARIANT_STRIDED)
+    {
+        return;
+    }
+#endif
+    variant = newVariant;
+#ifdef CNN_INCREMENTAL
+    lastValid = false;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: CNN_Run
+********************************************************************************
+* Summary:
+*   Runs the CIFAR-10 network on a 32x32 RGB image in [RGB, RGB ... RGB]
+*   format and writes the best classes to result.
+*
+* Return:
+*   Point of the network where the classification was taken.
+*
+*******************************************************************************/
+cnn_exit_t CNN_Run(const uint8_t *image_data, cnn_result_t *result)
+{
+    /* start the execution */
+    q7_t     *img_buffer1 = scratch_buffer;
+    q7_t     *img_buffer2 = img_buffer1 + 32 * 32 * 32;   
+    /* CNN_VARIANT_STRIDED runs conv2 straight to the size of pool2 */
+    bool      strided = (variant == CNN_VARIANT_STRIDED);
+    uint16_t  conv2Stride = strided ? CONV2_STRIDED_STRIDE : CONV2_STRIDE;
+    uint16_t  conv2Dim = strided ? POOL2_OUT_DIM : CONV2_OUT_DIM;
+#ifdef CNN_BITMAP
+    arm_nn_bitmap_q7 pool1Bmp;
+    bool      pool1Bitmap;
+#endif
+
+#ifdef CNN_WEIGHT_STREAM
+    /* the first conv2 block is read during the pre-processing and conv1, a
+       conv3 block left over by an early exit is dropped */
+    WS_Flush(&weightStream);
+    WS_Init(&weightStream, wsBackend, wsStore, wsBuffer[0], wsBuffer[1], sizeof(wsBuffer[0]));
+    WS_Prefetch(&weightStream, CNN_WS_CONV2_OFFSET, CNN_WS_BLOCK_FILTERS * CONV2_IM_CH * CONV2_KER_DIM * CONV2_KER_DIM);
+#endif
+
+    CNN_PUTS("Input Pre-processing\r\n");
+    /* input pre-processing */
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    CNN_Preprocess(image_data, img_buffer2);
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Input Pre-processing completed\r\n\n\n");
+    
+    //*************************************************************************
+
+    CNN_PUTS("Performing first convolution RGB\r\n");
+    CNN_PUTS("arm_convolve_HWC_q7_RGB()\r\n");
+    // conv1 img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_RGB(img_buffer2, CONV1_IM_DIM, CONV1_IM_CH, conv1_wt, CONV1_OUT_CH, CONV1_KER_DIM, CONV1_PADDING,
+                            CONV1_STRIDE, conv1_bias, CONV1_BIAS_LSHIFT, CONV1_OUT_RSHIFT, img_buffer1, CONV1_OUT_DIM,
+                            (q15_t *) col_buffer, NULL); 
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Convolution RGB completed\r\n\n\n");
+    
+    //*************************************************************************
+
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    CNN_PUTS("Performing first arm_relu_q7\r\n");
+    arm_relu_q7(img_buffer1, CONV1_OUT_DIM * CONV1_OUT_DIM * CONV1_OUT_CH);
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("First arm_relu_q7 completed\r\n\n\n");
+    
+    //*************************************************************************
+    
+    CNN_PUTS("Performing first arm_maxpool_q7_HWC\r\n");
+    // pool1 img_buffer1 -> img_buffer2
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+#ifdef CNN_BITMAP
+    pool1Bitmap = CNN_PoolToBitmap(img_buffer1, CONV1_OUT_DIM, CONV1_OUT_CH, POOL1_KER_DIM, POOL1_PADDING,
+                                   POOL1_STRIDE, POOL1_OUT_DIM, img_buffer2, sizeof(scratch_buffer) - 32 * 32 * 32,
+                                   &pool1Bmp);
+#else
+    arm_maxpool_q7_HWC(img_buffer1, CONV1_OUT_DIM, CONV1_OUT_CH, POOL1_KER_DIM,
+                       POOL1_PADDING, POOL1_STRIDE, POOL1_OUT_DIM, NULL, img_buffer2);
+#endif
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("First arm_maxpool_q7_HWC completed\r\n\n\n");
+    
+    //*************************************************************************
+    
+#if defined(CNN_ZERO_STATS) && !defined(CNN_BITMAP)
+    CNN_CountZeros(0, img_buffer2, CONV2_IM_DIM * CONV2_IM_DIM * CONV2_IM_CH);
+#endif
+    CNN_PUTS("Performing second convolution\r\n");
+#if defined(CNN_INT4)
+    CNN_PUTS("arm_convolve_HWC_q7_int4()\r\n");
+    // conv2 img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_int4(img_buffer2, CONV2_IM_DIM, CONV2_IM_CH, conv2_i4_wt, conv2_i4_shift, CONV2_OUT_CH,
+                             CONV2_KER_DIM, CONV2_PADDING, conv2Stride, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT,
+                             img_buffer1, conv2Dim, (q15_t *) col_buffer, NULL);
+#elif defined(CNN_SPARSE)
+    CNN_PUTS("arm_convolve_HWC_q7_sparse()\r\n");
+    // conv2 img_buffer2 -> img_buffer1  
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_sparse(img_buffer2, CONV2_IM_DIM, CONV2_IM_CH, conv2_sp_wt, conv2_sp_idx, conv2_sp_ptr,
+                               CONV2_OUT_CH, CONV2_KER_DIM, CONV2_PADDING, conv2Stride, conv2_bias,
+                               CONV2_SP_BIAS_LSHIFT, CONV2_SP_OUT_RSHIFT, img_buffer1, conv2Dim,
+                               (q15_t *) col_buffer, NULL);
+#elif defined(CNN_BITMAP)
+    // conv2 + relu pool1Bmp -> img_buffer1, the input row window after the output
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    if (pool1Bitmap)
+    {
+        CNN_PUTS("arm_convolve_HWC_q7_fast_bitmap()\r\n");
+        arm_convolve_HWC_q7_fast_bitmap(&pool1Bmp, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM, CONV2_PADDING, conv2Stride,
+                                        conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT, &reluAct, img_buffer1,
+                                        conv2Dim, (q15_t *) col_buffer,
+                                        img_buffer1 + CONV2_OUT_DIM * CONV2_OUT_DIM * CONV2_OUT_CH);
+    }
+    else
+    {
+        CNN_PUTS("arm_convolve_HWC_q7_fast_act()\r\n");
+        arm_convolve_HWC_q7_fast_act(img_buffer2, CONV2_IM_DIM, CONV2_IM_CH, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM,
+                                     CONV2_PADDING, conv2Stride, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT,
+                                     &reluAct, img_buffer1, conv2Dim, (q15_t *) col_buffer, NULL);
+    }
+#elif defined(CNN_WEIGHT_STREAM)
+    CNN_PUTS("arm_convolve_HWC_q7_fast_ex() streamed\r\n");
+    // conv2 + relu img_buffer2 -> img_buffer1, the first conv3 block is read during pool2
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    CNN_ConvStreamed(CNN_WS_CONV2_OFFSET, img_buffer2, CONV2_IM_DIM, CONV2_IM_CH, CONV2_OUT_CH, CONV2_KER_DIM,
+                     CONV2_PADDING, conv2Stride, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT, img_buffer1,
+                     conv2Dim, CNN_WS_CONV3_OFFSET,
+                     CNN_WS_BLOCK_FILTERS * CONV3_IM_CH * CONV3_KER_DIM * CONV3_KER_DIM);
+#elif defined(CNN_ZERO_SKIP)
+    CNN_PUTS("arm_convolve_HWC_q7_fast_zero_skip()\r\n");
+    // conv2 + relu img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_fast_zero_skip(img_buffer2, CONV2_IM_DIM, CONV2_IM_CH, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM,
+                                       CONV2_PADDING, conv2Stride, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT,
+                                       &reluAct, img_buffer1, conv2Dim, (q15_t *) col_buffer, NULL);
+#else
+    CNN_PUTS("arm_convolve_HWC_q7_fast_act()\r\n");
+    // conv2 + relu img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_fast_act(img_buffer2, CONV2_IM_DIM, CONV2_IM_CH, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM,
+                                 CONV2_PADDING, conv2Stride, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT, &reluAct,
+                                 img_buffer1, conv2Dim, (q15_t *) col_buffer, NULL);
+#endif
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Second convolution completed\r\n\n\n");
+
+#if defined(CNN_INT4) || defined(CNN_SPARSE)
+    //*************************************************************************
+    
+    CNN_PUTS("Performing second arm_relu_q7\r\n");
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_relu_q7(img_buffer1, conv2Dim * conv2Dim * CONV2_OUT_CH);
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Second arm_relu_q7 completed\r\n\n\n");
+#endif
+
+    //*************************************************************************
+    
+    CNN_PUTS("Performing second arm_maxpool_q7_HWC\r\n");
+    // pool2 img_buffer1 -> img_buffer2
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    if (strided)
+    {
+        memcpy(img_buffer2, img_buffer1, POOL2_OUT_DIM * POOL2_OUT_DIM * CONV2_OUT_CH);
+    }
+    else
+    {
+        arm_maxpool_q7_HWC(img_buffer1, CONV2_OUT_DIM, CONV2_OUT_CH, POOL2_KER_DIM,
+                           POOL2_PADDING, POOL2_STRIDE, POOL2_OUT_DIM, col_buffer, img_buffer2);
+    }
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Second arm_maxpool_q7_HWC completed\r\n\n\n");
+    
+#ifdef CNN_EARLY_EXIT
+    //*************************************************************************
+    
+    /* the head was trained on pool2, CNN_VARIANT_STRIDED never takes the exit */
+    if (!strided)
+    {
+        CNN_PUTS("Performing early-exit head\r\n");
+        // exit1 img_buffer2 -> lastScores, img_buffer1 is free at this point
+        SysTickCnt = 0;
+        cnt_init = Cy_SysTick_GetValue();
+        arm_fully_connected_q7_opt_q31(img_buffer2, exit1_wt, EXIT1_DIM, EXIT1_OUT, EXIT1_BIAS_LSHIFT, exit1_bias,
+                                       lastScores, (q15_t *) img_buffer1);
+        lastScoresShift = EXIT1_OUT_RSHIFT;
+        /* the exit threshold is a softmax confidence */
+        arm_softmax_q31_q7(lastScores, EXIT1_OUT, EXIT1_OUT_RSHIFT, exitProb);
+        cnt_fin = Cy_SysTick_GetValue();
+        scale = SysTickCnt;
+        calculateDelay(cnt_init, cnt_fin, scale);
+    
+        /* Skip conv3/pool3/ip1 when the head is already confident enough */
+        if (CNN_MaxConfidence(exitProb, EXIT1_OUT) >= exitThreshold)
+        {
+            CNN_PUTS("Early-exit head is confident, skipping conv3\r\n\n\n");
+            arm_nn_topk_q31(lastScores, EXIT1_OUT, CNN_TOPK, result->cls, result->margin);
+            return CNN_EXIT_POOL2;
+        }
+        CNN_PUTS("Early-exit head not confident, continuing\r\n\n\n");
+    }
+#endif /* CNN_EARLY_EXIT */
+    
+    //*************************************************************************
+
+#ifdef CNN_ZERO_STATS
+    CNN_CountZeros(1, img_buffer2, CONV3_IM_DIM * CONV3_IM_DIM * CONV3_IM_CH);
+#endif
+    CNN_PUTS("Performing third convolution\r\n");
+#if defined(CNN_INT4)
+    CNN_PRINTF("arm_convolve_HWC_q7_int4()\r\n");
+    // conv3 img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_int4(img_buffer2, CONV3_IM_DIM, CONV3_IM_CH, conv3_i4_wt, conv3_i4_shift, CONV3_OUT_CH,
+                             CONV3_KER_DIM, CONV3_PADDING, CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT, CONV3_OUT_RSHIFT,
+                             img_buffer1, CONV3_OUT_DIM, (q15_t *) col_buffer, NULL);
+#elif defined(CNN_SPARSE)
+    CNN_PRINTF("arm_convolve_HWC_q7_sparse()\r\n");
+    // conv3 img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_sparse(img_buffer2, CONV3_IM_DIM, CONV3_IM_CH, conv3_sp_wt, conv3_sp_idx, conv3_sp_ptr,
+                               CONV3_OUT_CH, CONV3_KER_DIM, CONV3_PADDING, CONV3_STRIDE, conv3_bias,
+                               CONV3_SP_BIAS_LSHIFT, CONV3_SP_OUT_RSHIFT, img_buffer1, CONV3_OUT_DIM,
+                               (q15_t *) col_buffer, NULL);
+#elif defined(CNN_WEIGHT_STREAM)
+    CNN_PRINTF("arm_convolve_HWC_q7_fast_ex() streamed\r\n");
+    // conv3 + relu img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    CNN_ConvStreamed(CNN_WS_CONV3_OFFSET, img_buffer2, CONV3_IM_DIM, CONV3_IM_CH, CONV3_OUT_CH, CONV3_KER_DIM,
+                     CONV3_PADDING, CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT, CONV3_OUT_RSHIFT, img_buffer1,
+                     CONV3_OUT_DIM, 0u, 0u);
+#elif defined(CNN_ZERO_SKIP)
+    CNN_PRINTF("arm_convolve_HWC_q7_fast_zero_skip()\r\n");
+    // conv3 + relu img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_fast_zero_skip(img_buffer2, CONV3_IM_DIM, CONV3_IM_CH, conv3_wt, CONV3_OUT_CH, CONV3_KER_DIM,
+                                       CONV3_PADDING, CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT, CONV3_OUT_RSHIFT,
+                                       &reluAct, img_buffer1, CONV3_OUT_DIM, (q15_t *) col_buffer, NULL);
+#else
+    CNN_PRINTF("arm_convolve_HWC_q7_fast_act()\r\n");
+    // conv3 + relu img_buffer2 -> img_buffer1
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_convolve_HWC_q7_fast_act(img_buffer2, CONV3_IM_DIM, CONV3_IM_CH, conv3_wt, CONV3_OUT_CH, CONV3_KER_DIM,
+                                 CONV3_PADDING, CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT, CONV3_OUT_RSHIFT, &reluAct,
+                                 img_buffer1, CONV3_OUT_DIM, (q15_t *) col_buffer, NULL);
+#endif
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Third convolution completed\r\n\n\n");
+
+#if defined(CNN_INT4) || defined(CNN_SPARSE)
+    //*************************************************************************
+    
+    CNN_PUTS("\nPerforming third arm_relu_q7\r\n");
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_relu_q7(img_buffer1, CONV3_OUT_DIM * CONV3_OUT_DIM * CONV3_OUT_CH);
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Third arm_relu_q7 completed\r\n\n\n");
+#endif
+
+    //*************************************************************************
+    
+    CNN_PUTS("Performing third arm_maxpool_q7_HWC\r\n");
+    // pool3 img_buffer-> img_buffer2
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_maxpool_q7_HWC(img_buffer1, CONV3_OUT_DIM, CONV3_OUT_CH, POOL3_KER_DIM,
+                       POOL3_PADDING, POOL3_STRIDE, POOL3_OUT_DIM, col_buffer, img_buffer2);
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("Third arm_maxpool_q7_HWC completed\r\n\n\n");
+    
+    //*************************************************************************
+    
+#ifdef CNN_ZERO_STATS
+    CNN_CountZeros(2, img_buffer2, IP1_DIM);
+#endif
+    CNN_PUTS("\nPerforming arm_fully_connected_q7_opt_q31\r\n");
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+#if defined(CNN_INT4)
+    arm_fully_connected_q7_int4_q31(img_buffer2, ip1_i4_wt, ip1_i4_shift, IP1_DIM, IP1_OUT, IP1_BIAS_LSHIFT,
+                                    ip1_bias, lastScores, (q15_t *) img_buffer1);
+    lastScoresShift = IP1_OUT_RSHIFT;
+#elif defined(CNN_SPARSE)
+    arm_fully_connected_q7_sparse_q31(img_buffer2, ip1_sp_wt, ip1_sp_idx, ip1_sp_ptr, IP1_DIM, IP1_OUT,
+                                      IP1_SP_BIAS_LSHIFT, ip1_bias, lastScores, (q15_t *) img_buffer1);
+    lastScoresShift = IP1_SP_OUT_RSHIFT;
+#else
+    arm_fully_connected_q7_opt_q31_zero_skip(img_buffer2, ip1_wt, IP1_DIM, IP1_OUT, IP1_BIAS_LSHIFT, ip1_bias,
+                                             IP1_MAX_NNZ, lastScores, (q15_t *) img_buffer1);
+    lastScoresShift = IP1_OUT_RSHIFT;
+#endif
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("arm_fully_connected_q7_opt_q31 completed\r\n\n\n");
+
+    //*************************************************************************
+    
+    CNN_PUTS("\nPerforming arm_nn_topk_q31\r\n");
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    arm_nn_topk_q31(lastScores, IP1_OUT, CNN_TOPK, result->cls, result->margin);
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    CNN_PUTS("arm_nn_topk_q31 completed\r\n\n\n");
+    
+#ifdef CNN_WEIGHT_STREAM
+    CNN_ReportStream();
+#endif
+    return CNN_EXIT_FULL;
+}
+
+#ifdef CNN_INCREMENTAL
+/*******************************************************************************
+* Function Name: CNN_RectUnion
+********************************************************************************
+* Summary:
+*   Grows acc so that it also covers rect. Empty rectangles are ignored.
+*
+*******************************************************************************/
+static void CNN_RectUnion(arm_nn_rect *acc, const arm_nn_rect *rect)
+{
+    if (rect->x0 >= rect->x1 || rect->y0 >= rect->y1)
+    {
+        return;
+    }
+    if (acc->x0 >= acc->x1 || acc->y0 >= acc->y1)
+    {
+        *acc = *rect;
+        return;
+    }
+    if (rect->x0 < acc->x0) acc->x0 = rect->x0;
+    if (rect->y0 < acc->y0) acc->y0 = rect->y0;
+    if (rect->x1 > acc->x1) acc->x1 = rect->x1;
+    if (rect->y1 > acc->y1) acc->y1 = rect->y1;
+}
+
+/*******************************************************************************
+* Function Name: CNN_RunIncremental
+********************************************************************************
+* Summary:
+*   Same result as CNN_Run, but the output of every layer is kept from one
+*   frame to the next. The bounding box of the input pixels that changed is
+*   propagated through the network and only the outputs inside it are
+*   recomputed. ip1 and the top-k are dense and always run. If the input did
+*   not change at all, the previous result is returned. CNN_VARIANT_STRIDED
+*   does not match the cached layers and runs CNN_Run instead.
+*
+* Return:
+*   Point of the network where the classification was taken.
+*
+*******************************************************************************/
+cnn_exit_t CNN_RunIncremental(const uint8_t *image_data, cnn_result_t *result)
+{
+    q7_t       *img_buffer = scratch_buffer;
+    arm_nn_rect inRect, conv1Rect, pool1Rect, conv2Rect, pool2Rect, conv3Rect, pool3Rect;
+    
+    if (variant == CNN_VARIANT_STRIDED)
+    {
+        /* conv2 and the layers after it have other sizes, nothing in the
+           cache applies, the next frame of another variant starts over */
+        cacheValid = false;
+        lastValid = false;
+        return CNN_Run(image_data, result);
+    }
+    
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    
+    CNN_Preprocess(image_data, img_buffer);
+    
+    if (cacheValid)
+    {
+        /* compare against the previous frame, the cache is updated in place */
+        arm_nn_diff_rect_q7(img_buffer, inCache, CONV1_IM_DIM, CONV1_IM_CH, &inRect);
+    }
+    else
+    {
+        memcpy(inCache, img_buffer, sizeof(inCache));
+        inRect.x0 = inRect.y0 = 0;
+        inRect.x1 = inRect.y1 = CONV1_IM_DIM;
+        pool2Pending.x0 = pool2Pending.y0 = pool2Pending.x1 = pool2Pending.y1 = 0;
+        cacheValid = true;
+    }
+    
+    if (inRect.x0 >= inRect.x1 && lastValid)
+    {
+        CNN_PUTS("Input unchanged, reusing previous result\r\n");
+        *result = lastResult;
+        return lastExit;
+    }
+    if (inRect.x0 < inRect.x1)
+    {
+        CNN_PRINTF("Changed region: x %d..%d, y %d..%d\r\n", inRect.x0, inRect.x1 - 1, inRect.y0, inRect.y1 - 1);
+    }
+    /* otherwise the regions below are empty and only the dense layers run again */
+    
+    // conv1 + relu inCache -> conv1Cache
+    arm_nn_rect_propagate(&inRect, CONV1_KER_DIM, CONV1_PADDING, CONV1_STRIDE, CONV1_OUT_DIM, &conv1Rect);
+    arm_convolve_HWC_q7_region(inCache, CONV1_IM_DIM, CONV1_IM_CH, conv1_wt, CONV1_OUT_CH, CONV1_KER_DIM, CONV1_PADDING,
+                               CONV1_STRIDE, conv1_bias, CONV1_BIAS_LSHIFT, CONV1_OUT_RSHIFT, conv1Cache, CONV1_OUT_DIM,
+                               &conv1Rect, (q15_t *) col_buffer, NULL);
+    arm_relu_q7_region(conv1Cache, CONV1_OUT_DIM, CONV1_OUT_CH, &conv1Rect);
+    
+    // pool1 conv1Cache -> pool1Cache
+    arm_nn_rect_propagate(&conv1Rect, POOL1_KER_DIM, POOL1_PADDING, POOL1_STRIDE, POOL1_OUT_DIM, &pool1Rect);
+    arm_maxpool_q7_HWC_region(conv1Cache, CONV1_OUT_DIM, CONV1_OUT_CH, POOL1_KER_DIM, POOL1_PADDING, POOL1_STRIDE,
+                              POOL1_OUT_DIM, &pool1Rect, pool1Cache);
+    
+    // conv2 + relu pool1Cache -> conv2Cache
+    arm_nn_rect_propagate(&pool1Rect, CONV2_KER_DIM, CONV2_PADDING, CONV2_STRIDE, CONV2_OUT_DIM, &conv2Rect);
+    arm_convolve_HWC_q7_region(pool1Cache, CONV2_IM_DIM, CONV2_IM_CH, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM, CONV2_PADDING,
+                               CONV2_STRIDE, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT, conv2Cache, CONV2_OUT_DIM,
+                               &conv2Rect, (q15_t *) col_buffer, NULL);
+    arm_relu_q7_region(conv2Cache, CONV2_OUT_DIM, CONV2_OUT_CH, &conv2Rect);
+    
+    // pool2 conv2Cache -> pool2Cache
+    arm_nn_rect_propagate(&conv2Rect, POOL2_KER_DIM, POOL2_PADDING, POOL2_STRIDE, POOL2_OUT_DIM, &pool2Rect);
+    arm_maxpool_q7_HWC_region(conv2Cache, CONV2_OUT_DIM, CONV2_OUT_CH, POOL2_KER_DIM, POOL2_PADDING, POOL2_STRIDE,
+                              POOL2_OUT_DIM, &pool2Rect, pool2Cache);
+    CNN_RectUnion(&pool2Pending, &pool2Rect);
+    
+#ifdef CNN_EARLY_EXIT
+    // exit1 pool2Cache -> lastScores
+    arm_fully_connected_q7_opt_q31(pool2Cache, exit1_wt, EXIT1_DIM, EXIT1_OUT, EXIT1_BIAS_LSHIFT, exit1_bias,
+                                   lastScores, (q15_t *) img_buffer);
+    lastScoresShift = EXIT1_OUT_RSHIFT;
+    arm_softmax_q31_q7(lastScores, EXIT1_OUT, EXIT1_OUT_RSHIFT, exitProb);
+    
+    if (CNN_MaxConfidence(exitProb, EXIT1_OUT) >= exitThreshold)
+    {
+        /* conv3 is left behind, pool2Pending remembers what it still has to catch up on */
+        arm_nn_topk_q31(lastScores, EXIT1_OUT, CNN_TOPK, result->cls, result->margin);
+        cnt_fin = Cy_SysTick_GetValue();
+        scale = SysTickCnt;
+        calculateDelay(cnt_init, cnt_fin, scale);
+        lastResult = *result;
+        lastExit = CNN_EXIT_POOL2;
+        lastValid = true;
+        return CNN_EXIT_POOL2;
+    }
+#endif /* CNN_EARLY_EXIT */
+    
+    // conv3 + relu pool2Cache -> conv3Cache
+    arm_nn_rect_propagate(&pool2Pending, CONV3_KER_DIM, CONV3_PADDING, CONV3_STRIDE, CONV3_OUT_DIM, &conv3Rect);
+    arm_convolve_HWC_q7_region(pool2Cache, CONV3_IM_DIM, CONV3_IM_CH, conv3_wt, CONV3_OUT_CH, CONV3_KER_DIM, CONV3_PADDING,
+                               CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT, CONV3_OUT_RSHIFT, conv3Cache, CONV3_OUT_DIM,
+                               &conv3Rect, (q15_t *) col_buffer, NULL);
+    arm_relu_q7_region(conv3Cache, CONV3_OUT_DIM, CONV3_OUT_CH, &conv3Rect);
+    pool2Pending.x0 = pool2Pending.y0 = pool2Pending.x1 = pool2Pending.y1 = 0;
+    
+    // pool3 conv3Cache -> pool3Cache
+    arm_nn_rect_propagate(&conv3Rect, POOL3_KER_DIM, POOL3_PADDING, POOL3_STRIDE, POOL3_OUT_DIM, &pool3Rect);
+    arm_maxpool_q7_HWC_region(conv3Cache, CONV3_OUT_DIM, CONV3_OUT_CH, POOL3_KER_DIM, POOL3_PADDING, POOL3_STRIDE,
+                              POOL3_OUT_DIM, &pool3Rect, pool3Cache);
+    
+    // ip1 + top-k pool3Cache -> result
+#if defined(CNN_INT4)
+    arm_fully_connected_q7_int4_q31(pool3Cache, ip1_i4_wt, ip1_i4_shift, IP1_DIM, IP1_OUT, IP1_BIAS_LSHIFT,
+                                    ip1_bias, lastScores, (q15_t *) img_buffer);
+    lastScoresShift = IP1_OUT_RSHIFT;
+#elif defined(CNN_SPARSE)
+    arm_fully_connected_q7_sparse_q31(pool3Cache, ip1_sp_wt, ip1_sp_idx, ip1_sp_ptr, IP1_DIM, IP1_OUT,
+                                      IP1_SP_BIAS_LSHIFT, ip1_bias, lastScores, (q15_t *) img_buffer);
+    lastScoresShift = IP1_SP_OUT_RSHIFT;
+#else
+    arm_fully_connected_q7_opt_q31_zero_skip(pool3Cache, ip1_wt, IP1_DIM, IP1_OUT, IP1_BIAS_LSHIFT, ip1_bias,
+                                             IP1_MAX_NNZ, lastScores, (q15_t *) img_buffer);
+    lastScoresShift = IP1_OUT_RSHIFT;
+#endif
+    arm_nn_topk_q31(lastScores, IP1_OUT, CNN_TOPK, result->cls, result->margin);
+    
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    
+    lastResult = *result;
+    lastExit = CNN_EXIT_FULL;
+    lastValid = true;
+    return CNN_EXIT_FULL;
+}
+#endif /* CNN_INCREMENTAL */
+
+#ifdef CNN_MIXED
+/* A layer runs the q15 kernels when its input or its output is q15 */
+#define CONV1_MIXED     (INPUT_Q15 || CONV1_Q15)
+#define CONV2_MIXED     (CONV1_Q15 || CONV2_Q15)
+#define CONV3_MIXED     (CONV2_Q15 || CONV3_Q15)
+
+/*******************************************************************************
+* Function Name: CNN_RunMixed
+********************************************************************************
+* Summary:
+*   Same network as CNN_Run, with every tensor in the precision set by
+*   arm_nnexamples_cifar10_precision.h. A q15 tensor holds the q7 value
+*   with <T>_FRAC more fractional bits, the shifts of the next layer are
+*   adjusted by the same amount. There is no early exit, of the variants
+*   only CNN_VARIANT_STRIDED changes the network.
+*
+* Return:
+*   Point of the network where the classification was taken.
+*
+*******************************************************************************/
+cnn_exit_t CNN_RunMixed(const uint8_t *image_data, cnn_result_t *result)
+{
+    q7_t     *conv = scratch_buffer;
+    q7_t     *act = scratch_buffer + 32 * 32 * 32 * 2;
+    /* CNN_VARIANT_STRIDED runs conv2 straight to the size of pool2 */
+    bool      strided = (variant == CNN_VARIANT_STRIDED);
+    uint16_t  conv2Stride = strided ? CONV2_STRIDED_STRIDE : CONV2_STRIDE;
+    uint16_t  conv2Dim = strided ? POOL2_OUT_DIM : CONV2_OUT_DIM;
+    
+    SysTickCnt = 0;
+    cnt_init = Cy_SysTick_GetValue();
+    
+    // input -> act
+#if INPUT_Q15
+    CNN_PreprocessQ15(image_data, (q15_t *) act, INPUT_FRAC);
+#else
+    CNN_Preprocess(image_data, act);
+    CNN_MixedHandOver(act, CONV1_IM_DIM * CONV1_IM_DIM * CONV1_IM_CH, false, false, CONV1_MIXED);
+#endif
+    
+    // conv1 + relu act -> conv, pool1 conv -> act
+#if CONV1_MIXED
+    arm_convolve_HWC_mat_q7_im_q15((q15_t *) act, CONV1_IM_DIM, CONV1_IM_CH, conv1_wt, CONV1_OUT_CH, CONV1_KER_DIM,
+                                   CONV1_PADDING, CONV1_STRIDE, conv1_bias, CONV1_BIAS_LSHIFT + INPUT_FRAC,
+                                   CONV1_OUT_RSHIFT + INPUT_FRAC - CONV1_FRAC, (q15_t *) conv, CONV1_OUT_DIM,
+                                   (q15_t *) col_buffer, NULL);
+    arm_relu_q15((q15_t *) conv, CONV1_OUT_DIM * CONV1_OUT_DIM * CONV1_OUT_CH);
+    arm_maxpool_q15_HWC((q15_t *) conv, CONV1_OUT_DIM, CONV1_OUT_CH, POOL1_KER_DIM, POOL1_PADDING, POOL1_STRIDE,
+                        POOL1_OUT_DIM, NULL, (q15_t *) act);
+#else
+    arm_convolve_HWC_q7_RGB(act, CONV1_IM_DIM, CONV1_IM_CH, conv1_wt, CONV1_OUT_CH, CONV1_KER_DIM, CONV1_PADDING,
+                            CONV1_STRIDE, conv1_bias, CONV1_BIAS_LSHIFT, CONV1_OUT_RSHIFT, conv, CONV1_OUT_DIM,
+                            (q15_t *) col_buffer, NULL);
+    arm_relu_q7(conv, CONV1_OUT_DIM * CONV1_OUT_DIM * CONV1_OUT_CH);
+    arm_maxpool_q7_HWC(conv, CONV1_OUT_DIM, CONV1_OUT_CH, POOL1_KER_DIM, POOL1_PADDING, POOL1_STRIDE,
+                       POOL1_OUT_DIM, NULL, act);
+#endif
+    CNN_MixedHandOver(act, POOL1_OUT_DIM * POOL1_OUT_DIM * CONV1_OUT_CH, CONV1_MIXED, CONV1_Q15, CONV2_MIXED);
+    
+    // conv2 + relu act -> conv, pool2 conv -> act
+#if CONV2_MIXED
+    arm_convolve_HWC_mat_q7_im_q15((q15_t *) act, CONV2_IM_DIM, CONV2_IM_CH, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM,
+                                   CONV2_PADDING, conv2Stride, conv2_bias, CONV2_BIAS_LSHIFT + CONV1_FRAC,
+                                   CONV2_OUT_RSHIFT + CONV1_FRAC - CONV2_FRAC, (q15_t *) conv, conv2Dim,
+                                   (q15_t *) col_buffer, NULL);
+    arm_relu_q15((q15_t *) conv, conv2Dim * conv2Dim * CONV2_OUT_CH);
+    if (strided)
+    {
+        memcpy(act, conv, POOL2_OUT_DIM * POOL2_OUT_DIM * CONV2_OUT_CH * sizeof(q15_t));
+    }
+    else
+    {
+        arm_maxpool_q15_HWC((q15_t *) conv, CONV2_OUT_DIM, CONV2_OUT_CH, POOL2_KER_DIM, POOL2_PADDING, POOL2_STRIDE,
+                            POOL2_OUT_DIM, NULL, (q15_t *) act);
+    }
+#else
+    arm_convolve_HWC_q7_fast(act, CONV2_IM_DIM, CONV2_IM_CH, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM, CONV2_PADDING,
+                             conv2Stride, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT, conv, conv2Dim,
+                             (q15_t *) col_buffer, NULL);
+    arm_relu_q7(conv, conv2Dim * conv2Dim * CONV2_OUT_CH);
+    if (strided)
+    {
+        memcpy(act, conv, POOL2_OUT_DIM * POOL2_OUT_DIM * CONV2_OUT_CH);
+    }
+    else
+    {
+        arm_maxpool_q7_HWC(conv, CONV2_OUT_DIM, CONV2_OUT_CH, POOL2_KER_DIM, POOL2_PADDING, POOL2_STRIDE,
+                           POOL2_OUT_DIM, NULL, act);
+    }
+#endif
+    CNN_MixedHandOver(act, POOL2_OUT_DIM * POOL2_OUT_DIM * CONV2_OUT_CH, CONV2_MIXED, CONV2_Q15, CONV3_MIXED);
+    
+    // conv3 + relu act -> conv, pool3 conv -> act
+#if CONV3_MIXED
+    arm_convolve_HWC_mat_q7_im_q15((q15_t *) act, CONV3_IM_DIM, CONV3_IM_CH, conv3_wt, CONV3_OUT_CH, CONV3_KER_DIM,
+                                   CONV3_PADDING, CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT + CONV2_FRAC,
+                                   CONV3_OUT_RSHIFT + CONV2_FRAC - CONV3_FRAC, (q15_t *) conv, CONV3_OUT_DIM,
+                                   (q15_t *) col_buffer, NULL);
+    arm_relu_q15((q15_t *) conv, CONV3_OUT_DIM * CONV3_OUT_DIM * CONV3_OUT_CH);
+    arm_maxpool_q15_HWC((q15_t *) conv, CONV3_OUT_DIM, CONV3_OUT_CH, POOL3_KER_DIM, POOL3_PADDING, POOL3_STRIDE,
+                        POOL3_OUT_DIM, NULL, (q15_t *) act);
+#else
+    arm_convolve_HWC_q7_fast(act, CONV3_IM_DIM, CONV3_IM_CH, conv3_wt, CONV3_OUT_CH, CONV3_KER_DIM, CONV3_PADDING,
+                             CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT, CONV3_OUT_RSHIFT, conv, CONV3_OUT_DIM,
+                             (q15_t *) col_buffer, NULL);
+    arm_relu_q7(conv, CONV3_OUT_DIM * CONV3_OUT_DIM * CONV3_OUT_CH);
+    arm_maxpool_q7_HWC(conv, CONV3_OUT_DIM, CONV3_OUT_CH, POOL3_KER_DIM, POOL3_PADDING, POOL3_STRIDE,
+                       POOL3_OUT_DIM, NULL, act);
+#endif
+    CNN_MixedHandOver(act, POOL3_OUT_DIM * POOL3_OUT_DIM * CONV3_OUT_CH, CONV3_MIXED, CONV3_Q15, CONV3_Q15);
+    
+    // ip1 + top-k act -> result
+#if CONV3_Q15
+    /* the accumulators carry the CONV3_FRAC extra bits of the input */
+    arm_fully_connected_mat_q7_vec_q15_opt_q31((q15_t *) act, ip1_vq15_wt, IP1_DIM, IP1_OUT,
+                                               IP1_BIAS_LSHIFT + CONV3_FRAC, ip1_bias, lastScores, NULL);
+    lastScoresShift = IP1_OUT_RSHIFT + CONV3_FRAC;
+#else
+    arm_fully_connected_q7_opt_q31(act, ip1_wt, IP1_DIM, IP1_OUT, IP1_BIAS_LSHIFT, ip1_bias,
+                                   lastScores, (q15_t *) conv);
+    lastScoresShift = IP1_OUT_RSHIFT;
+#endif
+    arm_nn_topk_q31(lastScores, IP1_OUT, CNN_TOPK, result->cls, result->margin);
+    
+    cnt_fin = Cy_SysTick_GetValue();
+    scale = SysTickCnt;
+    calculateDelay(cnt_init, cnt_fin, scale);
+    
+    return CNN_EXIT_FULL;
+}
+#endif /* CNN_MIXED */
+
+/*******************************************************************************
+* Function Name: calculateDelay
+*******************************************************************************/
+void calculateDelay(uint32_t cnt_init, uint32_t cnt_fin, uint32_t scale){
+    
+    t_initial = cnt_init * 125;    
+    
+    if(scale == 0)
+    {
+        t_final = cnt_fin * 125;
+        total_time_nano = t_initial - t_final; // units in nano sec
+        CNN_PRINTF("Total time in nano seconds = %u \r\n", total_time_nano);
+    }
+    else
+    {
+        t_final = (16777215 - cnt_fin) * 125;
+        sup_time_nano = t_initial + t_final; // need to add (2.097 sec * (scale - 1))
+        CNN_PRINTF("Total time in nano seconds: 2.097[sec] * %u + %u[nano seconds]\r\n",
+              (scale - 1u), sup_time_nano);
+    }      
+}
+/* [] END OF FILE */
\ No newline at end of file
@@ -0,0 +1,183 @@
+/******************************************************************************
+*   File Name: cnn_cifar10.h
+*
+* Description: Interface of the CIFAR-10 CNN executed by CM4. The network
+*              runs conv1/pool1, conv2/pool2 and then, if an early-exit head
+*              is available and confident enough, stops there. Otherwise it
+*              continues through conv3/pool3/ip1.
+*
+* Hardware Dependency: PSoC 6 BLE Pioneer kit CY8CKIT-062-BLE
+****************************************************************************/
+#ifndef CNN_CIFAR10_H
+#define CNN_CIFAR10_H
+
+    #include <stdint.h>
+    #include "arm_math.h"
+    #include "arm_nnexamples_cifar10_parameter.h"
+    #include "arm_nnexamples_cifar10_weights.h"
+
+    /* The early-exit head after pool2 is only built when the weights header
+       provides its parameters (EXIT1_WT, EXIT1_BIAS and the shifts).
+       CNN_EXIT_HEAD takes them from arm_nnexamples_cifar10_exit_weights.h,
+       trained on a calibration set by NN/Scripts/train_exit_head.py, which
+       also suggests EXIT1_THRESHOLD and checks it with --check. */
+    //#define CNN_EXIT_HEAD
+    #ifdef CNN_EXIT_HEAD
+        #include "arm_nnexamples_cifar10_exit_weights.h"
+    #endif
+    #if defined(EXIT1_WT)
+        #define CNN_EARLY_EXIT
+    #endif
+
+    /* Run conv2, conv3 and ip1 of CNN_Run (only ip1 of CNN_RunIncremental)
+       with the block-sparse weights of arm_nnexamples_cifar10_sparse_weights.h,
+       generated from the dense weights by NN/Scripts/prune_model.py. */
+    //#define CNN_SPARSE
+    #ifdef CNN_SPARSE
+        #include "arm_nnexamples_cifar10_sparse_weights.h"
+    #endif
+
+    /* Same layers with the 4-bit weights of arm_nnexamples_cifar10_int4_weights.h,
+       generated by NN/Scripts/pack_int4.py. Takes precedence over CNN_SPARSE. */
+    //#define CNN_INT4
+    #ifdef CNN_INT4
+        #include "arm_nnexamples_cifar10_int4_weights.h"
+    #endif
+
+    /* Run CNN_RunMixed with the per-layer precision of
+       arm_nnexamples_cifar10_precision.h, generated by
+       NN/Scripts/select_precision.py. Each tensor is kept in q7 or in q15
+       with extra fractional bits, the weights stay q7. */
+    //#define CNN_MIXED
+    #ifdef CNN_MIXED
+        #include "arm_nnexamples_cifar10_precision.h"
+    #endif
+
+    /* Run the dense conv2 and conv3 of CNN_Run with the kernel that skips
+       the all-zero groups of four input channels. It only pays off when
+       CNN_ZERO_STATS reports a large share of zero groups. */
+    //#define CNN_ZERO_SKIP
+
+    /* Keep the pool1 output of CNN_Run as a bitmap of its non-zero values,
+       read by conv2 a few rows at a time, and report its size. Needs the
+       dense conv2. It saves compute only, not SRAM: the bitmap is laid
+       over img_buffer2, which keeps its size for the dense fallback, and
+       the peak of scratch_buffer is the conv1 output next to it. */
+    //#define CNN_BITMAP
+    #if defined(CNN_BITMAP) && (defined(CNN_INT4) || defined(CNN_SPARSE))
+        #error "CNN_BITMAP needs the dense conv2"
+    #endif
+
+    /* Count the all-zero channel groups in the input of conv2, conv3 and
+       ip1 on every CNN_Run. CM4 returns the sums with IPC_REQ_QUERY_STATS. */
+    //#define CNN_ZERO_STATS
+    
+    /* Layers counted by CNN_ZERO_STATS: conv2, conv3, ip1 */
+    #define CNN_ZERO_LAYERS         3
+
+    /* Run CNN_RunIncremental, which keeps the layer outputs between frames
+       and only recomputes the part that depends on changed pixels (about
+       52 KB of extra SRAM). */
+    //#define CNN_INCREMENTAL
+
+    /* Stream the conv2 and conv3 weights of CNN_Run from a backing store,
+       see weight_stream.h, CNN_WS_BLOCK_FILTERS filters at a time. The
+       next block is read while the current one computes, the first conv2
+       block during conv1 and the first conv3 block during pool2.
+       CNN_RunIncremental and CNN_RunMixed read the built-in weights, so
+       CM4 only runs CNN_Run, and serves IPC_REQ_LOAD_MODEL, when neither
+       CNN_INCREMENTAL nor CNN_MIXED is enabled. */
+    //#define CNN_WEIGHT_STREAM
+    #ifdef CNN_WEIGHT_STREAM
+        #include "weight_stream.h"
+        #if defined(CNN_INT4) || defined(CNN_SPARSE) || defined(CNN_BITMAP) || defined(CNN_ZERO_SKIP)
+            #error "CNN_WEIGHT_STREAM needs the dense conv2 and conv3"
+        #endif
+        #if defined(CNN_INCREMENTAL) || defined(CNN_MIXED)
+            #error "CNN_WEIGHT_STREAM only streams the weights of CNN_Run"
+        #endif
+        
+        /* Filters per block, divides CONV2_OUT_CH and CONV3_OUT_CH */
+        #define CNN_WS_BLOCK_FILTERS    4
+        
+        /* Layout of the store: the conv2 then the conv3 filters, in the 
+           order of arm_nnexamples_cifar10_weights.h */
+        #define CNN_WS_CONV2_OFFSET     0u
+        #define CNN_WS_CONV3_OFFSET     (CONV2_IM_CH * CONV2_KER_DIM * CONV2_KER_DIM * CONV2_OUT_CH)
+        #define CNN_WS_STORE_SIZE       (CNN_WS_CONV3_OFFSET + CONV3_IM_CH * CONV3_KER_DIM * CONV3_KER_DIM * CONV3_OUT_CH)
+    #endif
+
+    /* Report each layer and its time over the UART. The console output is
+       on the inference path and takes longer than most layers, only enable
+       it for profiling. The results are printed by CM0+ either way. */
+    //#define CNN_TRACE
+
+    /* Point of the network where the classification was taken */
+    typedef enum
+    {
+        CNN_EXIT_POOL2  = 0,            /* Early-exit head after pool2      */
+        CNN_EXIT_FULL   = 1             /* Full network, ip1                */
+    } cnn_exit_t;
+
+    /* Variants of the network. CNN_VARIANT_STRIDED runs conv2 at twice its
+       stride, straight to the size of pool2, for a quarter of its MACs
+       (4.1M instead of 6.6M for the network), and is built in every
+       configuration. The ones that take the early exit at a lower
+       confidence, down to always, need the early-exit head. */
+    typedef enum
+    {
+        CNN_VARIANT_FULL    = 0,        /* Exit at EXIT1_THRESHOLD          */
+        CNN_VARIANT_FAST    = 1,        /* Exit at CNN_FAST_THRESHOLD       */
+        CNN_VARIANT_EXIT    = 2,        /* Always exit after pool2          */
+        CNN_VARIANT_STRIDED = 3         /* Strided conv2, no pool2, no exit */
+    } cnn_variant_t;
+    
+    /* Values of cnn_variant_t */
+    #define CNN_VARIANT_IDS         4
+    
+    /* Variants built, from the most accurate to the cheapest. They are the
+       levels of the QoS controller of CM4. */
+    #ifdef CNN_EARLY_EXIT
+        #define CNN_VARIANTS        4
+        #define CNN_VARIANT_LEVELS  { CNN_VARIANT_FULL, CNN_VARIANT_FAST, CNN_VARIANT_EXIT, CNN_VARIANT_STRIDED }
+    #else
+        #define CNN_VARIANTS        2
+        #define CNN_VARIANT_LEVELS  { CNN_VARIANT_FULL, CNN_VARIANT_STRIDED }
+    #endif
+    
+    /* Softmax confidence (q7) of the early exit of CNN_VARIANT_FAST */
+    #define CNN_FAST_THRESHOLD      90
+
+    /* Number of best classes returned by a run */
+    #define CNN_TOPK            3
+
+    /* Classification result, best class first. margin[i] is how far the
+       score of cls[i] is ahead of the next best class, in the raw
+       accumulator units of the layer that classified. */
+    typedef struct
+    {
+        uint16_t    cls[CNN_TOPK];
+        q31_t       margin[CNN_TOPK];
+    } cnn_result_t;
+
+    cnn_exit_t CNN_Run(const uint8_t *image_data, cnn_result_t *result);
+    #ifdef CNN_INCREMENTAL
+    cnn_exit_t CNN_RunIncremental(const uint8_t *image_data, cnn_result_t *result);
+    #endif
+    #ifdef CNN_MIXED
+    cnn_exit_t CNN_RunMixed(const uint8_t *image_data, cnn_result_t *result);
+    #endif
+    void CNN_GetScores(q7_t *output_data);
+    void CNN_SetExitThreshold(uint8_t threshold);
+    void CNN_SetVariant(cnn_variant_t variant);
+    #ifdef CNN_WEIGHT_STREAM
+    void CNN_SetWeightStore(const ws_backend_t *backend, void *store);
+    void CNN_SetCopyEngine(ce_engine_t *engine, const void *store);
+    #endif
+    #ifdef CNN_ZERO_STATS
+    void CNN_GetZeroGroups(uint32_t *zeros, uint32_t *groups);
+    #endif
+
+#endif /* CNN_CIFAR10_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,288 @@
+/******************************************************************************
+* File Name		: copy_engine.c
+* Version		: 1.0
+*
+* Description:
+*  Copy engine queue. The copies run in submission order, the next one is
+*  started by CE_Poll, CE_Done or CE_Fence when the previous one completed,
+*  so they should be called between the steps of a long computation. The
+*  completion callbacks run from these calls, never from an interrupt.
+*
+*  CE_Submit may be called from an interrupt, e.g. the IPC callback, the
+*  other functions only from the main loop.
+*
+*******************************************************************************/
+#include "copy_engine.h"
+#include "project.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: CE_Init()
+********************************************************************************
+* Summary:
+*   Sets up an engine over a backend, hw is passed to the backend functions.
+*
+*******************************************************************************/
+void CE_Init(ce_engine_t *engine, const ce_backend_t *backend, void *hw)
+{
+    engine->backend = backend;
+    engine->hw = hw;
+    engine->head = 0u;
+    engine->count = 0u;
+    engine->submitted = 0u;
+    engine->completed = 0u;
+    memset(&engine->stats, 0, sizeof(engine->stats));
+}
+
+/*******************************************************************************
+* Function Name: CE_Submit()
+********************************************************************************
+* Summary:
+*   Queues a copy of size bytes from src to dst, started at once when the
+*   engine is idle. Neither buffer may be touched until the fence is reached.
+*   callback, when not NULL, is called with context once the copy completed.
+*
+* Return:
+*   The fence of the copy, or 0 when the queue is full or size is above
+*   CE_MAX_SIZE and nothing was queued.
+*
+*******************************************************************************/
+ce_fence_t CE_Submit(ce_engine_t *engine, void *dst, const void *src, uint32_t size,
+                     ce_callback_t callback, void *context)
+{
+    ce_fence_t fence = 0u;
+    uint32_t   intr = Cy_SysLib_EnterCriticalSection();
+
+    if (engine->count < CE_QUEUE_LEN && size <= CE_MAX_SIZE)
+    {
+        ce_copy_t *copy = &engine->queue[(engine->head + engine->count) % CE_QUEUE_LEN];
+
+        copy->dst = dst;
+        copy->src = src;
+        copy->size = size;
+        copy->callback = callback;
+        copy->context = context;
+
+        if (engine->count++ == 0u)
+        {
+            engine->backend->start(engine->hw, dst, src, size);
+        }
+        fence = ++engine->submitted;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+    return fence;
+}
+
+/*******************************************************************************
+* Function Name: CE_Retire()
+********************************************************************************
+* Summary:
+*   Removes the completed copy at the head of the queue, starts the next one
+*   and calls the completion callback.
+*
+*******************************************************************************/
+static void CE_Retire(ce_engine_t *engine)
+{
+    ce_copy_t copy;
+    uint32_t  intr = Cy_SysLib_EnterCriticalSection();
+
+    copy = engine->queue[engine->head];
+    engine->head = (uint8_t) ((engine->head + 1u) % CE_QUEUE_LEN);
+    engine->completed++;
+    engine->stats.copies++;
+    engine->stats.bytes += copy.size;
+
+    if (--engine->count != 0u)
+    {
+        const ce_copy_t *next = &engine->queue[engine->head];
+
+        engine->backend->start(engine->hw, next->dst, next->src, next->size);
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+
+    if (copy.callback != NULL)
+    {
+        copy.callback(copy.context);
+    }
+}
+
+/*******************************************************************************
+* Function Name: CE_Poll()
+********************************************************************************
+* Summary:
+*   Retires the copies that completed and starts the queued ones, without
+*   waiting.
+*
+*******************************************************************************/
+void CE_Poll(ce_engine_t *engine)
+{
+    while (engine->count != 0u && engine->backend->done(engine->hw))
+    {
+        CE_Retire(engine);
+    }
+}
+
+/*******************************************************************************
+* Function Name: CE_Done()
+********************************************************************************
+* Summary:
+*   Returns true when the fence has been reached.
+*
+*******************************************************************************/
+bool CE_Done(ce_engine_t *engine, ce_fence_t fence)
+{
+    CE_Poll(engine);
+    return (int32_t) (engine->completed - fence) >= 0;
+}
+
+/*******************************************************************************
+* Function Name: CE_Fence()
+********************************************************************************
+* Summary:
+*   Waits until the fence has been reached. The copies queued after it keep
+*   running.
+*
+* Return:
+*   The time waited in microseconds, as far as the backend measures it.
+*
+*******************************************************************************/
+uint32_t CE_Fence(ce_engine_t *engine, ce_fence_t fence)
+{
+    bool     waited = false;
+    uint32_t us = 0u;
+
+    /* a fence not submitted yet would never be reached */
+    if ((int32_t) (fence - engine->submitted) > 0)
+    {
+        return 0u;
+    }
+
+    while ((int32_t) (engine->completed - fence) < 0)
+    {
+        if (!engine->backend->done(engine->hw))
+        {
+            waited = true;
+            us += engine->backend->wait(engine->hw);
+        }
+        CE_Retire(engine);
+    }
+
+    if (waited)
+    {
+        engine->stats.waits++;
+        engine->stats.waitUs += us;
+    }
+    return us;
+}
+
+/*******************************************************************************
+*            CPU backend
+*******************************************************************************/
+static void CE_CpuStart(void *hw, void *dst, const void *src, uint32_t size)
+{
+    (void) hw;
+    memcpy(dst, src, size);
+}
+
+static bool CE_CpuDone(void *hw)
+{
+    (void) hw;
+    return true;
+}
+
+static uint32_t CE_CpuWait(void *hw)
+{
+    (void) hw;
+    return 0u;
+}
+
+const ce_backend_t CE_CpuBackend = { CE_CpuStart, CE_CpuDone, CE_CpuWait };
+
+#ifdef CE_DMA_HW
+/*******************************************************************************
+*            DataWire backend
+********************************************************************************
+*  A copy is a 2D descriptor of 256-byte rows followed by a 1D descriptor for
+*  the remaining bytes, a single trigger runs the whole chain. yCount is at
+*  most 256, CE_Submit keeps copies within CE_MAX_SIZE.
+*
+*******************************************************************************/
+static cy_stc_dma_descriptor_t ceDmaRows;
+static cy_stc_dma_descriptor_t ceDmaTail;
+
+static void CE_DmaStart(void *hw, void *dst, const void *src, uint32_t size)
+{
+    cy_stc_dma_descriptor_config_t config =
+    {
+        .retrigger       = CY_DMA_RETRIG_IM,
+        .interruptType   = CY_DMA_DESCR,
+        .triggerOutType  = CY_DMA_DESCR,
+        .channelState    = CY_DMA_CHANNEL_DISABLED,
+        .triggerInType   = CY_DMA_DESCR_CHAIN,
+        .dataSize        = CY_DMA_BYTE,
+        .srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+        .dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+        .srcXincrement   = 1,
+        .dstXincrement   = 1,
+        .srcYincrement   = 256,
+        .dstYincrement   = 256,
+        .nextDescriptor  = NULL
+    };
+    cy_stc_dma_descriptor_t *first = &ceDmaTail;
+    uint32_t rows = size / 256u;
+    uint32_t tail = size % 256u;
+
+    (void) hw;
+
+    if (tail != 0u || rows == 0u)
+    {
+        config.descriptorType = CY_DMA_1D_TRANSFER;
+        config.srcAddress = (void *) ((const uint8_t *) src + rows * 256u);
+        config.dstAddress = (uint8_t *) dst + rows * 256u;
+        config.xCount = (tail != 0u) ? tail : 1u;
+        (void) Cy_DMA_Descriptor_Init(&ceDmaTail, &config);
+    }
+    if (rows != 0u)
+    {
+        config.descriptorType = CY_DMA_2D_TRANSFER;
+        config.srcAddress = (void *) src;
+        config.dstAddress = dst;
+        config.xCount = 256u;
+        config.yCount = rows;
+        if (tail != 0u)
+        {
+            config.interruptType = CY_DMA_DESCR_CHAIN;
+            config.channelState = CY_DMA_CHANNEL_ENABLED;
+            config.nextDescriptor = &ceDmaTail;
+        }
+        (void) Cy_DMA_Descriptor_Init(&ceDmaRows, &config);
+        first = &ceDmaRows;
+    }
+
+    Cy_DMA_Channel_ClearInterrupt(CE_DMA_HW, CE_DMA_CHANNEL);
+    Cy_DMA_Channel_SetDescriptor(CE_DMA_HW, CE_DMA_CHANNEL, first);
+    Cy_DMA_Channel_Enable(CE_DMA_HW, CE_DMA_CHANNEL);
+    Cy_DMA_Enable(CE_DMA_HW);
+    (void) Cy_TrigMux_SwTrigger(CE_DMA_TRIGGER, CY_TRIGGER_TWO_CYCLES);
+}
+
+static bool CE_DmaDone(void *hw)
+{
+    (void) hw;
+    return (Cy_DMA_Channel_GetInterruptStatus(CE_DMA_HW, CE_DMA_CHANNEL) & CY_DMA_INTR_MASK) != 0u;
+}
+
+static uint32_t CE_DmaWait(void *hw)
+{
+    while (!CE_DmaDone(hw))
+    {
+    }
+    return 0u;
+}
+
+const ce_backend_t CE_DmaBackend = { CE_DmaStart, CE_DmaDone, CE_DmaWait };
+#endif /* CE_DMA_HW */
+
+/* [] END OF FILE */
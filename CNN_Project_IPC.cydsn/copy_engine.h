@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name		: copy_engine.h
+* Version		: 1.0
+*
+* Description:
+*  Asynchronous copy engine. Copies are queued with CE_Submit and run one
+*  after the other by a backend, a DMA channel on the target, while the CPU
+*  keeps computing. Each copy returns a fence to wait on and can carry a
+*  completion callback.
+*
+*******************************************************************************/
+#ifndef COPY_ENGINE_H
+#define COPY_ENGINE_H
+
+    #include <stdint.h>
+    #include <stdbool.h>
+
+    /* DataWire channel used by CE_DmaBackend, reserve it in the design 
+       before enabling. CE_DMA_TRIGGER is the software trigger line routed 
+       to that channel. */
+    //#define CE_DMA_HW               DW0
+    #ifdef CE_DMA_HW
+        #define CE_DMA_CHANNEL      0u
+        #define CE_DMA_TRIGGER      TRIG0_OUT_CPUSS_DW0_TR_IN0
+    #endif
+    
+    /* Copies queued at a time, including the one in progress */
+    #define CE_QUEUE_LEN            8u
+
+    /* Largest copy CE_Submit takes, what one chain of CE_DmaBackend moves
+       (256 rows of 256 bytes). Callers split larger blocks. */
+    #define CE_MAX_SIZE             (256u * 256u)
+
+    /* Fences count the copies submitted from 1 on, a fence is reached when
+       the copy that returned it and all before it have completed */
+    typedef uint32_t ce_fence_t;
+
+    typedef void (*ce_callback_t)(void *context);
+
+    /* One copy at a time, in the same form as the weight_stream backends */
+    typedef struct
+    {
+        /* Starts copying size bytes from src to dst */
+        void     (*start)(void *hw, void *dst, const void *src, uint32_t size);
+        /* Returns true once the last copy started has completed */
+        bool     (*done)(void *hw);
+        /* Waits for the last copy, returns the time waited in microseconds
+           or 0 when the backend has no clock */
+        uint32_t (*wait)(void *hw);
+    } ce_backend_t;
+
+    typedef struct
+    {
+        void       *dst;
+        const void *src;
+        uint32_t    size;
+        ce_callback_t callback;
+        void       *context;
+    } ce_copy_t;
+
+    typedef struct
+    {
+        uint32_t    copies;         /* Copies completed                     */
+        uint32_t    bytes;          /* Bytes copied                         */
+        uint32_t    waits;          /* Fences that had to wait              */
+        uint32_t    waitUs;         /* Time spent waiting on them           */
+    } ce_stats_t;
+
+    typedef struct
+    {
+        const ce_backend_t *backend;
+        void       *hw;
+        ce_copy_t   queue[CE_QUEUE_LEN];
+        uint8_t     head;           /* Copy in progress                     */
+        uint8_t     count;          /* Copies queued                        */
+        ce_fence_t  submitted;      /* Fence of the last copy submitted     */
+        ce_fence_t  completed;      /* Fence of the last copy completed     */
+        ce_stats_t  stats;
+    } ce_engine_t;
+
+    void        CE_Init(ce_engine_t *engine, const ce_backend_t *backend, void *hw);
+    ce_fence_t  CE_Submit(ce_engine_t *engine, void *dst, const void *src, uint32_t size,
+                          ce_callback_t callback, void *context);
+    void        CE_Poll(ce_engine_t *engine);
+    bool        CE_Done(ce_engine_t *engine, ce_fence_t fence);
+    uint32_t    CE_Fence(ce_engine_t *engine, ce_fence_t fence);
+
+    /* Plain memcpy, completed when start returns. Fallback for targets
+       without a free DMA channel. */
+    extern const ce_backend_t CE_CpuBackend;
+
+    /* DataWire channel CE_DMA_CHANNEL, hw is unused */
+    #ifdef CE_DMA_HW
+    extern const ce_backend_t CE_DmaBackend;
+    #endif
+
+#endif /* COPY_ENGINE_H */
+
+/* [] END OF FILE */
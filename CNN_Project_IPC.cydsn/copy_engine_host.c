@@ -0,0 +1,144 @@
+/******************************************************************************
+* File Name		: copy_engine_host.c
+* Version		: 1.0
+*
+* Description:
+*  Worker-thread backend for running copy_engine on a PC. The copies overlap
+*  with the computation of the calling thread like DMA transfers on the
+*  target, so the CE_ statistics show how long the fences had to wait.
+*
+*******************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "copy_engine_host.h"
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Function Name: CE_HostWorker()
+********************************************************************************
+* Summary:
+*   Runs the copies started by CE_HostStart one at a time.
+*
+*******************************************************************************/
+static void *CE_HostWorker(void *arg)
+{
+    ce_host_t *host = (ce_host_t *) arg;
+
+    pthread_mutex_lock(&host->lock);
+    for (;;)
+    {
+        while (!host->busy && !host->quit)
+        {
+            pthread_cond_wait(&host->cond, &host->lock);
+        }
+        if (host->quit)
+        {
+            break;
+        }
+        pthread_mutex_unlock(&host->lock);
+
+        memcpy(host->dst, host->src, host->size);
+        if (host->usPerKb)
+        {
+            uint64_t        ns = (uint64_t) host->size * host->usPerKb * 1000u / 1024u;
+            struct timespec delay = { (time_t) (ns / 1000000000u), (long) (ns % 1000000000u) };
+
+            nanosleep(&delay, NULL);
+        }
+
+        pthread_mutex_lock(&host->lock);
+        host->busy = false;
+        pthread_cond_broadcast(&host->cond);
+    }
+    pthread_mutex_unlock(&host->lock);
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: CE_HostOpen()
+********************************************************************************
+* Summary:
+*   Starts the worker thread. usPerKb adds a copy time per KB, 0 copies as
+*   fast as memcpy allows.
+*
+*******************************************************************************/
+bool CE_HostOpen(ce_host_t *host, uint32_t usPerKb)
+{
+    host->usPerKb = usPerKb;
+    host->busy = false;
+    host->quit = false;
+    pthread_mutex_init(&host->lock, NULL);
+    pthread_cond_init(&host->cond, NULL);
+    return pthread_create(&host->worker, NULL, CE_HostWorker, host) == 0;
+}
+
+/*******************************************************************************
+* Function Name: CE_HostClose()
+********************************************************************************
+* Summary:
+*   Stops the worker once the copy in progress is done.
+*
+*******************************************************************************/
+void CE_HostClose(ce_host_t *host)
+{
+    pthread_mutex_lock(&host->lock);
+    while (host->busy)
+    {
+        pthread_cond_wait(&host->cond, &host->lock);
+    }
+    host->quit = true;
+    pthread_cond_broadcast(&host->cond);
+    pthread_mutex_unlock(&host->lock);
+
+    pthread_join(host->worker, NULL);
+    pthread_cond_destroy(&host->cond);
+    pthread_mutex_destroy(&host->lock);
+}
+
+/*******************************************************************************
+*            Backend
+*******************************************************************************/
+static void CE_HostStart(void *arg, void *dst, const void *src, uint32_t size)
+{
+    ce_host_t *host = (ce_host_t *) arg;
+
+    pthread_mutex_lock(&host->lock);
+    host->dst = dst;
+    host->src = src;
+    host->size = size;
+    host->busy = true;
+    pthread_cond_broadcast(&host->cond);
+    pthread_mutex_unlock(&host->lock);
+}
+
+static bool CE_HostDone(void *arg)
+{
+    ce_host_t *host = (ce_host_t *) arg;
+    bool done;
+
+    pthread_mutex_lock(&host->lock);
+    done = !host->busy;
+    pthread_mutex_unlock(&host->lock);
+    return done;
+}
+
+static uint32_t CE_HostWait(void *arg)
+{
+    ce_host_t *host = (ce_host_t *) arg;
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pthread_mutex_lock(&host->lock);
+    while (host->busy)
+    {
+        pthread_cond_wait(&host->cond, &host->lock);
+    }
+    pthread_mutex_unlock(&host->lock);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return (uint32_t) ((t1.tv_sec - t0.tv_sec) * 1000000 + (t1.tv_nsec - t0.tv_nsec) / 1000);
+}
+
+const ce_backend_t CE_HostBackend = { CE_HostStart, CE_HostDone, CE_HostWait };
+
+/* [] END OF FILE */
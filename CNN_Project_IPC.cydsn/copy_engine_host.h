@@ -0,0 +1,38 @@
+/******************************************************************************
+* File Name		: copy_engine_host.h
+* Version		: 1.0
+*
+* Description:
+*  Host stand-in for the DMA backend of copy_engine: copies are done by a
+*  worker thread, with an optional delay per KB to model the bus throughput.
+*  Only for builds on a PC, copy_engine_host.c is not part of the PSoC
+*  Creator project.
+*
+*******************************************************************************/
+#ifndef COPY_ENGINE_HOST_H
+#define COPY_ENGINE_HOST_H
+
+    #include <pthread.h>
+    #include "copy_engine.h"
+
+    typedef struct
+    {
+        uint32_t        usPerKb;    /* Added copy time per KB               */
+        pthread_t       worker;
+        pthread_mutex_t lock;
+        pthread_cond_t  cond;
+        void           *dst;        /* Copy in progress                     */
+        const void     *src;
+        uint32_t        size;
+        bool            busy;
+        bool            quit;
+    } ce_host_t;
+
+    bool CE_HostOpen(ce_host_t *host, uint32_t usPerKb);
+    void CE_HostClose(ce_host_t *host);
+
+    extern const ce_backend_t CE_HostBackend;
+
+#endif /* COPY_ENGINE_HOST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name		: frame_gate.c
+* Version		: 1.0 
+*
+* Description:
+*  Block-wise SAD change detection between the current frame and the last 
+*  frame forwarded to CM4. Runs on CM0+, so it only uses plain byte loads 
+*  and stops at the first block that has changed.
+*
+*******************************************************************************/
+#include "frame_gate.h"
+#include <string.h>
+
+/****************************************************************************
+*            Global Variables
+*****************************************************************************/
+static uint8_t refFrame[FRAME_GATE_SIZE];   /* Last frame sent to CM4       */
+static bool    refValid = false;            /* refFrame holds a frame       */
+
+/*******************************************************************************
+* Function Name: FrameGate_Reset()
+********************************************************************************
+* Summary:
+*   Drops the reference frame, so the next frame is always reported as 
+*   changed.
+*
+*******************************************************************************/
+void FrameGate_Reset(void)
+{
+    refValid = false;
+}
+
+/*******************************************************************************
+* Function Name: FrameGate_HasChanged()
+********************************************************************************
+* Summary:
+*   Compares the frame with the reference frame block by block.
+*
+* Parameters:
+*   frame: 32x32 RGB image in [RGB, RGB ... RGB] format
+*
+* Return:
+*   true if any block SAD exceeds FRAME_GATE_THRESHOLD or there is no 
+*   reference frame yet.
+*
+*******************************************************************************/
+bool FrameGate_HasChanged(const uint8_t *frame)
+{
+    uint32_t blk_y, blk_x, row;
+    
+    if (!refValid)
+    {
+        return true;
+    }
+    
+    for (blk_y = 0; blk_y < FRAME_GATE_IM_DIM; blk_y += FRAME_GATE_BLOCK_DIM)
+    {
+        for (blk_x = 0; blk_x < FRAME_GATE_IM_DIM; blk_x += FRAME_GATE_BLOCK_DIM)
+        {
+            uint32_t sad = 0;
+            
+            for (row = blk_y; row < blk_y + FRAME_GATE_BLOCK_DIM; row++)
+            {
+                /* One block row is contiguous in HWC layout */
+                uint32_t offset = (row * FRAME_GATE_IM_DIM + blk_x) * FRAME_GATE_IM_CH;
+                const uint8_t *pCur = frame + offset;
+                const uint8_t *pRef = refFrame + offset;
+                uint32_t cnt = FRAME_GATE_BLOCK_DIM * FRAME_GATE_IM_CH;
+                
+                while (cnt)
+                {
+                    int32_t diff = (int32_t) *pCur++ - (int32_t) *pRef++;
+                    sad += (diff < 0) ? -diff : diff;
+                    cnt--;
+                }
+            }
+            
+            if (sad > FRAME_GATE_THRESHOLD)
+            {
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: FrameGate_Accept()
+********************************************************************************
+* Summary:
+*   Stores the frame forwarded to CM4 as the new reference. Only forwarded 
+*   frames are stored, so a slow drift still triggers once it accumulates 
+*   past the threshold.
+*
+*******************************************************************************/
+void FrameGate_Accept(const uint8_t *frame)
+{
+    memcpy(refFrame, frame, FRAME_GATE_SIZE);
+    refValid = true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,38 @@
+/******************************************************************************
+* File Name		: frame_gate.h
+* Version		: 1.0 
+*
+* Description:
+*  Change detection on the producer side (CM0+). A frame is only forwarded
+*  to CM4 when it differs from the last forwarded frame by more than a
+*  threshold, otherwise the last classification is still valid.
+*
+*******************************************************************************/
+#ifndef FRAME_GATE_H
+#define FRAME_GATE_H	
+    
+    #include <stdint.h>
+    #include <stdbool.h>
+    #include "arm_nnexamples_cifar10_parameter.h"
+    
+    #define FRAME_GATE_IM_DIM       CONV1_IM_DIM
+    #define FRAME_GATE_IM_CH        CONV1_IM_CH
+    #define FRAME_GATE_SIZE         (FRAME_GATE_IM_DIM * FRAME_GATE_IM_DIM * FRAME_GATE_IM_CH)
+    
+    /* The frame is split in BLOCK_DIM x BLOCK_DIM pixel blocks and the sum of 
+       absolute differences (SAD) is computed per block. Using the worst block 
+       instead of the whole frame keeps small, local changes from being 
+       averaged out by a static background. */
+    #define FRAME_GATE_BLOCK_DIM    8
+    
+    /* A block has changed when its SAD exceeds the threshold. The default is 
+       an average difference of 8 levels per RGB sample. */
+    #define FRAME_GATE_THRESHOLD    (FRAME_GATE_BLOCK_DIM * FRAME_GATE_BLOCK_DIM * FRAME_GATE_IM_CH * 8)
+    
+    void FrameGate_Reset(void);
+    bool FrameGate_HasChanged(const uint8_t *frame);
+    void FrameGate_Accept(const uint8_t *frame);
+    
+#endif /* FRAME_GATE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,239 @@
+/******************************************************************************
+* File Name		: infer_sched.c
+* Version		: 1.0
+*
+* Description:
+*  Priority and deadline scheduler of the CM4 requests, see infer_sched.h.
+*  The slots are few, so they are scanned rather than kept sorted.
+*
+*******************************************************************************/
+#include "infer_sched.h"
+
+static const uint32_t profileUs[SCHED_MODELS] = SCHED_PROFILE_US;
+
+/*******************************************************************************
+* Function Name: SCHED_Init()
+********************************************************************************
+* Summary:
+*   Empties the scheduler and loads the profiled latency estimates.
+*   cyclesPerUs converts them to the cycles of the time counter.
+*
+*******************************************************************************/
+void SCHED_Init(sched_t *sched, uint32_t cyclesPerUs)
+{
+    for (uint32_t i = 0; i < SCHED_SLOTS; i++)
+    {
+        sched->slot[i].state = SCHED_FREE;
+    }
+    for (uint32_t i = 0; i < SCHED_MODELS; i++)
+    {
+        sched->estimate[i] = profileUs[i] * cyclesPerUs;
+    }
+    sched->cyclesPerUs = cyclesPerUs;
+    sched->arrivals = 0u;
+    sched->started = 0u;
+    sched->stats.scheduled = 0u;
+    sched->stats.late = 0u;
+    sched->stats.dropped = 0u;
+}
+
+/*******************************************************************************
+* Function Name: SCHED_Add()
+********************************************************************************
+* Summary:
+*   Takes a request received at now. deadlineUs counts from now, 0 means no
+*   deadline. The request waits for SCHED_Ready before it is scheduled.
+*
+* Return:
+*   The slot of the request, -1 if all slots are taken.
+*
+*******************************************************************************/
+int32_t SCHED_Add(sched_t *sched, uint8_t model, uint8_t priority,
+                  uint32_t deadlineUs, uint32_t now)
+{
+    for (uint32_t i = 0; i < SCHED_SLOTS; i++)
+    {
+        sched_slot_t *slot = &sched->slot[i];
+
+        if (slot->state == SCHED_FREE)
+        {
+            slot->release = now;
+            slot->deadline = now + deadlineUs * sched->cyclesPerUs;
+            slot->hasDeadline = (deadlineUs != 0u);
+            slot->order = sched->arrivals++;
+            slot->priority = priority;
+            slot->model = (model < SCHED_MODELS) ? model : SCHED_MODEL_CONTROL;
+            slot->state = SCHED_WAITING;
+            return (int32_t) i;
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: SCHED_Ready()
+********************************************************************************
+* Summary:
+*   The input of the request arrived, it can be scheduled.
+*
+*******************************************************************************/
+void SCHED_Ready(sched_t *sched, uint32_t slot)
+{
+    sched->slot[slot].state = SCHED_READY;
+}
+
+/*******************************************************************************
+* Function Name: SCHED_SetModel()
+********************************************************************************
+* Summary:
+*   Moves the requests held for model from to model to, e.g. when another
+*   variant of the network will run them.
+*
+*******************************************************************************/
+void SCHED_SetModel(sched_t *sched, uint8_t from, uint8_t to)
+{
+    for (uint32_t i = 0; i < SCHED_SLOTS; i++)
+    {
+        sched_slot_t *slot = &sched->slot[i];
+        
+        if (slot->state != SCHED_FREE && slot->state != SCHED_RUNNING && slot->model == from)
+        {
+            slot->model = to;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: SCHED_Before()
+********************************************************************************
+* Summary:
+*   Returns true if request a runs before request b.
+*
+*******************************************************************************/
+static bool SCHED_Before(const sched_slot_t *a, const sched_slot_t *b)
+{
+    if (a->priority != b->priority)
+    {
+        return a->priority > b->priority;
+    }
+    if (a->hasDeadline != b->hasDeadline)
+    {
+        return a->hasDeadline != 0u;
+    }
+    if (a->hasDeadline != 0u && a->deadline != b->deadline)
+    {
+        return (int32_t) (a->deadline - b->deadline) < 0;
+    }
+    return (int32_t) (a->order - b->order) < 0;
+}
+
+/*******************************************************************************
+* Function Name: SCHED_Next()
+********************************************************************************
+* Summary:
+*   Picks the next request at now. A ready request that would finish past
+*   its deadline is returned first as SCHED_DROP, otherwise the request to
+*   run as SCHED_RUN. Either way the caller answers it and calls SCHED_Done.
+*
+*******************************************************************************/
+sched_pick_t SCHED_Next(sched_t *sched, uint32_t now, uint32_t *slot)
+{
+    int32_t best = -1;
+
+    for (uint32_t i = 0; i < SCHED_SLOTS; i++)
+    {
+        sched_slot_t *s = &sched->slot[i];
+
+        if (s->state != SCHED_READY)
+        {
+            continue;
+        }
+        if (s->hasDeadline != 0u &&
+            (int32_t) (s->deadline - (now + sched->estimate[s->model])) < 0)
+        {
+            s->state = SCHED_DROPPED;
+            *slot = i;
+            return SCHED_DROP;
+        }
+        if (best < 0 || SCHED_Before(s, &sched->slot[best]))
+        {
+            best = (int32_t) i;
+        }
+    }
+
+    if (best < 0)
+    {
+        return SCHED_NONE;
+    }
+    sched->slot[best].state = SCHED_RUNNING;
+    sched->started = now;
+    *slot = (uint32_t) best;
+    return SCHED_RUN;
+}
+
+/*******************************************************************************
+* Function Name: SCHED_Done()
+********************************************************************************
+* Summary:
+*   Frees the slot of a request returned by SCHED_Next. For a request that
+*   ran, the run time since SCHED_Next refines the estimate of its model.
+*
+*******************************************************************************/
+void SCHED_Done(sched_t *sched, uint32_t slot, uint32_t now)
+{
+    sched_slot_t *s = &sched->slot[slot];
+
+    if (s->state == SCHED_RUNNING)
+    {
+        uint32_t run = now - sched->started;
+        uint32_t *estimate = &sched->estimate[s->model];
+
+        *estimate = *estimate - (*estimate >> SCHED_EST_SHIFT) + (run >> SCHED_EST_SHIFT);
+    }
+
+    if (s->hasDeadline != 0u)
+    {
+        sched->stats.scheduled++;
+        if (s->state == SCHED_DROPPED)
+        {
+            sched->stats.dropped++;
+        }
+        else if ((int32_t) (now - s->deadline) > 0)
+        {
+            sched->stats.late++;
+        }
+    }
+    s->state = SCHED_FREE;
+}
+
+/*******************************************************************************
+* Function Name: SCHED_Held()
+********************************************************************************
+* Summary:
+*   Returns the number of requests held, up to SCHED_SLOTS.
+*
+*******************************************************************************/
+uint32_t SCHED_Held(const sched_t *sched)
+{
+    uint32_t held = 0u;
+    
+    for (uint32_t i = 0; i < SCHED_SLOTS; i++)
+    {
+        held += (sched->slot[i].state != SCHED_FREE);
+    }
+    return held;
+}
+
+/*******************************************************************************
+* Function Name: SCHED_EstimateUs()
+********************************************************************************
+* Summary:
+*   Returns the current latency estimate of a model in microseconds.
+*
+*******************************************************************************/
+uint32_t SCHED_EstimateUs(const sched_t *sched, uint8_t model)
+{
+    return sched->estimate[model] / sched->cyclesPerUs;
+}
+
+/* [] END OF FILE */
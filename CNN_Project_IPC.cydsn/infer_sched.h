@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name		: infer_sched.h
+* Version		: 1.0
+*
+* Description:
+*  Scheduler of the requests held by CM4. Each request carries a priority
+*  and an optional deadline. The next one to run is taken from the highest
+*  priority, earliest deadline first (EDF) within a priority, and in
+*  arrival order among equal deadlines. Requests without a deadline come
+*  after the ones with a deadline of the same priority.
+*
+*  A request that can no longer finish before its deadline, going by the
+*  latency estimate of its model, is dropped instead of run: under burst
+*  load stale frames are skipped rather than delaying the fresh ones.
+*
+*  Times are in cycles of a free-running counter, e.g. DWT CYCCNT, and
+*  compared by their difference so the wrap of the counter is harmless.
+*
+*******************************************************************************/
+#ifndef INFER_SCHED_H
+#define INFER_SCHED_H
+
+    #include <stdint.h>
+    #include <stdbool.h>
+
+    /* Requests held at a time */
+    #define SCHED_SLOTS             4u
+
+    /* Models with their own latency estimate, an inference of variant v of
+       the network is model SCHED_MODEL_INFER + v */
+    #define SCHED_MODEL_CONTROL     0u      /* Stats, model switch      */
+    #define SCHED_MODEL_INFER       1u      /* CNN inference            */
+    #define SCHED_MODELS            5u
+
+    /* Initial latency estimates in microseconds, refined with the measured
+       run times. The inference estimates are on the safe side for CNN_Run
+       of CM4 at 100 MHz, conv3 is about a quarter of the MACs and is
+       skipped by the early exit, the strided conv2 leaves out three
+       quarters of conv2, a third of the MACs. Set them from the CNN_TRACE
+       timings of the target to drop fewer requests at start-up. */
+    #define SCHED_PROFILE_US        { 100u, 250000u, 220000u, 185000u, 160000u }
+
+    /* Weight of a new run time in the estimate, 1 / 2^SCHED_EST_SHIFT */
+    #define SCHED_EST_SHIFT         3u
+
+    /* Decision of SCHED_Next */
+    typedef enum
+    {
+        SCHED_NONE      = 0,            /* No request ready                 */
+        SCHED_RUN       = 1,            /* Run the request, then SCHED_Done */
+        SCHED_DROP      = 2             /* Deadline missed, SCHED_Done      */
+    } sched_pick_t;
+
+    typedef enum
+    {
+        SCHED_FREE      = 0,
+        SCHED_WAITING   = 1,            /* Added, its input not ready yet   */
+        SCHED_READY     = 2,
+        SCHED_RUNNING   = 3,
+        SCHED_DROPPED   = 4
+    } sched_state_t;
+
+    typedef struct
+    {
+        uint32_t    release;        /* Time of reception                    */
+        uint32_t    deadline;       /* Time it must be done by              */
+        uint32_t    order;          /* Arrival order                        */
+        uint8_t     hasDeadline;
+        uint8_t     priority;       /* Higher runs first                    */
+        uint8_t     model;          /* SCHED_MODEL_...                      */
+        uint8_t     state;          /* sched_state_t                        */
+    } sched_slot_t;
+
+    typedef struct
+    {
+        uint32_t    scheduled;      /* Requests with a deadline finished    */
+        uint32_t    late;           /* Of them, run but finished late       */
+        uint32_t    dropped;        /* Of them, dropped before running      */
+    } sched_stats_t;
+
+    typedef struct
+    {
+        sched_slot_t slot[SCHED_SLOTS];
+        uint32_t    estimate[SCHED_MODELS];     /* Latency, in cycles       */
+        uint32_t    cyclesPerUs;
+        uint32_t    arrivals;
+        uint32_t    started;        /* Time the running request started     */
+        sched_stats_t stats;
+    } sched_t;
+
+    void         SCHED_Init(sched_t *sched, uint32_t cyclesPerUs);
+    int32_t      SCHED_Add(sched_t *sched, uint8_t model, uint8_t priority,
+                           uint32_t deadlineUs, uint32_t now);
+    void         SCHED_Ready(sched_t *sched, uint32_t slot);
+    void         SCHED_SetModel(sched_t *sched, uint8_t from, uint8_t to);
+    sched_pick_t SCHED_Next(sched_t *sched, uint32_t now, uint32_t *slot);
+    void         SCHED_Done(sched_t *sched, uint32_t slot, uint32_t now);
+    uint32_t     SCHED_Held(const sched_t *sched);
+    uint32_t     SCHED_EstimateUs(const sched_t *sched, uint8_t model);
+
+#endif /* INFER_SCHED_H */
+
+/* [] END OF FILE */
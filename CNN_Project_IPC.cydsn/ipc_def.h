@@ -11,19 +11,118 @@
     
     #include <stdint.h>
     #include "arm_math.h"
+    #include "spsc_ring.h"
         
     //#define IPC_BUFFER_SIZE                 256
     #define IPC_CM0_TO_CM4_CLIENT_ID        0
     #define IPC_CM4_TO_CM0_CLIENT_ID        1
       
+    /* Requests CM0+ may have outstanding, i.e. sent without a result back 
+       yet. CM4 holds an image buffer for each of them, and schedules them
+       by priority and deadline. */
+    #define IPC_WINDOW                      4
+    
+    /* Requests and results travel in SPSC rings of IPC_RING_SIZE entries,
+       the request ring is owned by CM0+ and the result ring by CM4. A 
+       pipe message is only a doorbell, rung once per IPC_DOORBELL_BATCH
+       requests or when the other core waits for one. */
+    #define IPC_RING_SIZE                   8       /* Power of two         */
+    #define IPC_DOORBELL_BATCH              4
+    
+    /* Request types */
+    #define IPC_REQ_INFER                   0u      /* Classify the image   */
+    #define IPC_REQ_LOAD_MODEL              1u      /* Switch weight store  */
+    #define IPC_REQ_QUERY_STATS             2u      /* Counters of CM4      */
+    
+    /* Doorbell, carries the ring of the sender so the other core finds it */
     typedef struct __attribute__((packed, aligned(4)))
     {
         uint8_t     clientId;
         uint8_t     userCode;
         uint16_t    intrMask;
-        uint8_t     *ptrImgBuffer;
+        spsc_ring_t *ring;
     } ipc_msg_t ;
     
+    /* Priority of a request, a higher one runs first */
+    #define IPC_PRIO_LOW                    0u
+    #define IPC_PRIO_NORMAL                 1u
+    #define IPC_PRIO_HIGH                   2u
+    
+    typedef struct __attribute__((packed, aligned(4)))
+    {
+        uint8_t     *ptrImgBuffer;
+        uint32_t    deadlineUs;     /* From reception on CM4, 0 for none */
+        uint16_t    seq;            /* Sequence number, echoed in the result */
+        uint8_t     type;           /* IPC_REQ_...                      */
+        uint8_t     priority;       /* IPC_PRIO_...                     */
+        uint8_t     arg;
+    } ipc_request_t;
+    
+    /* Results are sent back to CM0+ through the result ring, with a 
+       doorbell every IPC_RESULT_BATCH records. CM0+ formats and prints them */
+    #define IPC_RESULT_BATCH                4
+    #define IPC_RESULT_TOPK                 3       /* Up to CNN_TOPK       */
+    #define IPC_RESULT_CLASSES              10
+    
+    /* Also send the ten softmax scores, which costs a softmax per image */
+    //#define IPC_RESULT_SCORES
+    
+    /* Status of a result */
+    #define IPC_STATUS_OK                   0u
+    #define IPC_STATUS_NO_IMAGE             1u      /* Nothing classified   */
+    #define IPC_STATUS_UNSUPPORTED          2u      /* Not in this build    */
+    #define IPC_STATUS_DEADLINE             3u      /* Dropped, too late    */
+    
+    /* Layers of the zero channel group counts, conv2, conv3 and ip1 */
+    #define IPC_STATS_ZERO_LAYERS           3
+    
+    /* Exit point of an inference */
+    #define IPC_RESULT_EXIT_EARLY           0u      /* Early-exit head      */
+    #define IPC_RESULT_EXIT_FULL            1u      /* Full network         */
+    
+    typedef struct __attribute__((packed))
+    {
+        q31_t       margin[IPC_RESULT_TOPK];
+        uint32_t    latencyUs;      /* From reception to result on CM4  */
+        uint8_t     cls[IPC_RESULT_TOPK];
+        uint8_t     exitPoint;
+        uint8_t     variant;        /* Variant of the network, 0 full   */
+    #ifdef IPC_RESULT_SCORES
+        q7_t        scores[IPC_RESULT_CLASSES];
+    #endif
+    } ipc_infer_result_t;
+    
+    typedef struct __attribute__((packed))
+    {
+        uint32_t    requests;       /* Requests received                */
+        uint32_t    inferences;
+        uint32_t    earlyExits;
+        uint32_t    avgLatencyUs;
+        uint32_t    maxLatencyUs;
+        uint32_t    deadlines;      /* Requests with a deadline         */
+        uint32_t    late;           /* Of them, finished late           */
+        uint32_t    dropped;        /* Of them, dropped unprocessed     */
+        uint32_t    estimateUs;     /* Inference latency estimate       */
+        uint32_t    qosSwitches;    /* Changes of variant               */
+        /* All-zero groups of four input channels of each layer, and the
+           groups counted, 0 without CNN_ZERO_STATS */
+        uint32_t    zeroGroups[IPC_STATS_ZERO_LAYERS];
+        uint32_t    groups[IPC_STATS_ZERO_LAYERS];
+        uint8_t     variant;        /* Variant in use, 0 full           */
+    } ipc_stats_result_t;
+    
+    typedef struct __attribute__((packed, aligned(4)))
+    {
+        uint16_t    seq;            /* Sequence number of the request   */
+        uint8_t     type;           /* IPC_REQ_... of the request       */
+        uint8_t     status;         /* IPC_STATUS_...                   */
+        union
+        {
+            ipc_infer_result_t  infer;
+            ipc_stats_result_t  stats;
+        };
+    } ipc_result_t;
+    
 #endif /* IPC_DEF_H */
 
 /* [] END OF FILE */
@@ -6,7 +6,10 @@
 * Description: This example demonstrates how to use the IPC to implement a 
 *              message pipe in PSoC 6 MCU. The pipe is used as a method to 
 *              send messages between the CPUs. CM0p will send the 32x32 RGB
-*              image to CM4, and CM4 will execute the CNN application
+*              image to CM4, and CM4 will execute the CNN application. The
+*              requests and results travel through rings in shared memory,
+*              the pipe only rings the doorbell. CM0p prints the results,
+*              it owns the UART.
 *
 * Hardware Dependency: PSoC 6 BLE Pioneer kit CY8CKIT-062-BLE
 ****************************************************************************/
@@ -17,23 +20,52 @@
 #include "arm_nnexamples_cifar10_parameter.h"
 #include "arm_nnexamples_cifar10_weights.h"
 #include "arm_nnexamples_cifar10_inputs.h"
+#include "frame_gate.h"
+#include "spsc_ring.h"
 /****************************************************************************
 *            Global Variables
 *****************************************************************************/
-ipc_msg_t ipcMsgForCM4 = {              /* IPC structure to be sent to CM4  */
+ipc_msg_t ipcMsgForCM4 = {              /* Doorbell sent to CM4             */
     .clientId = IPC_CM0_TO_CM4_CLIENT_ID,
     .userCode = 0,
     .intrMask = CY_SYS_CYPIPE_INTR_MASK,
-    .ptrImgBuffer   = NULL
+    .ring = NULL
 };
 
-ipc_msg_t *ipcMsgFromCM4;
-volatile bool rdyToRecvMsg = true;      /* Ready to receive message flag    */
+/* Requests for CM4 */
+ipc_request_t requestEntries[IPC_RING_SIZE];
+spsc_ring_t requestRing;
+spsc_producer_t requestProducer;
+uint16_t requestSeq = 0;
+
+/* Results from CM4, its ring is known once its first doorbell came */
+spsc_ring_t * volatile resultRing = NULL;
+
+/* A frame not classified within this time from its reception by CM4 is
+   stale, CM4 drops it rather than falling behind. 0 for no deadline. */
+#define FRAME_DEADLINE_US       500000u
+
+/* Requests without a result yet are requestsSent - resultsReceived, at
+   most IPC_WINDOW */
+uint32_t requestsSent = 0;
+uint32_t resultsReceived = 0;
+
+/* Result of the last frame accepted by the frame gate, printed again while
+   the frame does not change. Valid once the result of request lastFrameSeq
+   came back. */
+ipc_result_t lastFrameResult;
+uint16_t lastFrameSeq = 0;
+bool lastFrameValid = false;
 
 /****************************************************************************
 *            Prototype Functions
 *****************************************************************************/
-void CM0_ReleaseCallback(void);
+bool CM0_SendRequest(uint8_t type, uint8_t *ptr, uint8_t priority, uint32_t deadlineUs);
+void CM0_Doorbell(void *context);
+void CM0_ResultCallback(uint32_t *msg);
+void CM0_PrintResult(const ipc_result_t *record);
+void CM0_PrintClasses(const ipc_result_t *record);
+void CM0_KeepFrameResult(const ipc_result_t *record);
 
 uint8_t  image_data_M0p[CONV1_IM_CH * CONV1_IM_DIM * CONV1_IM_DIM] = IMG_DATA;
 
@@ -59,16 +91,43 @@ int main(void)
     /* Send welcome message to UART */
     Cy_SCB_UART_PutString(UART_HW, "\r\n---- IPC Pipes Code Example (Image) --------\r\n");
     Cy_SCB_UART_PutString(UART_HW, "\r\n---- Press ENTER to send 32x32 RGB image ---\r\n");
+    Cy_SCB_UART_PutString(UART_HW, "\r\n---- Press 'f' to force a new inference ----\r\n");
+    Cy_SCB_UART_PutString(UART_HW, "\r\n---- Press 's' to query the CM4 statistics -\r\n");
     Cy_SCB_UART_PutString(UART_HW, "\r\n--------------------------------------------\n\n\r> ");
     
     
+    /* Requests go to CM4 through a ring, the doorbell comes once per 
+    IPC_DOORBELL_BATCH requests or when CM4 sleeps */
+    SPSC_Init(&requestRing, requestEntries, sizeof(requestEntries[0]), IPC_RING_SIZE);
+    SPSC_ProducerInit(&requestProducer, &requestRing, IPC_DOORBELL_BATCH, CM0_Doorbell, NULL);
+    ipcMsgForCM4.ring = &requestRing;
+    
+    /* Register the callback of the doorbell of CM4 */
+    Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_ADDR,
+                                 CM0_ResultCallback,
+                                 IPC_CM4_TO_CM0_CLIENT_ID);
+    
     /* Enable CM4.  CY_CORTEX_M4_APPL_ADDR must be updated if CM4 memory layout is changed. */
     Cy_SysEnableCM4(CY_CORTEX_M4_APPL_ADDR);
     
     for(;;)
     {
-        /* Check if ready to send a message */
-        if (rdyToRecvMsg)
+        /* Print the results received from CM4 */
+        if (resultRing != NULL)
+        {
+            ipc_result_t record;
+            
+            while (SPSC_Pop(resultRing, &record))
+            {
+                /* Each result closes one request of the window */
+                resultsReceived++;
+                CM0_KeepFrameResult(&record);
+                CM0_PrintResult(&record);
+            }
+        }
+        
+        /* Check if CM4 is up, and the window has room */
+        if (resultRing != NULL && requestsSent - resultsReceived < IPC_WINDOW)
         {       
             /* Get one character from the RX fifo*/
             character = Cy_SCB_UART_Get(UART_HW);
@@ -78,26 +137,53 @@ int main(void)
             {
                 switch (character)
                 {
+                    case 'f':
+                        /* Drop the reference frame so the next one is sent */
+                        FrameGate_Reset();
+                        /* fall through */
+                        
                     case '\r':
                         /* If ENTER is pressed, process the command */
                         Cy_SCB_UART_Put(UART_HW, '\n');
                         Cy_SCB_UART_Put(UART_HW, '\r');
                         
-                        /* Here ptrImgBuffer points to the RGB image 
+                        /* Skip the inference if the frame did not change
+                        since the last one sent, the last result still holds */
+                        if (!FrameGate_HasChanged(image_data_M0p))
+                        {
+                            if (lastFrameValid)
+                            {
+                                /* Only the classes, the latency was the 
+                                one of the request that classified it */
+                                printf("Frame unchanged, cached result of request %u:\r\n", lastFrameResult.seq);
+                                CM0_PrintClasses(&lastFrameResult);
+                                Cy_SCB_UART_PutString(UART_HW, "\r\n> ");
+                            }
+                            else
+                            {
+                                Cy_SCB_UART_PutString(UART_HW, "Frame unchanged, its result is pending\r\n\n> ");
+                            }
+                            break;
+                        }
+                        
+                        FrameGate_Accept(image_data_M0p);
+                        
+                        /* Here the request points to the RGB image 
                         accessed by CM0+, then sent to CM4.
                         If camera is implemented, there should by a task
-                        that extracts the image and stores it in memory. Then 
-                        the following line will point to the image to be sent
+                        that extracts the image and stores it in memory, in
+                        one buffer per outstanding request. Then the 
+                        following line will point to the image to be sent
                         to CM4 */
-                        ipcMsgForCM4.ptrImgBuffer = image_data_M0p;
-                        
-                        /* Clear flag */
-                        rdyToRecvMsg = false;
+                        lastFrameSeq = requestSeq;
+                        lastFrameValid = false;
+                        (void) CM0_SendRequest(IPC_REQ_INFER, image_data_M0p, IPC_PRIO_NORMAL, FRAME_DEADLINE_US);
+                        break;
                         
-                        /* Send the received characters to CM4 to be processed */
-                        Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM4_ADDR,
-                                                CY_IPC_EP_CYPIPE_CM0_ADDR,
-                                                (uint32_t *) &ipcMsgForCM4, CM0_ReleaseCallback);
+                    case 's':
+                        Cy_SCB_UART_Put(UART_HW, '\n');
+                        Cy_SCB_UART_Put(UART_HW, '\r');
+                        (void) CM0_SendRequest(IPC_REQ_QUERY_STATS, NULL, IPC_PRIO_HIGH, 0u);
                         break;
                         
                     case '\b':
@@ -119,18 +205,208 @@ int main(void)
 
 
 /*******************************************************************************
-* Function Name: CM0_ReleaseCallback()
+* Function Name: CM0_SendRequest()
 ********************************************************************************
 * Summary:
-*   Callback function that is executed when the CM4 receives a message, freeing
-*   this core to send another message to CM4.
+*   Queues a request for CM4 with the next sequence number. For IPC_REQ_INFER
+*   ptr is the image, for IPC_REQ_LOAD_MODEL the weight store. It must stay
+*   unchanged until the result comes back. CM4 runs the request with the 
+*   highest priority first, then the one with the earliest deadline, 
+*   deadlineUs from its reception or 0 for none. The doorbell is rung right 
+*   away if CM4 sleeps, otherwise it finds the request when it is done.
+*
+* Return:
+*   false if IPC_WINDOW requests are outstanding.
 *
 *******************************************************************************/
-void CM0_ReleaseCallback(void)
+bool CM0_SendRequest(uint8_t type, uint8_t *ptr, uint8_t priority, uint32_t deadlineUs)
 {
-    /* Message processed by CM4. Ready to receive a new message */
-    ipcMsgForCM4.ptrImgBuffer = NULL;
-    rdyToRecvMsg = true;
+    ipc_request_t request = {
+        .ptrImgBuffer = ptr,
+        .deadlineUs = deadlineUs,
+        .seq = requestSeq,
+        .type = type,
+        .priority = priority,
+        .arg = 0
+    };
+    
+    if (requestsSent - resultsReceived >= IPC_WINDOW ||
+        !SPSC_Push(&requestProducer, &request))
+    {
+        return false;
+    }
+    
+    requestSeq++;
+    requestsSent++;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: CM0_Doorbell()
+********************************************************************************
+* Summary:
+*   Doorbell of the request ring. If the pipe is still busy with the last one
+*   CM4 has not handled it yet and finds the new requests as well.
+*
+*******************************************************************************/
+void CM0_Doorbell(void *context)
+{
+    (void) context;
+    (void) Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM4_ADDR,
+                                   CY_IPC_EP_CYPIPE_CM0_ADDR,
+                                   (uint32_t *) &ipcMsgForCM4, NULL);
+}
+
+/*******************************************************************************
+* Function Name: CM0_ResultCallback()
+********************************************************************************
+* Summary:
+*   Callback function that is executed when CM4 rings the doorbell. The 
+*   results are taken from the ring in the main loop, the first doorbell 
+*   tells where the ring is.
+*
+* Parameters:
+*   msg: IPC message received
+*
+*******************************************************************************/
+void CM0_ResultCallback(uint32_t *msg)
+{
+    if (msg != NULL)
+    {
+        resultRing = ((ipc_msg_t *) msg)->ring;
+    }
+}
+
+/*******************************************************************************
+* Function Name: CM0_PrintResult()
+********************************************************************************
+* Summary:
+*   Prints a result received from CM4.
+*
+*******************************************************************************/
+void CM0_PrintResult(const ipc_result_t *record)
+{
+    if (record->status == IPC_STATUS_UNSUPPORTED)
+    {
+        printf("Request %u not supported by CM4\r\n\n> ", record->seq);
+        return;
+    }
+    if (record->status == IPC_STATUS_DEADLINE)
+    {
+        printf("Request %u dropped, past its deadline\r\n\n> ", record->seq);
+        return;
+    }
+    
+    switch (record->type)
+    {
+        case IPC_REQ_INFER:
+            if (record->status == IPC_STATUS_NO_IMAGE)
+            {
+                /* If no image received */
+                Cy_SCB_UART_PutString(UART_HW, "\r\n\n\nERROR!\r\n\n");
+                break;
+            }
+            
+            CM0_PrintClasses(record);
+            printf("Request %u, latency: %lu us\r\n\n", record->seq, (unsigned long) record->infer.latencyUs);
+            break;
+            
+        case IPC_REQ_LOAD_MODEL:
+            printf("Request %u, model loaded\r\n\n", record->seq);
+            break;
+            
+        case IPC_REQ_QUERY_STATS:
+            printf("Requests: %lu\r\n", (unsigned long) record->stats.requests);
+            printf("Inferences: %lu, early exits: %lu\r\n", (unsigned long) record->stats.inferences, 
+                   (unsigned long) record->stats.earlyExits);
+            printf("Latency: %lu us average, %lu us max, %lu us estimated\r\n", (unsigned long) record->stats.avgLatencyUs,
+                   (unsigned long) record->stats.maxLatencyUs, (unsigned long) record->stats.estimateUs);
+            printf("Variant: %u, switches: %lu\r\n", record->stats.variant, 
+                   (unsigned long) record->stats.qosSwitches);
+            if (record->stats.deadlines != 0u)
+            {
+                printf("Deadlines: %lu, late: %lu, dropped: %lu, missed: %lu%%\r\n", 
+                       (unsigned long) record->stats.deadlines, (unsigned long) record->stats.late,
+                       (unsigned long) record->stats.dropped,
+                       (unsigned long) ((record->stats.late + record->stats.dropped) * 100u / record->stats.deadlines));
+            }
+            for (int i = 0; i < IPC_STATS_ZERO_LAYERS; i++)
+            {
+                static const char * const layer[IPC_STATS_ZERO_LAYERS] = { "conv2", "conv3", "ip1" };
+                
+                if (record->stats.groups[i] != 0u)
+                {
+                    printf("%s input: %lu%% zero channel groups\r\n", layer[i],
+                           (unsigned long) ((uint64_t) record->stats.zeroGroups[i] * 100u / record->stats.groups[i]));
+                }
+            }
+            Cy_SCB_UART_PutString(UART_HW, "\r\n");
+            break;
+            
+        default:
+            break;
+    }
+    Cy_SCB_UART_PutString(UART_HW, "> ");
+}
+
+/*******************************************************************************
+* Function Name: CM0_PrintClasses()
+********************************************************************************
+* Summary:
+*   Prints the classes of an inference result, without its request and 
+*   latency.
+*
+*******************************************************************************/
+void CM0_PrintClasses(const ipc_result_t *record)
+{
+    if (record->infer.exitPoint == IPC_RESULT_EXIT_EARLY)
+    {
+        Cy_SCB_UART_PutString(UART_HW, "Classified by the early-exit head\r\n");
+    }
+    if (record->infer.variant != 0u)
+    {
+        printf("Reduced variant %u, CM4 is behind\r\n", record->infer.variant);
+    }
+    
+    for (int i = 0; i < IPC_RESULT_TOPK; i++)
+    {
+        printf("#%d: class %d, margin %ld\r\n", i + 1, record->infer.cls[i], 
+               (long) record->infer.margin[i]);
+    }
+    
+#ifdef IPC_RESULT_SCORES
+    for (int i = 0; i < IPC_RESULT_CLASSES; i++)
+    {
+        printf("%d: %d\r\n", i, record->infer.scores[i]);
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: CM0_KeepFrameResult()
+********************************************************************************
+* Summary:
+*   Keeps the result of the last frame accepted by the frame gate. If the 
+*   frame was not classified, e.g. dropped past its deadline, the gate is 
+*   reset so the same frame is sent again.
+*
+*******************************************************************************/
+void CM0_KeepFrameResult(const ipc_result_t *record)
+{
+    if (record->type != IPC_REQ_INFER || record->seq != lastFrameSeq)
+    {
+        return;
+    }
+    
+    if (record->status == IPC_STATUS_OK)
+    {
+        lastFrameResult = *record;
+        lastFrameValid = true;
+    }
+    else
+    {
+        FrameGate_Reset();
+    }
 }
 
 /* [] END OF FILE */
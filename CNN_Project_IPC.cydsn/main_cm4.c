@@ -9,30 +9,79 @@
 ****************************************************************************/
 #include "project.h"
 #include <stdio.h>
+#include <string.h>
 #include "ipc_def.h"
 #include "arm_math.h"
 #include "arm_nnexamples_cifar10_parameter.h"
 #include "arm_nnexamples_cifar10_weights.h"
 #include "arm_nnfunctions.h"
 #include "arm_nnexamples_cifar10_inputs.h"
+#include "cnn_cifar10.h"
+#include "copy_engine.h"
+#include "spsc_ring.h"
+#include "infer_sched.h"
+#include "qos.h"
+
+#if IPC_RESULT_TOPK > CNN_TOPK
+    #error "IPC_RESULT_TOPK is larger than CNN_TOPK"
+#endif
+#if IPC_WINDOW > SCHED_SLOTS
+    #error "IPC_WINDOW is larger than SCHED_SLOTS"
+#endif
+#if SCHED_MODEL_INFER + CNN_VARIANT_IDS > SCHED_MODELS
+    #error "SCHED_MODELS has no estimate for each variant"
+#endif
+#if CNN_ZERO_LAYERS != IPC_STATS_ZERO_LAYERS
+    #error "ipc_stats_result_t has no zero counts for each CNN_ZERO_STATS layer"
+#endif
+
 /*******************************************************************************
 *            Global variables
 *******************************************************************************/
 volatile uint32_t SysTickCnt = 0;         /* Used in SysTick couter         */
 
-volatile bool rdyToProcess = false;      /* Ready to process flag           */
+ce_engine_t copyEngine;                  /* Frame ingest, weight staging    */
+
+/* Doorbell to CM0+, carries the result ring */
+ipc_msg_t ipcMsgForCM0 = {
+    .clientId = IPC_CM4_TO_CM0_CLIENT_ID,
+    .userCode = 0,
+    .intrMask = CY_SYS_CYPIPE_INTR_MASK,
+    .ring = NULL
+};
+
+spsc_ring_t * volatile requestRing = NULL;  /* Owned by CM0+, from its doorbell */
+
+/* Results for CM0+ */
+ipc_result_t resultEntries[IPC_RING_SIZE];
+spsc_ring_t resultRing;
+spsc_producer_t resultProducer;
 
-ipc_msg_t *ipcMsgFromCM0;                /* IPC structure received from CM0 */
+/* Request received from CM0+. Here the image should be the raw uint8 type
+   RGB image in [RGB, RGB, RGB ... RGB] format */
+typedef struct
+{
+    uint8_t     image[CONV1_IM_CH * CONV1_IM_DIM * CONV1_IM_DIM];
+    const uint8_t *ptr;                  /* ptrImgBuffer of the request     */
+    uint32_t    start;                   /* DWT cycle count at reception    */
+    uint16_t    seq;
+    uint8_t     type;
+    uint8_t     arg;
+} cm4_request_t;
+
+/* Requests held, in the slots of the scheduler. CM0+ keeps at most 
+   IPC_WINDOW outstanding, so the ring never holds more than fit here. */
+cm4_request_t requests[SCHED_SLOTS];
+sched_t sched;
+
+/* Picks the variant of the network from the backlog and the latency. Its
+   levels are the variants built, from the most accurate to the cheapest. */
+qos_t qos;
+const cnn_variant_t qosVariants[CNN_VARIANTS] = CNN_VARIANT_LEVELS;
+#define CM4_VARIANT     (qosVariants[qos.level])
 
-//Variable used to calculate delay for each CNN function
-uint32_t cnt_init = 0;
-uint32_t cnt_fin = 0; 
-uint32_t scale = 0;
-uint32_t t_initial = 0;
-uint32_t t_final = 0;
-uint32_t total_time_nano = 0;
-uint32_t sup_time_nano = 0;
-char buffer[50];
+ipc_stats_result_t stats;                /* Answer to IPC_REQ_QUERY_STATS   */
+uint64_t latencySum = 0;                 /* Of the inferences, in us        */
 
 /*******************************************************************************
 * Function Name: SystickIsrHandler
@@ -46,29 +95,16 @@ void SystickIsrHandler(void)
 *            Prototype Functions
 *****************************************************************************/
 void CM4_MessageCallback(uint32_t *msg);
-void calculateDelay(uint32_t cnt_init, uint32_t cnt_fin, uint32_t scale);
-
-// include the input and weights
-static q7_t conv1_wt[CONV1_IM_CH * CONV1_KER_DIM * CONV1_KER_DIM * CONV1_OUT_CH] = CONV1_WT;
-static q7_t conv1_bias[CONV1_OUT_CH] = CONV1_BIAS;
-
-static q7_t conv2_wt[CONV2_IM_CH * CONV2_KER_DIM * CONV2_KER_DIM * CONV2_OUT_CH] = CONV2_WT;
-static q7_t conv2_bias[CONV2_OUT_CH] = CONV2_BIAS;
+bool CM4_Accept(void);
+void CM4_FrameCopied(void *context);
+void CM4_Process(cm4_request_t *req, ipc_result_t *record);
+void CM4_Drop(const cm4_request_t *req, ipc_result_t *record);
+void CM4_AdaptQos(uint32_t latencyUs);
+void CM4_Doorbell(void *context);
 
-static q7_t conv3_wt[CONV3_IM_CH * CONV3_KER_DIM * CONV3_KER_DIM * CONV3_OUT_CH] = CONV3_WT;
-static q7_t conv3_bias[CONV3_OUT_CH] = CONV3_BIAS;
+cnn_result_t result;
+ipc_result_t record;
 
-static q7_t ip1_wt[IP1_DIM * IP1_OUT] = IP1_WT;
-static q7_t ip1_bias[IP1_OUT] = IP1_BIAS;
-
-/* Here the image_data should be the raw uint8 type RGB image in [RGB, RGB, RGB ... RGB] format */
-uint8_t   image_data[CONV1_IM_CH * CONV1_IM_DIM * CONV1_IM_DIM];
-q7_t      output_data[IP1_OUT];
-
-//vector buffer: max(im2col buffer,average pool buffer, fully connected buffer)
-q7_t      col_buffer[2 * 5 * 5 * 32 * 2];
-
-q7_t      scratch_buffer[32 * 32 * 10 * 4];
 
 int main(void)
 {
@@ -83,6 +119,9 @@ int main(void)
     // 16,777,215 / 8 MHz = 2.097 sec or 2097 msec for each systick interrupt
     
     uint32_t i;
+    uint32_t slot;
+    sched_pick_t pick;
+    
     for(i = 0u; i < CY_SYS_SYST_NUM_OF_CALLBACKS; ++i)
     {
         if(Cy_SysTick_GetCallback(i) == NULL)
@@ -93,202 +132,240 @@ int main(void)
     } 
     
 
+    /* Free-running cycle counter for the latency of the results */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    /* The scheduler keeps its time on the same counter */
+    SCHED_Init(&sched, SystemCoreClock / 1000000u);
+    QOS_Init(&qos, CNN_VARIANTS);
+    
+    /* Copies run on the DMA when a channel is configured, see copy_engine.h */
+#ifdef CE_DMA_HW
+    CE_Init(&copyEngine, &CE_DmaBackend, NULL);
+#else
+    CE_Init(&copyEngine, &CE_CpuBackend, NULL);
+#endif
+#ifdef CNN_WEIGHT_STREAM
+    CNN_SetCopyEngine(&copyEngine, NULL);
+#endif
+
+    /* Results go back through a ring, CM0+ polls it and the doorbell 
+    comes once per IPC_RESULT_BATCH results */
+    SPSC_Init(&resultRing, resultEntries, sizeof(resultEntries[0]), IPC_RING_SIZE);
+    SPSC_ProducerInit(&resultProducer, &resultRing, IPC_RESULT_BATCH, CM4_Doorbell, NULL);
+    ipcMsgForCM0.ring = &resultRing;
+    
     /* Register the Message Callback */
     Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_ADDR,
                                  CM4_MessageCallback,
                                  IPC_CM0_TO_CM4_CLIENT_ID);    
+    
+    /* Tell CM0+ where the results go, it sends no request before */
+    while (Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_ADDR,
+                                   CY_IPC_EP_CYPIPE_CM4_ADDR,
+                                   (uint32_t *) &ipcMsgForCM0, NULL) != CY_IPC_PIPE_SUCCESS)
+    {
+    }
 
     for(;;)
     {
-        /* Check if ready to process message */
-        if (rdyToProcess)
+        /* Retire the finished copies, which runs CM4_FrameCopied */
+        CE_Poll(&copyEngine);
+        
+        /* Take the requests queued by CM0+ while a slot is free */
+        while (CM4_Accept())
+        {
+        }
+        
+        /* Answer the most urgent request once its image arrived, or drop 
+        one that can no longer meet its deadline */
+        pick = SCHED_Next(&sched, DWT->CYCCNT, &slot);
+        if (pick != SCHED_NONE)
         {
-            /* Clear the flag */
-            rdyToProcess = false;
+            if (pick == SCHED_RUN)
+            {
+                CM4_Process(&requests[slot], &record);
+            }
+            else
+            {
+                CM4_Drop(&requests[slot], &record);
+            }
+            SCHED_Done(&sched, slot, DWT->CYCCNT);
             
-            /* Process only if pointer to image is not NULL */
-            if (ipcMsgFromCM0->ptrImgBuffer[0] != 0)
+            /* A slow or dropped frame switches to a cheaper variant */
+            if (record.type == IPC_REQ_INFER && record.status != IPC_STATUS_NO_IMAGE)
             {
-    
-                /* start the execution */
-                q7_t     *img_buffer1 = scratch_buffer;
-                q7_t     *img_buffer2 = img_buffer1 + 32 * 32 * 32;   
-    
-                Cy_SCB_UART_PutString(UART_HW, "Input Pre-processing\r\n");
-                /* input pre-processing */
-                int mean_data[3] = INPUT_MEAN_SHIFT;
-                unsigned int scale_data[3] = INPUT_RIGHT_SHIFT;
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                for (int i=0;i<32*32*3; i+=3) {
-                    img_buffer2[i] =   (q7_t)__SSAT( ((((int)image_data[i]   - mean_data[0])<<7) + (0x1<<(scale_data[0]-1)))
-                                             >> scale_data[0], 8);
-                    img_buffer2[i+1] = (q7_t)__SSAT( ((((int)image_data[i+1] - mean_data[1])<<7) + (0x1<<(scale_data[1]-1)))
-                                             >> scale_data[1], 8);
-                    img_buffer2[i+2] = (q7_t)__SSAT( ((((int)image_data[i+2] - mean_data[2])<<7) + (0x1<<(scale_data[2]-1)))
-                                             >> scale_data[2], 8);
-                }    
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Input Pre-processing completed\r\n\n\n");
-                
-                //*************************************************************************
-    
-                Cy_SCB_UART_PutString(UART_HW,"Performing first convolution RGB\r\n");
-                Cy_SCB_UART_PutString(UART_HW,"arm_convolve_HWC_q7_RGB()\r\n");
-                // conv1 img_buffer2 -> img_buffer1
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_convolve_HWC_q7_RGB(img_buffer2, CONV1_IM_DIM, CONV1_IM_CH, conv1_wt, CONV1_OUT_CH, CONV1_KER_DIM, CONV1_PADDING,
-                                        CONV1_STRIDE, conv1_bias, CONV1_BIAS_LSHIFT, CONV1_OUT_RSHIFT, img_buffer1, CONV1_OUT_DIM,
-                                        (q15_t *) col_buffer, NULL); 
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Convolution RGB completed\r\n\n\n");
-                
-                //*************************************************************************
-    
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                Cy_SCB_UART_PutString(UART_HW,"Performing first arm_relu_q7\r\n");
-                arm_relu_q7(img_buffer1, CONV1_OUT_DIM * CONV1_OUT_DIM * CONV1_OUT_CH);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"First arm_relu_q7 completed\r\n\n\n");
-                
-                //*************************************************************************
-                
-                Cy_SCB_UART_PutString(UART_HW,"Performing first arm_maxpool_q7_HWC\r\n");
-                // pool1 img_buffer1 -> img_buffer2
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_maxpool_q7_HWC(img_buffer1, CONV1_OUT_DIM, CONV1_OUT_CH, POOL1_KER_DIM,
-                                   POOL1_PADDING, POOL1_STRIDE, POOL1_OUT_DIM, NULL, img_buffer2);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"First arm_maxpool_q7_HWC completed\r\n\n\n");
-                
-                //*************************************************************************
-                
-                Cy_SCB_UART_PutString(UART_HW,"Performing second convolution\r\n");
-                Cy_SCB_UART_PutString(UART_HW,"arm_convolve_HWC_q7_fast()\r\n");
-                // conv2 img_buffer2 -> img_buffer1  
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_convolve_HWC_q7_fast(img_buffer2, CONV2_IM_DIM, CONV2_IM_CH, conv2_wt, CONV2_OUT_CH, CONV2_KER_DIM,
-                                         CONV2_PADDING, CONV2_STRIDE, conv2_bias, CONV2_BIAS_LSHIFT, CONV2_OUT_RSHIFT, img_buffer1,
-                                         CONV2_OUT_DIM, (q15_t *) col_buffer, NULL);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Second convolution completed\r\n\n\n");
-
-                //*************************************************************************
-                
-                Cy_SCB_UART_PutString(UART_HW,"Performing second arm_relu_q7\r\n");
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_relu_q7(img_buffer1, CONV2_OUT_DIM * CONV2_OUT_DIM * CONV2_OUT_CH);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Second arm_relu_q7 completed\r\n\n\n");
-
-                //*************************************************************************
-                
-                Cy_SCB_UART_PutString(UART_HW,"Performing second arm_maxpool_q7_HWC\r\n");
-                // pool2 img_buffer1 -> img_buffer2
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_maxpool_q7_HWC(img_buffer1, CONV2_OUT_DIM, CONV2_OUT_CH, POOL2_KER_DIM,
-                                   POOL2_PADDING, POOL2_STRIDE, POOL2_OUT_DIM, col_buffer, img_buffer2);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Second arm_maxpool_q7_HWC completed\r\n\n\n");
-                
-                //*************************************************************************
-
-                Cy_SCB_UART_PutString(UART_HW,"Performing third convolution\r\n");
-                printf("arm_convolve_HWC_q7_fast()\r\n");
-                // conv3 img_buffer2 -> img_buffer1
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_convolve_HWC_q7_fast(img_buffer2, CONV3_IM_DIM, CONV3_IM_CH, conv3_wt, CONV3_OUT_CH, CONV3_KER_DIM,
-                                         CONV3_PADDING, CONV3_STRIDE, conv3_bias, CONV3_BIAS_LSHIFT, CONV3_OUT_RSHIFT, img_buffer1,
-                                         CONV3_OUT_DIM, (q15_t *) col_buffer, NULL);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Third convolution completed\r\n\n\n");
-
-                //*************************************************************************
-                
-                Cy_SCB_UART_PutString(UART_HW,"\nPerforming third arm_relu_q7\r\n");
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_relu_q7(img_buffer1, CONV3_OUT_DIM * CONV3_OUT_DIM * CONV3_OUT_CH);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Third arm_relu_q7 completed\r\n\n\n");
-
-                //*************************************************************************
-                
-                Cy_SCB_UART_PutString(UART_HW,"Performing third arm_maxpool_q7_HWC\r\n");
-                // pool3 img_buffer-> img_buffer2
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_maxpool_q7_HWC(img_buffer1, CONV3_OUT_DIM, CONV3_OUT_CH, POOL3_KER_DIM,
-                                   POOL3_PADDING, POOL3_STRIDE, POOL3_OUT_DIM, col_buffer, img_buffer2);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"Third arm_maxpool_q7_HWC completed\r\n\n\n");
-                
-                //*************************************************************************
-                
-                Cy_SCB_UART_PutString(UART_HW,"\nPerforming arm_fully_connected_q7_opt\r\n");
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_fully_connected_q7_opt(img_buffer2, ip1_wt, IP1_DIM, IP1_OUT, IP1_BIAS_LSHIFT, IP1_OUT_RSHIFT, ip1_bias,
-                                           output_data, (q15_t *) img_buffer1);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"arm_fully_connected_q7_opt completed\r\n\n\n");
+                CM4_AdaptQos(record.infer.latencyUs);
+            }
+            
+            /* CM0+ prints the result, the UART stays off this core. It 
+            holds at most IPC_WINDOW requests, so the ring has room */
+            (void) SPSC_Push(&resultProducer, &record);
+        }
+        else
+        {
+            /* Nothing else to do, ring the doorbell for the results so far */
+            SPSC_Flush(&resultProducer);
+        }
+        
+        if (SCHED_Held(&sched) == 0u)
+        {
+            /* No request left, sleep until CM0+ rings. The wake-up 
+            interrupt stays pending while masked, so a doorbell after the
+            check is not lost. */
+            SPSC_Flush(&resultProducer);
+            
+            uint32_t intr = Cy_SysLib_EnterCriticalSection();
+            if (requestRing == NULL || SPSC_Idle(requestRing))
+            {
+                __WFI();
+            }
+            Cy_SysLib_ExitCriticalSection(intr);
+        }
+    }
+}
 
-                //*************************************************************************
+/****************************************************************************
+* Function Name: CM4_Process()
+*****************************************************************************
+* Summary:
+*   Executes a request and fills its result.
+*
+****************************************************************************/
+void CM4_Process(cm4_request_t *req, ipc_result_t *record)
+{
+    memset(record, 0, sizeof(*record));
+    record->seq = req->seq;
+    record->type = req->type;
+    record->status = IPC_STATUS_OK;
+    
+    switch (req->type)
+    {
+        case IPC_REQ_INFER:
+            /* Process only if an image was received */
+            if (req->ptr == NULL)
+            {
+                record->status = IPC_STATUS_NO_IMAGE;
+                break;
+            }
+            
+            /* Run the CNN on the received image */
+        #if defined(CNN_MIXED)
+            cnn_exit_t exitPoint = CNN_RunMixed(req->image, &result);
+        #elif defined(CNN_INCREMENTAL)
+            cnn_exit_t exitPoint = CNN_RunIncremental(req->image, &result);
+        #else
+            cnn_exit_t exitPoint = CNN_Run(req->image, &result);
+        #endif
+            
+            record->infer.exitPoint = (exitPoint == CNN_EXIT_POOL2) ? IPC_RESULT_EXIT_EARLY : IPC_RESULT_EXIT_FULL;
+            record->infer.variant = CM4_VARIANT;
+            for (int i = 0; i < IPC_RESULT_TOPK; i++)
+            {
+                record->infer.cls[i] = (uint8_t) result.cls[i];
+                record->infer.margin[i] = result.margin[i];
+            }
+        #ifdef IPC_RESULT_SCORES
+            CNN_GetScores(record->infer.scores);
+        #endif
+            record->infer.latencyUs = (DWT->CYCCNT - req->start) / (SystemCoreClock / 1000000u);
+            
+            stats.inferences++;
+            stats.earlyExits += (exitPoint == CNN_EXIT_POOL2);
+            latencySum += record->infer.latencyUs;
+            stats.avgLatencyUs = (uint32_t) (latencySum / stats.inferences);
+            if (record->infer.latencyUs > stats.maxLatencyUs)
+            {
+                stats.maxLatencyUs = record->infer.latencyUs;
+            }
+            break;
+            
+        case IPC_REQ_LOAD_MODEL:
+            /* Only CNN_Run streams its weights, the other run paths above
+            keep the built-in ones and cannot load a model */
+        #if defined(CNN_WEIGHT_STREAM) && !defined(CNN_MIXED) && !defined(CNN_INCREMENTAL)
+            /* ptrImgBuffer holds the conv2 and conv3 weights laid out as the
+            CNN_WS_ offsets tell, NULL goes back to the built-in weights */
+            CNN_SetCopyEngine(&copyEngine, req->ptr);
+        #else
+            record->status = IPC_STATUS_UNSUPPORTED;
+        #endif
+            break;
+            
+        case IPC_REQ_QUERY_STATS:
+            stats.deadlines = sched.stats.scheduled;
+            stats.late = sched.stats.late;
+            stats.dropped = sched.stats.dropped;
+            stats.estimateUs = SCHED_EstimateUs(&sched, SCHED_MODEL_INFER + CM4_VARIANT);
+            stats.qosSwitches = qos.switches;
+            stats.variant = CM4_VARIANT;
+        #ifdef CNN_ZERO_STATS
+            {
+                uint32_t zeros[CNN_ZERO_LAYERS];
+                uint32_t groups[CNN_ZERO_LAYERS];
                 
-                Cy_SCB_UART_PutString(UART_HW,"\nPerforming arm_softmax_q7\r\n");
-                SysTickCnt = 0;
-                cnt_init = Cy_SysTick_GetValue();
-                arm_softmax_q7(output_data, 10, output_data);
-                cnt_fin = Cy_SysTick_GetValue();
-                scale = SysTickCnt;
-                calculateDelay(cnt_init, cnt_fin, scale);
-                Cy_SCB_UART_PutString(UART_HW,"arm_softmax_q7 completed\r\n\n\n");
-
-                for (int i = 0; i < 10; i++)
+                CNN_GetZeroGroups(zeros, groups);
+                for (int i = 0; i < CNN_ZERO_LAYERS; i++)
                 {
-                    printf("%d: %d\r\n", i, output_data[i]);
+                    stats.zeroGroups[i] = zeros[i];
+                    stats.groups[i] = groups[i];
                 }
-                
-                Cy_SCB_UART_PutString(UART_HW, "\r\n\n> ");
-            }
-            else
-            {
-                /* If no image received */
-                CyDelay(500);
-                Cy_SCB_UART_PutString(UART_HW, "\r\n\n\nERROR!\r\n\n");
-                Cy_SCB_UART_PutString(UART_HW, "> ");
             }
+        #endif
+            record->stats = stats;
+            break;
             
-        }
+        default:
+            record->status = IPC_STATUS_UNSUPPORTED;
+            break;
+    }
+}
+
+/****************************************************************************
+* Function Name: CM4_Drop()
+*****************************************************************************
+* Summary:
+*   Answers a request dropped by the scheduler, it would have finished past
+*   its deadline.
+*
+****************************************************************************/
+void CM4_Drop(const cm4_request_t *req, ipc_result_t *record)
+{
+    memset(record, 0, sizeof(*record));
+    record->seq = req->seq;
+    record->type = req->type;
+    record->status = IPC_STATUS_DEADLINE;
+    if (req->type == IPC_REQ_INFER)
+    {
+        record->infer.latencyUs = (DWT->CYCCNT - req->start) / (SystemCoreClock / 1000000u);
+    }
+}
+
+/****************************************************************************
+* Function Name: CM4_AdaptQos()
+*****************************************************************************
+* Summary:
+*   Feeds the latency of a frame and the requests still waiting to the QoS
+*   controller, and switches the variant of the network when it changes 
+*   the level. The requests held are then estimated for the new variant.
+*
+****************************************************************************/
+void CM4_AdaptQos(uint32_t latencyUs)
+{
+    uint8_t  level = qos.level;
+    uint32_t depth = SCHED_Held(&sched);
+    
+    if (requestRing != NULL)
+    {
+        depth += SPSC_Count(requestRing);
+    }
+    
+    if (QOS_Update(&qos, depth, latencyUs) != level)
+    {
+        CNN_SetVariant(CM4_VARIANT);
+        SCHED_SetModel(&sched, SCHED_MODEL_INFER + qosVariants[level], SCHED_MODEL_INFER + CM4_VARIANT);
     }
 }
 
@@ -296,9 +373,9 @@ int main(void)
 * Function Name: CM4_MessageCallback()
 *****************************************************************************
 * Summary:
-*   Callback function that is executed when a message is received from 
-*   CM0+. Copy the message to a local array, which is processed in the
-*   main loop.
+*   Callback function that is executed when CM0+ rings the doorbell. The 
+*   requests are taken from the ring in the main loop, the interrupt only 
+*   wakes it up. The first doorbell tells where the ring is.
 *
 * Parameters:
 *   msg: IPC message received
@@ -308,38 +385,87 @@ void CM4_MessageCallback(uint32_t *msg)
 {    
     if (msg != NULL)
     {
-        /* Cast the message received to the IPC structure */
-        ipcMsgFromCM0 = (ipc_msg_t *) msg;
-        
-        /* Copy image data */
-        for (int i=0; i < 32*32*3; i++){
-            image_data[i] = ipcMsgFromCM0->ptrImgBuffer[i];
-        }
-                
-        /* Set flag to the main loop to process string */
-        rdyToProcess = true;
+        requestRing = ((ipc_msg_t *) msg)->ring;
     }
 }
 
-/*******************************************************************************
-* Function Name: calculateDelay
-*******************************************************************************/
-void calculateDelay(uint32_t cnt_init, uint32_t cnt_fin, uint32_t scale){
-    
-    t_initial = cnt_init * 125;    
+/****************************************************************************
+* Function Name: CM4_Accept()
+*****************************************************************************
+* Summary:
+*   Takes the next request from the ring if a slot is free, and starts 
+*   copying its image to the slot in the background. The scheduler picks it
+*   in the main loop once the copy completed.
+*
+* Return:
+*   false if no request was taken.
+*
+****************************************************************************/
+bool CM4_Accept(void)
+{
+    ipc_request_t msg;
+    cm4_request_t *req;
+    int32_t slot;
     
-    if(scale == 0)
+    if (requestRing == NULL || SCHED_Held(&sched) == SCHED_SLOTS ||
+        !SPSC_Pop(requestRing, &msg))
     {
-        t_final = cnt_fin * 125;
-        total_time_nano = t_initial - t_final; // units in nano sec
-        printf("Total time in nano seconds = %u \r\n", total_time_nano);
+        return false;
     }
-    else
+    stats.requests++;
+    
+    slot = SCHED_Add(&sched, (msg.type == IPC_REQ_INFER) ? SCHED_MODEL_INFER + CM4_VARIANT : SCHED_MODEL_CONTROL,
+                     msg.priority, msg.deadlineUs, DWT->CYCCNT);
+    req = &requests[slot];
+    req->seq = msg.seq;
+    req->type = msg.type;
+    req->arg = msg.arg;
+    req->ptr = msg.ptrImgBuffer;
+    req->start = sched.slot[slot].release;
+    
+    /* Copy image data, CM0+ keeps the image unchanged until the result
+    comes back */
+    if (req->type == IPC_REQ_INFER && req->ptr != NULL)
     {
-        t_final = (16777215 - cnt_fin) * 125;
-        sup_time_nano = t_initial + t_final; // need to add (2.097 sec * (scale - 1))
-        printf("Total time in nano seconds: 2.097[sec] * %u + %u[nano seconds]\r\n",
-              (scale - 1u), sup_time_nano);
-    }      
+        if (CE_Submit(&copyEngine, req->image, req->ptr, sizeof(req->image),
+                      CM4_FrameCopied, req) != 0u)
+        {
+            return true;
+        }
+        /* No room in the copy queue, report no image */
+        req->ptr = NULL;
+    }
+    SCHED_Ready(&sched, (uint32_t) slot);
+    return true;
+}
+
+/****************************************************************************
+* Function Name: CM4_FrameCopied()
+*****************************************************************************
+* Summary:
+*   Completion callback of the image copy, called from CE_Poll in the main
+*   loop. Hands the request to the scheduler.
+*
+****************************************************************************/
+void CM4_FrameCopied(void *context)
+{
+    SCHED_Ready(&sched, (uint32_t) ((cm4_request_t *) context - requests));
 }
+
+/****************************************************************************
+* Function Name: CM4_Doorbell()
+*****************************************************************************
+* Summary:
+*   Doorbell of the result ring. If the pipe is still busy with the last one
+*   CM0+ has not handled it yet and finds the new results as well.
+*
+****************************************************************************/
+void CM4_Doorbell(void *context)
+{
+    (void) context;
+    (void) Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_ADDR,
+                                   CY_IPC_EP_CYPIPE_CM4_ADDR,
+                                   (uint32_t *) &ipcMsgForCM0, NULL);
+}
+
 /* [] END OF FILE */
\ No newline at end of file
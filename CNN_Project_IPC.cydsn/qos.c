@@ -0,0 +1,72 @@
+/******************************************************************************
+* File Name		: qos.c
+* Version		: 1.0
+*
+* Description:
+*  Quality-of-service controller of CM4, see qos.h.
+*
+*******************************************************************************/
+#include "qos.h"
+
+/*******************************************************************************
+* Function Name: QOS_Init()
+********************************************************************************
+* Summary:
+*   Starts at level 0 with levels variants. A single level disables the
+*   controller.
+*
+*******************************************************************************/
+void QOS_Init(qos_t *qos, uint8_t levels)
+{
+    qos->level = 0u;
+    qos->levels = (levels != 0u) ? levels : 1u;
+    qos->calm = 0u;
+    qos->switches = 0u;
+}
+
+/*******************************************************************************
+* Function Name: QOS_Update()
+********************************************************************************
+* Summary:
+*   Takes the queue depth and the latency after a result and moves the
+*   level by at most one step.
+*
+* Return:
+*   The level for the next request.
+*
+*******************************************************************************/
+uint8_t QOS_Update(qos_t *qos, uint32_t depth, uint32_t latencyUs)
+{
+    if (depth >= QOS_DEPTH_HIGH || latencyUs >= QOS_LATENCY_HIGH_US)
+    {
+        /* Falling behind, go to a cheaper variant */
+        qos->calm = 0u;
+        if (qos->level + 1u < qos->levels)
+        {
+            qos->level++;
+            qos->switches++;
+        }
+    }
+    else if (depth <= QOS_DEPTH_LOW && latencyUs <= QOS_LATENCY_LOW_US)
+    {
+        /* Keeping up, go back up once it lasted */
+        if (qos->calm < QOS_CALM_RESULTS)
+        {
+            qos->calm++;
+        }
+        if (qos->calm == QOS_CALM_RESULTS && qos->level > 0u)
+        {
+            qos->level--;
+            qos->switches++;
+            qos->calm = 0u;
+        }
+    }
+    else
+    {
+        /* Between the thresholds, stay */
+        qos->calm = 0u;
+    }
+    return qos->level;
+}
+
+/* [] END OF FILE */
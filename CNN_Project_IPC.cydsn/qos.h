@@ -0,0 +1,49 @@
+/******************************************************************************
+* File Name		: qos.h
+* Version		: 1.0
+*
+* Description:
+*  Quality-of-service controller of CM4. It picks the level, from 0, the
+*  most accurate variant of the network, to levels - 1, the cheapest, from
+*  the requests waiting and the latency of the last result.
+*
+*  The level goes one step down as soon as the queue or the latency passes
+*  its high threshold. It only goes back up once both stayed below their
+*  low threshold for QOS_CALM_RESULTS results in a row, so it does not
+*  switch back and forth around a single threshold.
+*
+*  On CM4 the levels are the variants of CNN_VARIANT_LEVELS, at least the
+*  full network and the one with the strided conv2. qos_host.c drives it
+*  with the scheduler through an overload and the recovery.
+*
+*******************************************************************************/
+#ifndef QOS_H
+#define QOS_H
+
+    #include <stdint.h>
+
+    /* Requests waiting, held or still in the ring, after a result */
+    #define QOS_DEPTH_HIGH          3u
+    #define QOS_DEPTH_LOW           1u
+
+    /* Latency of a result, from reception to result on CM4 */
+    #define QOS_LATENCY_HIGH_US     400000u
+    #define QOS_LATENCY_LOW_US      200000u
+
+    /* Results in a row below both low thresholds to go a level back up */
+    #define QOS_CALM_RESULTS        8u
+
+    typedef struct
+    {
+        uint8_t     level;          /* Variant in use, 0 the most accurate  */
+        uint8_t     levels;         /* Variants available                   */
+        uint8_t     calm;           /* Results in a row below the lows      */
+        uint32_t    switches;       /* Level changes                        */
+    } qos_t;
+
+    void    QOS_Init(qos_t *qos, uint8_t levels);
+    uint8_t QOS_Update(qos_t *qos, uint32_t depth, uint32_t latencyUs);
+
+#endif /* QOS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,202 @@
+/******************************************************************************
+* File Name		: qos_host.c
+* Version		: 1.0
+*
+* Description:
+*  Overload and recovery test of the QoS controller with the scheduler on
+*  a PC, see qos_host.h. One inference request stays held in the
+*  scheduler, the requests still in the ring are only counted in the
+*  depth, as CM4_AdaptQos adds SPSC_Count of the request ring.
+*
+*******************************************************************************/
+#include "qos_host.h"
+#include <stdio.h>
+
+/* Latencies of the test, below the low, between, and above the high
+   threshold */
+#define QOS_HOST_FAST_US        (QOS_LATENCY_LOW_US / 2u)
+#define QOS_HOST_SLOW_US        ((QOS_LATENCY_LOW_US + QOS_LATENCY_HIGH_US) / 2u)
+#define QOS_HOST_LATE_US        (QOS_LATENCY_HIGH_US + QOS_LATENCY_LOW_US)
+
+typedef struct
+{
+    qos_t               qos;
+    sched_t             sched;
+    int32_t             slot;       /* The inference request held           */
+    const uint8_t      *models;     /* Scheduler model of each level        */
+    uint32_t            expectedSwitches;
+    qos_host_result_t  *result;
+} qos_host_test_t;
+
+/*******************************************************************************
+* Function Name: QOS_HostStep()
+********************************************************************************
+* Summary:
+*   Feeds one result to the controller like CM4_AdaptQos, with waiting
+*   requests in the ring besides the one held, and checks the level and the
+*   model of the request held against expected.
+*
+*******************************************************************************/
+static void QOS_HostStep(qos_host_test_t *test, uint32_t waiting, uint32_t latencyUs, uint8_t expected,
+                         const char *phase)
+{
+    uint8_t  level = test->qos.level;
+    uint32_t depth = SCHED_Held(&test->sched) + waiting;
+
+    if (QOS_Update(&test->qos, depth, latencyUs) != level)
+    {
+        SCHED_SetModel(&test->sched, test->models[level], test->models[test->qos.level]);
+        if (test->sched.slot[test->slot].model == test->models[test->qos.level])
+        {
+            test->result->moved++;
+        }
+    }
+    if (expected != level)
+    {
+        test->expectedSwitches++;
+    }
+    test->result->results++;
+
+    if (test->qos.level != expected || test->sched.slot[test->slot].model != test->models[expected])
+    {
+        if (test->result->errors++ == 0u)
+        {
+            printf("%s, result %lu: depth %lu latency %lu us, level %u model %u, expected level %u model %u\n",
+                   phase, (unsigned long) test->result->results, (unsigned long) depth,
+                   (unsigned long) latencyUs, test->qos.level, test->sched.slot[test->slot].model,
+                   expected, test->models[expected]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: QOS_HostRun()
+********************************************************************************
+* Summary:
+*   Runs the overload and the recovery with levels levels, level l running
+*   the inferences as scheduler model models[l].
+*
+* Return:
+*   true if the level and the model of the request held followed the
+*   controller at every result.
+*
+*******************************************************************************/
+bool QOS_HostRun(const uint8_t *models, uint8_t levels, qos_host_result_t *result)
+{
+    qos_host_test_t test;
+    uint8_t  top = levels - 1u;
+    uint8_t  level;
+    uint32_t i;
+
+    result->results = 0u;
+    result->switches = 0u;
+    result->moved = 0u;
+    result->errors = 0u;
+
+    test.models = models;
+    test.expectedSwitches = 0u;
+    test.result = result;
+    QOS_Init(&test.qos, levels);
+    SCHED_Init(&test.sched, 1u);
+    test.slot = SCHED_Add(&test.sched, models[0], 0u, 0u, 0u);
+
+    /* Keeping up, there is no level above 0 */
+    for (i = 0u; i < QOS_CALM_RESULTS + 1u; i++)
+    {
+        QOS_HostStep(&test, 0u, QOS_HOST_FAST_US, 0u, "calm");
+    }
+
+    /* Requests pile up, one step per result down to the cheapest variant */
+    for (i = 0u; i < levels + 1u; i++)
+    {
+        QOS_HostStep(&test, QOS_DEPTH_HIGH, QOS_HOST_SLOW_US, (i < top) ? i + 1u : top, "overload");
+    }
+
+    /* The latency alone keeps it there, and so does a result between the
+       thresholds */
+    QOS_HostStep(&test, 0u, QOS_HOST_LATE_US, top, "late");
+    QOS_HostStep(&test, QOS_DEPTH_LOW, QOS_HOST_FAST_US, top, "between");
+
+    /* One result short of QOS_CALM_RESULTS, then one between the thresholds
+       starts the count over */
+    for (i = 0u; i + 1u < QOS_CALM_RESULTS; i++)
+    {
+        QOS_HostStep(&test, 0u, QOS_HOST_FAST_US, top, "hysteresis");
+    }
+    QOS_HostStep(&test, 0u, QOS_HOST_SLOW_US, top, "hysteresis");
+
+    /* After the first step back up, a late result that comes one short of
+       the next step goes down again at once, and starts the count over */
+    if (levels > 1u)
+    {
+        for (i = 0u; i < QOS_CALM_RESULTS; i++)
+        {
+            QOS_HostStep(&test, 0u, QOS_HOST_FAST_US, (i + 1u < QOS_CALM_RESULTS) ? top : top - 1u, "step up");
+        }
+        for (i = 0u; i + 1u < QOS_CALM_RESULTS; i++)
+        {
+            QOS_HostStep(&test, 0u, QOS_HOST_FAST_US, top - 1u, "step up");
+        }
+        QOS_HostStep(&test, 0u, QOS_HOST_LATE_US, top, "relapse");
+    }
+
+    /* Recovery, one level per QOS_CALM_RESULTS calm results back to 0 */
+    for (level = top; level > 0u; level--)
+    {
+        for (i = 0u; i < QOS_CALM_RESULTS; i++)
+        {
+            QOS_HostStep(&test, 0u, QOS_HOST_FAST_US, (i + 1u < QOS_CALM_RESULTS) ? level : level - 1u, "recovery");
+        }
+    }
+    for (i = 0u; i < QOS_CALM_RESULTS + 1u; i++)
+    {
+        QOS_HostStep(&test, 0u, QOS_HOST_FAST_US, 0u, "recovered");
+    }
+
+    result->switches = test.qos.switches;
+    if (result->switches != test.expectedSwitches || result->moved != test.expectedSwitches)
+    {
+        printf("switches %lu, requests moved %lu, expected %lu\n", (unsigned long) result->switches,
+               (unsigned long) result->moved, (unsigned long) test.expectedSwitches);
+        result->errors++;
+    }
+    return result->errors == 0u;
+}
+
+#ifdef QOS_HOST_MAIN
+/*******************************************************************************
+* Function Name: main()
+********************************************************************************
+* Summary:
+*   Runs the test with the levels of CNN_VARIANT_LEVELS: the full network
+*   and the strided conv2, then with the early-exit head also the two exit
+*   variants in between. Model SCHED_MODEL_INFER + v runs variant v.
+*
+*******************************************************************************/
+int main(void)
+{
+    static const uint8_t dense[] = { SCHED_MODEL_INFER + 0u, SCHED_MODEL_INFER + 3u };
+    static const uint8_t exitHead[] = { SCHED_MODEL_INFER + 0u, SCHED_MODEL_INFER + 1u,
+                                        SCHED_MODEL_INFER + 2u, SCHED_MODEL_INFER + 3u };
+    static const struct
+    {
+        const uint8_t *models;
+        uint8_t        levels;
+    } runs[] = { { dense, 2u }, { exitHead, 4u } };
+    bool     ok = true;
+
+    for (uint32_t r = 0u; r < sizeof(runs) / sizeof(runs[0]); r++)
+    {
+        qos_host_result_t result;
+        bool     pass = QOS_HostRun(runs[r].models, runs[r].levels, &result);
+
+        printf("levels %u: %lu results, switches %lu, requests moved %lu, errors %lu %s\n", runs[r].levels,
+               (unsigned long) result.results, (unsigned long) result.switches, (unsigned long) result.moved,
+               (unsigned long) result.errors, pass ? "OK" : "FAILED");
+        ok = ok && pass;
+    }
+    return ok ? 0 : 1;
+}
+#endif
+
+/* [] END OF FILE */
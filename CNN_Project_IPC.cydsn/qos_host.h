@@ -0,0 +1,44 @@
+/******************************************************************************
+* File Name		: qos_host.h
+* Version		: 1.0
+*
+* Description:
+*  Host test of the QoS controller together with the scheduler, the way
+*  CM4_AdaptQos of main_cm4.c uses them: after each result the queue depth
+*  and the latency go to QOS_Update, and when the level changes the
+*  requests held are moved to the model of the new variant with
+*  SCHED_SetModel.
+*
+*  The test runs an overload, where the level must go one step down per
+*  result to the cheapest variant, a mixed phase between the thresholds,
+*  and the recovery, where the level must only go back up after
+*  QOS_CALM_RESULTS calm results in a row, one step at a time.
+*
+*  Only for builds on a PC, qos_host.c is not part of the PSoC Creator
+*  project. With QOS_HOST_MAIN it has a main that runs the test with the
+*  levels of CNN_VARIANT_LEVELS, with and without the early-exit head:
+*
+*    gcc -O2 -DQOS_HOST_MAIN qos.c infer_sched.c qos_host.c
+*
+*******************************************************************************/
+#ifndef QOS_HOST_H
+#define QOS_HOST_H
+
+    #include <stdint.h>
+    #include <stdbool.h>
+    #include "qos.h"
+    #include "infer_sched.h"
+
+    typedef struct
+    {
+        uint32_t    results;        /* QOS_Update calls                     */
+        uint32_t    switches;       /* Level changes                        */
+        uint32_t    moved;          /* Level changes that moved the request */
+        uint32_t    errors;         /* Checks that failed                   */
+    } qos_host_result_t;
+
+    bool QOS_HostRun(const uint8_t *models, uint8_t levels, qos_host_result_t *result);
+
+#endif /* QOS_HOST_H */
+
+/* [] END OF FILE */
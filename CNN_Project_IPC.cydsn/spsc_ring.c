@@ -0,0 +1,207 @@
+/******************************************************************************
+* File Name		: spsc_ring.c
+* Version		: 1.0
+*
+* Description:
+*  Lock-free single-producer single-consumer ring. The barriers order the
+*  entry accesses against the index updates: an entry is written before
+*  head publishes it and read before tail releases its slot.
+*
+*  The doorbell handshake follows the store-then-load pattern on both
+*  sides: the consumer counts a wait in waits and then checks head, the
+*  producer publishes head and then checks waits. With a barrier between
+*  the store and the load on each side, at least one of them sees the
+*  other's store, so an entry is never left in the ring while the consumer
+*  sleeps. The producer keeps the last wait it rang for, so a wait costs a
+*  single doorbell and waits stays written by the consumer only.
+*
+*******************************************************************************/
+#include "spsc_ring.h"
+#include "project.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: SPSC_Init()
+********************************************************************************
+* Summary:
+*   Sets up an empty ring over entries, size entries of entrySize bytes.
+*   The consumer starts out waiting, so the first push rings the doorbell.
+*
+* Return:
+*   false if size is not a power of two.
+*
+*******************************************************************************/
+bool SPSC_Init(spsc_ring_t *ring, void *entries, uint32_t entrySize, uint32_t size)
+{
+    if (size == 0u || (size & (size - 1u)) != 0u)
+    {
+        return false;
+    }
+
+    ring->head = 0u;
+    ring->tail = 0u;
+    ring->waits = 1u;
+    ring->mask = size - 1u;
+    ring->entrySize = entrySize;
+    ring->entries = (uint8_t *) entries;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: SPSC_ProducerInit()
+********************************************************************************
+* Summary:
+*   Sets up the producer side of a ring. doorbell is called with context
+*   once every batch entries, or right away once per wait of the consumer.
+*
+*******************************************************************************/
+void SPSC_ProducerInit(spsc_producer_t *producer, spsc_ring_t *ring, uint32_t batch,
+                       spsc_doorbell_t doorbell, void *context)
+{
+    producer->ring = ring;
+    producer->batch = (batch != 0u) ? batch : 1u;
+    producer->unsignalled = 0u;
+    producer->answered = 0u;
+    producer->doorbell = doorbell;
+    producer->context = context;
+    producer->pushed = 0u;
+    producer->bells = 0u;
+    producer->full = 0u;
+}
+
+/*******************************************************************************
+* Function Name: SPSC_Ring()
+********************************************************************************
+* Summary:
+*   Rings the doorbell for the entries pushed since the last time.
+*
+*******************************************************************************/
+static void SPSC_Ring(spsc_producer_t *producer)
+{
+    producer->unsignalled = 0u;
+    producer->bells++;
+    producer->doorbell(producer->context);
+}
+
+/*******************************************************************************
+* Function Name: SPSC_Push()
+********************************************************************************
+* Summary:
+*   Copies entry into the ring and publishes it.
+*
+* Return:
+*   false if the ring is full, nothing is pushed then.
+*
+*******************************************************************************/
+bool SPSC_Push(spsc_producer_t *producer, const void *entry)
+{
+    spsc_ring_t *ring = producer->ring;
+    uint32_t     head = ring->head;
+    uint32_t     waits;
+
+    if (head - ring->tail > ring->mask)
+    {
+        producer->full++;
+        return false;
+    }
+    /* the consumer has read the slot before it moved tail past it */
+    __DMB();
+
+    memcpy(ring->entries + (head & ring->mask) * ring->entrySize, entry, ring->entrySize);
+
+    /* the entry is visible before head publishes it */
+    __DMB();
+    ring->head = head + 1u;
+    producer->pushed++;
+    producer->unsignalled++;
+
+    /* head is visible before waits is read, see the file header */
+    __DMB();
+    waits = ring->waits;
+    if (waits != producer->answered || producer->unsignalled >= producer->batch)
+    {
+        producer->answered = waits;
+        SPSC_Ring(producer);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: SPSC_Flush()
+********************************************************************************
+* Summary:
+*   Rings the doorbell for the entries not signalled yet, e.g. before the
+*   producer goes idle.
+*
+*******************************************************************************/
+void SPSC_Flush(spsc_producer_t *producer)
+{
+    if (producer->unsignalled != 0u)
+    {
+        SPSC_Ring(producer);
+    }
+}
+
+/*******************************************************************************
+* Function Name: SPSC_Pop()
+********************************************************************************
+* Summary:
+*   Copies the oldest entry out of the ring and releases its slot.
+*
+* Return:
+*   false if the ring is empty.
+*
+*******************************************************************************/
+bool SPSC_Pop(spsc_ring_t *ring, void *entry)
+{
+    uint32_t tail = ring->tail;
+
+    if (tail == ring->head)
+    {
+        return false;
+    }
+    /* the entry is read after head published it */
+    __DMB();
+
+    memcpy(entry, ring->entries + (tail & ring->mask) * ring->entrySize, ring->entrySize);
+
+    /* the entry is read before its slot is released */
+    __DMB();
+    ring->tail = tail + 1u;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: SPSC_Idle()
+********************************************************************************
+* Summary:
+*   Announces that the consumer is about to wait for the doorbell, the next
+*   push rings it right away, once.
+*
+* Return:
+*   true if the ring is still empty and the consumer may wait, false if
+*   entries arrived meanwhile.
+*
+*******************************************************************************/
+bool SPSC_Idle(spsc_ring_t *ring)
+{
+    ring->waits++;
+
+    /* waits is visible before head is read, see the file header */
+    __DMB();
+    return ring->head == ring->tail;
+}
+
+/*******************************************************************************
+* Function Name: SPSC_Count()
+********************************************************************************
+* Summary:
+*   Returns the number of entries in the ring.
+*
+*******************************************************************************/
+uint32_t SPSC_Count(const spsc_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+/* [] END OF FILE */
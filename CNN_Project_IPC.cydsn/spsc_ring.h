@@ -0,0 +1,65 @@
+/******************************************************************************
+* File Name		: spsc_ring.h
+* Version		: 1.0
+*
+* Description:
+*  Single-producer single-consumer ring of fixed-size entries in memory
+*  shared by the two cores. The producer only writes head and the consumer
+*  only writes tail, so no lock is needed, only memory barriers.
+*
+*  The producer notifies the consumer through a doorbell, e.g. an IPC
+*  interrupt, once every batch entries, or right away when the consumer
+*  announced with SPSC_Idle that it is waiting for one. Each wait is
+*  answered by one doorbell, the pushes after it go by the batch again.
+*
+*******************************************************************************/
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+    #include <stdint.h>
+    #include <stdbool.h>
+
+    /* head and tail are kept on separate lines of this size, so the two
+       cores do not write to the same line */
+    #define SPSC_LINE               32u
+
+    typedef struct
+    {
+        volatile uint32_t head;     /* Entries pushed, by the producer      */
+        uint8_t     padHead[SPSC_LINE - 4u];
+        volatile uint32_t tail;     /* Entries popped, by the consumer      */
+        volatile uint32_t waits;    /* Waits announced by the consumer      */
+        uint8_t     padTail[SPSC_LINE - 8u];
+        uint32_t    mask;           /* Entries - 1, a power of two - 1      */
+        uint32_t    entrySize;
+        uint8_t    *entries;
+    } __attribute__((aligned(SPSC_LINE))) spsc_ring_t;
+
+    typedef void (*spsc_doorbell_t)(void *context);
+
+    /* Producer side, private to the producing core */
+    typedef struct
+    {
+        spsc_ring_t    *ring;
+        uint32_t        batch;      /* Entries per doorbell at most         */
+        uint32_t        unsignalled;/* Entries pushed since the last one    */
+        uint32_t        answered;   /* Last of ring->waits rung for         */
+        spsc_doorbell_t doorbell;
+        void           *context;
+        uint32_t        pushed;
+        uint32_t        bells;
+        uint32_t        full;       /* Pushes refused, ring full            */
+    } spsc_producer_t;
+
+    bool     SPSC_Init(spsc_ring_t *ring, void *entries, uint32_t entrySize, uint32_t size);
+    void     SPSC_ProducerInit(spsc_producer_t *producer, spsc_ring_t *ring, uint32_t batch,
+                               spsc_doorbell_t doorbell, void *context);
+    bool     SPSC_Push(spsc_producer_t *producer, const void *entry);
+    void     SPSC_Flush(spsc_producer_t *producer);
+    bool     SPSC_Pop(spsc_ring_t *ring, void *entry);
+    bool     SPSC_Idle(spsc_ring_t *ring);
+    uint32_t SPSC_Count(const spsc_ring_t *ring);
+
+#endif /* SPSC_RING_H */
+
+/* [] END OF FILE */
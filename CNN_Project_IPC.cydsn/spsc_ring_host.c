@@ -0,0 +1,273 @@
+/******************************************************************************
+* File Name		: spsc_ring_host.c
+* Version		: 1.0
+*
+* Description:
+*  Two-thread stress test of spsc_ring on a PC, see spsc_ring_host.h. The
+*  doorbell is a condition variable, the consumer waits on it after
+*  SPSC_Idle like CM4 waits for the IPC interrupt after going to sleep.
+*
+*******************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "spsc_ring_host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+/* Entry of the test, the size of an ipc_request_t */
+typedef struct
+{
+    uint32_t    seq;
+    uint32_t    check[3];           /* Derived from seq                     */
+} spsc_host_entry_t;
+
+typedef struct
+{
+    spsc_ring_t         ring;
+    spsc_producer_t     producer;
+    spsc_host_entry_t   entries[SPSC_HOST_MAX_SIZE];
+    const spsc_host_config_t *config;
+    spsc_host_result_t *result;
+    uint8_t            *seen;       /* One bit per entry number             */
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;
+    uint32_t            bells;      /* Doorbells rung, under lock           */
+    bool                finished;   /* Producer done, under lock            */
+    volatile bool       broken;     /* Consumer gave up, tail passed head   */
+} spsc_host_test_t;
+
+/*******************************************************************************
+* Function Name: SPSC_HostFill()
+********************************************************************************
+* Summary:
+*   Fills the payload of entry number seq.
+*
+*******************************************************************************/
+static void SPSC_HostFill(spsc_host_entry_t *entry, uint32_t seq)
+{
+    entry->seq = seq;
+    entry->check[0] = ~seq;
+    entry->check[1] = seq * 2654435761u;
+    entry->check[2] = seq ^ 0xA5A5A5A5u;
+}
+
+/*******************************************************************************
+* Function Name: SPSC_HostDoorbell()
+********************************************************************************
+* Summary:
+*   Doorbell of the producer, wakes the consumer.
+*
+*******************************************************************************/
+static void SPSC_HostDoorbell(void *context)
+{
+    spsc_host_test_t *test = (spsc_host_test_t *) context;
+
+    pthread_mutex_lock(&test->lock);
+    test->bells++;
+    pthread_cond_signal(&test->cond);
+    pthread_mutex_unlock(&test->lock);
+}
+
+/*******************************************************************************
+* Function Name: SPSC_HostConsumer()
+********************************************************************************
+* Summary:
+*   Pops and checks the entries until the producer is done and the ring is
+*   empty, and waits for the doorbell whenever the ring runs empty before.
+*
+*******************************************************************************/
+static void *SPSC_HostConsumer(void *arg)
+{
+    spsc_host_test_t   *test = (spsc_host_test_t *) arg;
+    spsc_host_result_t *result = test->result;
+    spsc_host_entry_t   entry;
+    spsc_host_entry_t   expected;
+    uint32_t            next = 0u;
+    uint32_t            bells = 0u;
+
+    for (;;)
+    {
+        if (SPSC_Pop(&test->ring, &entry))
+        {
+            result->received++;
+            if (result->received > test->config->messages + test->config->size)
+            {
+                /* More entries than were ever pushed */
+                test->broken = true;
+                break;
+            }
+            if (entry.seq != next)
+            {
+                result->outOfOrder++;
+            }
+            next = entry.seq + 1u;
+
+            SPSC_HostFill(&expected, entry.seq);
+            if (entry.seq >= test->config->messages ||
+                memcmp(&entry, &expected, sizeof(entry)) != 0)
+            {
+                result->corrupted++;
+                continue;
+            }
+            if (test->seen[entry.seq >> 3] & (1u << (entry.seq & 7u)))
+            {
+                result->duplicated++;
+            }
+            test->seen[entry.seq >> 3] |= (uint8_t) (1u << (entry.seq & 7u));
+            continue;
+        }
+
+        result->idles++;
+        if (!SPSC_Idle(&test->ring))
+        {
+            continue;
+        }
+        pthread_mutex_lock(&test->lock);
+        while (test->bells == bells && !test->finished)
+        {
+            pthread_cond_wait(&test->cond, &test->lock);
+        }
+        bells = test->bells;
+        pthread_mutex_unlock(&test->lock);
+        result->sleeps++;
+
+        /* The producer is done once it flushed, anything left was lost */
+        if (test->finished && SPSC_Count(&test->ring) == 0u)
+        {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: SPSC_HostStress()
+********************************************************************************
+* Summary:
+*   Sends config->messages entries from this thread to a consumer thread
+*   through a ring of config->size entries and checks them.
+*
+* Return:
+*   true if every entry arrived once, in order and intact, with at most a
+*   doorbell per batch entries and per wait of the consumer, plus the one
+*   of the initial wait and the one of the final flush.
+*
+*******************************************************************************/
+bool SPSC_HostStress(const spsc_host_config_t *config, spsc_host_result_t *result)
+{
+    spsc_host_test_t *test = calloc(1, sizeof(*test));
+    pthread_t         consumer;
+    struct timespec   t0, t1;
+    bool              ok;
+
+    memset(result, 0, sizeof(*result));
+    if (test == NULL || config->size > SPSC_HOST_MAX_SIZE ||
+        !SPSC_Init(&test->ring, test->entries, sizeof(spsc_host_entry_t), config->size))
+    {
+        free(test);
+        return false;
+    }
+    test->seen = calloc((config->messages + 7u) / 8u, 1u);
+    if (test->seen == NULL)
+    {
+        free(test);
+        return false;
+    }
+    test->config = config;
+    test->result = result;
+    pthread_mutex_init(&test->lock, NULL);
+    pthread_cond_init(&test->cond, NULL);
+
+    /* Start near the wrap of the counters, the ring is empty either way */
+    test->ring.head = config->start;
+    test->ring.tail = config->start;
+    SPSC_ProducerInit(&test->producer, &test->ring, config->batch, SPSC_HostDoorbell, test);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pthread_create(&consumer, NULL, SPSC_HostConsumer, test);
+
+    for (uint32_t seq = 0u; seq < config->messages; seq++)
+    {
+        spsc_host_entry_t entry;
+
+        SPSC_HostFill(&entry, seq);
+        while (!SPSC_Push(&test->producer, &entry) && !test->broken)
+        {
+            /* Full, let the consumer run on a single CPU */
+            sched_yield();
+        }
+    }
+    SPSC_Flush(&test->producer);
+
+    pthread_mutex_lock(&test->lock);
+    test->finished = true;
+    pthread_cond_signal(&test->cond);
+    pthread_mutex_unlock(&test->lock);
+    pthread_join(consumer, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    for (uint32_t seq = 0u; seq < config->messages; seq++)
+    {
+        result->lost += !(test->seen[seq >> 3] & (1u << (seq & 7u)));
+    }
+    result->bells = test->producer.bells;
+    result->full = test->producer.full;
+    result->seconds = (double) (t1.tv_sec - t0.tv_sec) + (double) (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    result->perSecond = (result->seconds > 0.0) ? result->received / result->seconds : 0.0;
+    ok = !test->broken && result->received == config->messages && result->outOfOrder == 0u &&
+         result->corrupted == 0u && result->duplicated == 0u && result->lost == 0u &&
+         result->bells <= config->messages / test->producer.batch + result->idles + 2u;
+
+    pthread_cond_destroy(&test->cond);
+    pthread_mutex_destroy(&test->lock);
+    free(test->seen);
+    free(test);
+    return ok;
+}
+
+#ifdef SPSC_HOST_MAIN
+/*******************************************************************************
+* Function Name: main()
+********************************************************************************
+* Summary:
+*   Runs the test with the ring of the IPC and a larger one, one doorbell
+*   per entry up to one per 32. With a batch above one, the ring runs full
+*   often enough that fewer than half of the entries may ring. An optional
+*   argument sets the number of entries of each run.
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    static const uint32_t sizes[] = { 8u, 64u };
+    static const uint32_t batches[] = { 1u, 4u, 32u };
+    uint32_t messages = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : 1000000u;
+    bool     ok = true;
+
+    for (uint32_t s = 0u; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        for (uint32_t b = 0u; b < sizeof(batches) / sizeof(batches[0]); b++)
+        {
+            spsc_host_config_t config = { messages, sizes[s], batches[b], 0u - messages / 2u };
+            spsc_host_result_t result;
+            bool     pass = SPSC_HostStress(&config, &result) &&
+                            (config.batch == 1u || result.bells < messages / 2u);
+
+            printf("size %2lu batch %2lu: %lu entries in %.2f s, %.2f M/s, "
+                   "order %lu, corrupt %lu, dup %lu, lost %lu, bells %lu, full %lu, idles %lu, sleeps %lu %s\n",
+                   (unsigned long) config.size, (unsigned long) config.batch,
+                   (unsigned long) result.received, result.seconds, result.perSecond / 1e6,
+                   (unsigned long) result.outOfOrder, (unsigned long) result.corrupted,
+                   (unsigned long) result.duplicated, (unsigned long) result.lost,
+                   (unsigned long) result.bells, (unsigned long) result.full,
+                   (unsigned long) result.idles, (unsigned long) result.sleeps, pass ? "OK" : "FAILED");
+            ok = ok && pass;
+        }
+    }
+    return ok ? 0 : 1;
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,59 @@
+/******************************************************************************
+* File Name		: spsc_ring_host.h
+* Version		: 1.0
+*
+* Description:
+*  Host stress test of spsc_ring: a producer thread pushes numbered entries
+*  through a ring to a consumer thread, which sleeps on the doorbell when
+*  the ring is empty, as CM4 does. Every entry is checked for its order,
+*  its payload, and for being lost or received twice, and the throughput
+*  is measured. The counters start just below their wrap, so the test
+*  also crosses the 32-bit wraparound of head and tail. A wait of the
+*  consumer may cost one doorbell, all other entries go by the batch.
+*
+*  Only for builds on a PC, spsc_ring_host.c is not part of the PSoC
+*  Creator project. It needs a project.h whose __DMB() is a full memory
+*  barrier, e.g. __atomic_thread_fence(__ATOMIC_SEQ_CST). With
+*  SPSC_HOST_MAIN it has a main that runs the test for a few batch sizes:
+*
+*    gcc -O2 -pthread -DSPSC_HOST_MAIN -I<stubs> spsc_ring.c spsc_ring_host.c
+*
+*******************************************************************************/
+#ifndef SPSC_RING_HOST_H
+#define SPSC_RING_HOST_H
+
+    #include <stdint.h>
+    #include <stdbool.h>
+    #include "spsc_ring.h"
+
+    /* Largest ring of the test */
+    #define SPSC_HOST_MAX_SIZE      1024u
+
+    typedef struct
+    {
+        uint32_t    messages;       /* Entries sent                         */
+        uint32_t    size;           /* Ring entries, a power of two         */
+        uint32_t    batch;          /* Entries per doorbell                 */
+        uint32_t    start;          /* Initial head and tail                */
+    } spsc_host_config_t;
+
+    typedef struct
+    {
+        uint32_t    received;       /* Entries popped                       */
+        uint32_t    outOfOrder;     /* Not the one after the previous one   */
+        uint32_t    corrupted;      /* Payload does not match the number    */
+        uint32_t    duplicated;     /* Received more than once              */
+        uint32_t    lost;           /* Never received                       */
+        uint32_t    bells;          /* Doorbells rung by the producer       */
+        uint32_t    full;           /* Pushes refused, ring full            */
+        uint32_t    idles;          /* SPSC_Idle calls of the consumer      */
+        uint32_t    sleeps;         /* Times the consumer waited            */
+        double      seconds;
+        double      perSecond;      /* Entries per second                   */
+    } spsc_host_result_t;
+
+    bool SPSC_HostStress(const spsc_host_config_t *config, spsc_host_result_t *result);
+
+#endif /* SPSC_RING_HOST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,171 @@
+/******************************************************************************
+* File Name		: weight_stream.c
+* Version		: 1.0 
+*
+* Description:
+*  Double-buffered weight streaming. While the caller computes on the block
+*  returned by WS_Acquire, the block requested with WS_Prefetch is read into
+*  the other buffer by the backend.
+*
+*  Typical use, for blocks 0..n-1:
+*
+*    WS_Prefetch(s, offset(0), size);
+*    for (i = 0; i < n; i++)
+*    {
+*        w = WS_Acquire(s);
+*        if (i + 1 < n) WS_Prefetch(s, offset(i + 1), size);
+*        compute(w);
+*    }
+*
+*******************************************************************************/
+#include "weight_stream.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: WS_Init()
+********************************************************************************
+* Summary:
+*   Sets up a stream over a backing store with two SRAM buffers of bufSize
+*   bytes, the largest block that can be streamed.
+*
+*******************************************************************************/
+void WS_Init(ws_stream_t *stream, const ws_backend_t *backend, void *store, 
+             void *buf0, void *buf1, uint32_t bufSize)
+{
+    stream->backend = backend;
+    stream->store = store;
+    stream->buf[0] = (uint8_t *) buf0;
+    stream->buf[1] = (uint8_t *) buf1;
+    stream->bufSize = bufSize;
+    stream->fill = 0;
+    stream->pending = false;
+    memset(&stream->stats, 0, sizeof(stream->stats));
+}
+
+/*******************************************************************************
+* Function Name: WS_Prefetch()
+********************************************************************************
+* Summary:
+*   Starts reading the next block in the background.
+*
+* Return:
+*   false if the block is larger than the buffers or the previous block was
+*   not acquired yet, nothing is read then.
+*
+*******************************************************************************/
+bool WS_Prefetch(ws_stream_t *stream, uint32_t offset, uint32_t size)
+{
+    if (stream->pending || size > stream->bufSize)
+    {
+        return false;
+    }
+    
+    stream->backend->start(stream->store, offset, stream->buf[stream->fill], size);
+    stream->pending = true;
+    stream->stats.bytes += size;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: WS_Acquire()
+********************************************************************************
+* Summary:
+*   Waits for the prefetched block and hands it out. The block stays valid 
+*   until the next call, the following WS_Prefetch uses the other buffer.
+*
+* Return:
+*   The block, or NULL when no block was prefetched.
+*
+*******************************************************************************/
+const void *WS_Acquire(ws_stream_t *stream)
+{
+    const uint8_t *block = stream->buf[stream->fill];
+    
+    if (!stream->pending)
+    {
+        return NULL;
+    }
+    
+    if (!stream->backend->done(stream->store))
+    {
+        stream->stats.stalls++;
+    }
+    stream->stats.stallUs += stream->backend->wait(stream->store);
+    stream->stats.blocks++;
+    
+    stream->pending = false;
+    stream->fill ^= 1u;
+    return block;
+}
+
+/*******************************************************************************
+* Function Name: WS_Flush()
+********************************************************************************
+* Summary:
+*   Drops a prefetched block that will not be used, e.g. when a run ends 
+*   early, once its read has completed.
+*
+*******************************************************************************/
+void WS_Flush(ws_stream_t *stream)
+{
+    if (stream->pending)
+    {
+        (void) stream->backend->wait(stream->store);
+        stream->pending = false;
+    }
+}
+
+/*******************************************************************************
+*            Memory-mapped backend
+*******************************************************************************/
+static void WS_MemStart(void *store, uint32_t offset, void *dst, uint32_t size)
+{
+    memcpy(dst, (const uint8_t *) store + offset, size);
+}
+
+static bool WS_MemDone(void *store)
+{
+    (void) store;
+    return true;
+}
+
+static uint32_t WS_MemWait(void *store)
+{
+    (void) store;
+    return 0u;
+}
+
+const ws_backend_t WS_MemBackend = { WS_MemStart, WS_MemDone, WS_MemWait };
+
+/*******************************************************************************
+*            Copy engine backend
+*******************************************************************************/
+static void WS_CopyStart(void *arg, uint32_t offset, void *dst, uint32_t size)
+{
+    ws_copy_store_t *store = (ws_copy_store_t *) arg;
+    
+    store->fence = CE_Submit(store->engine, dst, store->base + offset, size, NULL, NULL);
+    if (store->fence == 0u)
+    {
+        /* queue full or above CE_MAX_SIZE, fall back to the CPU */
+        memcpy(dst, store->base + offset, size);
+    }
+}
+
+static bool WS_CopyDone(void *arg)
+{
+    ws_copy_store_t *store = (ws_copy_store_t *) arg;
+    
+    return store->fence == 0u || CE_Done(store->engine, store->fence);
+}
+
+static uint32_t WS_CopyWait(void *arg)
+{
+    ws_copy_store_t *store = (ws_copy_store_t *) arg;
+    
+    return (store->fence == 0u) ? 0u : CE_Fence(store->engine, store->fence);
+}
+
+const ws_backend_t WS_CopyBackend = { WS_CopyStart, WS_CopyDone, WS_CopyWait };
+
+/* [] END OF FILE */
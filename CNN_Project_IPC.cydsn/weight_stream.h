@@ -0,0 +1,74 @@
+/******************************************************************************
+* File Name		: weight_stream.h
+* Version		: 1.0 
+*
+* Description:
+*  Streams the weights of the layers block by block from a slow backing 
+*  store, such as an external QSPI flash, through a double buffer in SRAM.
+*  The next block is read in the background while the current block is 
+*  used, the statistics tell how often the computation had to wait.
+*
+*******************************************************************************/
+#ifndef WEIGHT_STREAM_H
+#define WEIGHT_STREAM_H	
+    
+    #include <stdint.h>
+    #include <stdbool.h>
+    #include "copy_engine.h"
+    
+    /* Asynchronous block reads from a backing store. Only one read is 
+       outstanding at a time. */
+    typedef struct
+    {
+        /* Starts reading size bytes at offset of the store into dst */
+        void     (*start)(void *store, uint32_t offset, void *dst, uint32_t size);
+        /* Returns true once the last read started has completed */
+        bool     (*done)(void *store);
+        /* Waits for the last read, returns the time waited in microseconds */
+        uint32_t (*wait)(void *store);
+    } ws_backend_t;
+    
+    typedef struct
+    {
+        uint32_t    blocks;         /* Blocks handed out by WS_Acquire      */
+        uint32_t    stalls;         /* Blocks not read yet when acquired    */
+        uint32_t    stallUs;        /* Time spent waiting for them          */
+        uint32_t    bytes;          /* Bytes read from the store            */
+    } ws_stats_t;
+    
+    typedef struct
+    {
+        const ws_backend_t *backend;
+        void       *store;
+        uint8_t    *buf[2];
+        uint32_t    bufSize;
+        uint8_t     fill;           /* Buffer of the next block             */
+        bool        pending;        /* A read into buf[fill] was started    */
+        ws_stats_t  stats;
+    } ws_stream_t;
+    
+    void        WS_Init(ws_stream_t *stream, const ws_backend_t *backend, void *store, 
+                        void *buf0, void *buf1, uint32_t bufSize);
+    bool        WS_Prefetch(ws_stream_t *stream, uint32_t offset, uint32_t size);
+    const void *WS_Acquire(ws_stream_t *stream);
+    void        WS_Flush(ws_stream_t *stream);
+    
+    /* Memory-mapped store, e.g. the QSPI flash in XIP mode at 0x18000000 or
+       the internal flash. store is the base address and a read is a plain 
+       copy, completed when start returns. */
+    extern const ws_backend_t WS_MemBackend;
+    
+    /* Memory-mapped store read through a copy engine, so the reads overlap
+       with the computation. store is a ws_copy_store_t. */
+    typedef struct
+    {
+        ce_engine_t    *engine;
+        const uint8_t  *base;
+        ce_fence_t      fence;      /* Read in progress                     */
+    } ws_copy_store_t;
+    
+    extern const ws_backend_t WS_CopyBackend;
+    
+#endif /* WEIGHT_STREAM_H */
+
+/* [] END OF FILE */
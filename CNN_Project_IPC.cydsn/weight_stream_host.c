@@ -0,0 +1,159 @@
+/******************************************************************************
+* File Name		: weight_stream_host.c
+* Version		: 1.0 
+*
+* Description:
+*  File-backed weight store for running weight_stream on a PC. Reads are 
+*  served by a worker thread, so the overlap between reading the next block
+*  and computing on the current one, and the resulting stalls, can be 
+*  measured with the same WS_ statistics as on the target.
+*
+*******************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "weight_stream_host.h"
+#include <time.h>
+
+/*******************************************************************************
+* Function Name: WS_HostWorker()
+********************************************************************************
+* Summary:
+*   Serves the reads started by WS_HostStart one at a time.
+*
+*******************************************************************************/
+static void *WS_HostWorker(void *arg)
+{
+    ws_host_store_t *store = (ws_host_store_t *) arg;
+    
+    pthread_mutex_lock(&store->lock);
+    for (;;)
+    {
+        while (!store->busy && !store->quit)
+        {
+            pthread_cond_wait(&store->cond, &store->lock);
+        }
+        if (store->quit)
+        {
+            break;
+        }
+        pthread_mutex_unlock(&store->lock);
+        
+        if (fseek(store->file, (long) store->offset, SEEK_SET) != 0 ||
+            fread(store->dst, 1, store->size, store->file) != store->size)
+        {
+            perror("weight store");
+        }
+        if (store->usPerKb)
+        {
+            uint64_t        ns = (uint64_t) store->size * store->usPerKb * 1000u / 1024u;
+            struct timespec delay = { (time_t) (ns / 1000000000u), (long) (ns % 1000000000u) };
+            
+            nanosleep(&delay, NULL);
+        }
+        
+        pthread_mutex_lock(&store->lock);
+        store->busy = false;
+        pthread_cond_broadcast(&store->cond);
+    }
+    pthread_mutex_unlock(&store->lock);
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: WS_HostOpen()
+********************************************************************************
+* Summary:
+*   Opens the store file and starts its worker thread. usPerKb adds a read
+*   time per KB, 0 reads as fast as the file allows.
+*
+*******************************************************************************/
+bool WS_HostOpen(ws_host_store_t *store, const char *path, uint32_t usPerKb)
+{
+    store->file = fopen(path, "rb");
+    if (store->file == NULL)
+    {
+        return false;
+    }
+    store->usPerKb = usPerKb;
+    store->busy = false;
+    store->quit = false;
+    pthread_mutex_init(&store->lock, NULL);
+    pthread_cond_init(&store->cond, NULL);
+    if (pthread_create(&store->worker, NULL, WS_HostWorker, store) != 0)
+    {
+        fclose(store->file);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: WS_HostClose()
+********************************************************************************
+* Summary:
+*   Stops the worker once the read in progress is done and closes the file.
+*
+*******************************************************************************/
+void WS_HostClose(ws_host_store_t *store)
+{
+    pthread_mutex_lock(&store->lock);
+    while (store->busy)
+    {
+        pthread_cond_wait(&store->cond, &store->lock);
+    }
+    store->quit = true;
+    pthread_cond_broadcast(&store->cond);
+    pthread_mutex_unlock(&store->lock);
+    
+    pthread_join(store->worker, NULL);
+    pthread_cond_destroy(&store->cond);
+    pthread_mutex_destroy(&store->lock);
+    fclose(store->file);
+}
+
+/*******************************************************************************
+*            Backend
+*******************************************************************************/
+static void WS_HostStart(void *arg, uint32_t offset, void *dst, uint32_t size)
+{
+    ws_host_store_t *store = (ws_host_store_t *) arg;
+    
+    pthread_mutex_lock(&store->lock);
+    store->offset = offset;
+    store->dst = dst;
+    store->size = size;
+    store->busy = true;
+    pthread_cond_broadcast(&store->cond);
+    pthread_mutex_unlock(&store->lock);
+}
+
+static bool WS_HostDone(void *arg)
+{
+    ws_host_store_t *store = (ws_host_store_t *) arg;
+    bool done;
+    
+    pthread_mutex_lock(&store->lock);
+    done = !store->busy;
+    pthread_mutex_unlock(&store->lock);
+    return done;
+}
+
+static uint32_t WS_HostWait(void *arg)
+{
+    ws_host_store_t *store = (ws_host_store_t *) arg;
+    struct timespec t0, t1;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pthread_mutex_lock(&store->lock);
+    while (store->busy)
+    {
+        pthread_cond_wait(&store->cond, &store->lock);
+    }
+    pthread_mutex_unlock(&store->lock);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    
+    return (uint32_t) ((t1.tv_sec - t0.tv_sec) * 1000000 + (t1.tv_nsec - t0.tv_nsec) / 1000);
+}
+
+const ws_backend_t WS_HostBackend = { WS_HostStart, WS_HostDone, WS_HostWait };
+
+/* [] END OF FILE */
@@ -0,0 +1,40 @@
+/******************************************************************************
+* File Name		: weight_stream_host.h
+* Version		: 1.0 
+*
+* Description:
+*  Host stand-in for the external flash of weight_stream: the store is a 
+*  file read by a worker thread, with an optional delay per KB to model the
+*  flash throughput. Only for builds on a PC, weight_stream_host.c is not
+*  part of the PSoC Creator project.
+*
+*******************************************************************************/
+#ifndef WEIGHT_STREAM_HOST_H
+#define WEIGHT_STREAM_HOST_H	
+    
+    #include <stdio.h>
+    #include <pthread.h>
+    #include "weight_stream.h"
+    
+    typedef struct
+    {
+        FILE           *file;
+        uint32_t        usPerKb;    /* Added read time per KB               */
+        pthread_t       worker;
+        pthread_mutex_t lock;
+        pthread_cond_t  cond;
+        uint32_t        offset;     /* Read in progress                     */
+        uint32_t        size;
+        void           *dst;
+        bool            busy;
+        bool            quit;
+    } ws_host_store_t;
+    
+    bool WS_HostOpen(ws_host_store_t *store, const char *path, uint32_t usPerKb);
+    void WS_HostClose(ws_host_store_t *store);
+    
+    extern const ws_backend_t WS_HostBackend;
+    
+#endif /* WEIGHT_STREAM_HOST_H */
+
+/* [] END OF FILE */
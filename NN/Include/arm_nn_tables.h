@@ -36,11 +36,25 @@
 *
 */
 
-extern const q15_t sigmoidTable_q15[256];
-extern const q7_t sigmoidTable_q7[256];
+/**
+ * @brief storage of the unified activation tables
+ *
+ * By default the tables are const and stay in flash. Building with
+ * ARM_NN_TABLES_IN_SRAM drops the qualifier, so the startup code copies
+ * them to SRAM with the rest of the initialized data and the look-ups
+ * avoid the flash wait states.
+ */
+#if defined(ARM_NN_TABLES_IN_SRAM)
+#define ARM_NN_TABLE_CONST
+#else
+#define ARM_NN_TABLE_CONST const
+#endif
+
+extern ARM_NN_TABLE_CONST q15_t sigmoidTable_q15[256];
+extern ARM_NN_TABLE_CONST q7_t sigmoidTable_q7[256];
 
-extern const q7_t tanhTable_q7[256];
-extern const q15_t tanhTable_q15[256];
+extern ARM_NN_TABLE_CONST q7_t tanhTable_q7[256];
+extern ARM_NN_TABLE_CONST q15_t tanhTable_q15[256];
 
   /**
    * @brief 2-way tables for various activation functions
@@ -43,6 +43,8 @@
    * - Fully-connected Layer Functions
    * - Neural Network Pooling Functions
    * - Softmax Functions
+   * - Elementwise Functions
+   * - Recurrent Cell Functions
    * - Neural Network Support Functions
    *
    * The library has separate functions for operating on different weight and activation data
@@ -283,6 +285,172 @@ extern    "C"
                                         q15_t * bufferA, 
                                         q7_t * bufferB);
 
+  /**
+   * @brief Fast Q7 convolution function on strided tensors
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       in_pixel_stride   distance between two input pixels, at least ch_im_in
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       out_pixel_stride  distance between two output pixels, at least ch_im_out
+   * @param[in,out]   bufferA     pointer to buffer space for input 
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * Im_in and Im_out may point into a channel slice of a wider tensor,
+   * e.g. a branch of a concatenation. Same constraints as
+   * arm_convolve_HWC_q7_fast().
+   */
+
+    arm_status arm_convolve_HWC_q7_fast_ex(const q7_t * Im_in,
+                                           const uint16_t dim_im_in,
+                                           const uint16_t ch_im_in,
+                                           const uint16_t in_pixel_stride,
+                                           const q7_t * wt,
+                                           const uint16_t ch_im_out,
+                                           const uint16_t dim_kernel,
+                                           const uint16_t padding,
+                                           const uint16_t stride,
+                                           const q7_t * bias,
+                                           const uint16_t bias_shift,
+                                           const uint16_t out_shift,
+                                           q7_t * Im_out,
+                                           const uint16_t dim_im_out,
+                                           const uint16_t out_pixel_stride,
+                                           q15_t * bufferA,
+                                           q7_t * bufferB);
+
+  /**
+   * @brief Fast Q7 convolution function with fused activation
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * Same constraints as arm_convolve_HWC_q7_fast.
+   */
+
+    arm_status arm_convolve_HWC_q7_fast_act(const q7_t * Im_in,
+                                            const uint16_t dim_im_in,
+                                            const uint16_t ch_im_in,
+                                            const q7_t * wt,
+                                            const uint16_t ch_im_out,
+                                            const uint16_t dim_kernel,
+                                            const uint16_t padding,
+                                            const uint16_t stride,
+                                            const q7_t * bias,
+                                            const uint16_t bias_shift,
+                                            const uint16_t out_shift,
+                                            const arm_nn_act * act,
+                                            q7_t * Im_out,
+                                            const uint16_t dim_im_out,
+                                            q15_t * bufferA,
+                                            q7_t * bufferB);
+
+  /**
+   * @brief Q7 convolution function with fused activation that skips zero inputs
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * Same result and constraints as arm_convolve_HWC_q7_fast_act(), the
+   * all-zero groups of four input channels are skipped.
+   */
+
+    arm_status arm_convolve_HWC_q7_fast_zero_skip(const q7_t * Im_in,
+                                                  const uint16_t dim_im_in,
+                                                  const uint16_t ch_im_in,
+                                                  const q7_t * wt,
+                                                  const uint16_t ch_im_out,
+                                                  const uint16_t dim_kernel,
+                                                  const uint16_t padding,
+                                                  const uint16_t stride,
+                                                  const q7_t * bias,
+                                                  const uint16_t bias_shift,
+                                                  const uint16_t out_shift,
+                                                  const arm_nn_act * act,
+                                                  q7_t * Im_out,
+                                                  const uint16_t dim_im_out,
+                                                  q15_t * bufferA,
+                                                  q7_t * bufferB);
+
+  /**
+   * @brief Fast Q7 convolution function with fused activation and a bitmap tensor input
+   * @param[in]       Im_in       input tensor, written by a bitmap ReLU or pooling
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for the input row window
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * Same constraints as arm_convolve_HWC_q7_fast. bufferB holds dim_kernel
+   * dense input rows, dim_kernel*dim_im_in*ch_im_in.
+   */
+
+    arm_status arm_convolve_HWC_q7_fast_bitmap(const arm_nn_bitmap_q7 * Im_in,
+                                               const q7_t * wt,
+                                               const uint16_t ch_im_out,
+                                               const uint16_t dim_kernel,
+                                               const uint16_t padding,
+                                               const uint16_t stride,
+                                               const q7_t * bias,
+                                               const uint16_t bias_shift,
+                                               const uint16_t out_shift,
+                                               const arm_nn_act * act,
+                                               q7_t * Im_out,
+                                               const uint16_t dim_im_out,
+                                               q15_t * bufferA,
+                                               q7_t * bufferB);
+
   /**
    * @brief Fast Q7 convolution function (non-sqaure shape)
    * @param[in]       Im_in        pointer to input tensor
@@ -390,6 +558,59 @@ extern    "C"
                                                       q15_t * bufferA,
                                                       q7_t * bufferB);
 
+  /**
+   * @brief Fast Q7 version of 1x1 convolution (non-sqaure shape) on strided tensors
+   * @param[in]       Im_in        pointer to input tensor
+   * @param[in]       dim_im_in_x  input tensor dimention x
+   * @param[in]       dim_im_in_y  input tensor dimention y
+   * @param[in]       ch_im_in     number of input tensor channels
+   * @param[in]       in_pixel_stride   distance between two input pixels, at least ch_im_in
+   * @param[in]       wt           pointer to kernel weights
+   * @param[in]       ch_im_out    number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel_x filter kernel size x
+   * @param[in]       dim_kernel_y filter kernel size y
+   * @param[in]       padding_x    padding size x
+   * @param[in]       padding_y    padding size y
+   * @param[in]       stride_x     convolution stride x
+   * @param[in]       stride_y     convolution stride y
+   * @param[in]       bias         pointer to bias
+   * @param[in]       bias_shift   amount of left-shift for bias
+   * @param[in]       out_shift    amount of right-shift for output
+   * @param[in,out]   Im_out       pointer to output tensor
+   * @param[in]       dim_im_out_x output tensor dimension x
+   * @param[in]       dim_im_out_y output tensor dimension y
+   * @param[in]       out_pixel_stride  distance between two output pixels, at least ch_im_out
+   * @param[in,out]   bufferA      pointer to buffer space for input 
+   * @param[in,out]   bufferB      pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * Im_in and Im_out may point into a channel slice of a wider tensor.
+   * Same constraints as arm_convolve_1x1_HWC_q7_fast_nonsquare().
+   */
+    arm_status arm_convolve_1x1_HWC_q7_fast_nonsquare_ex(const q7_t * Im_in,
+                                                         const uint16_t dim_im_in_x,
+                                                         const uint16_t dim_im_in_y,
+                                                         const uint16_t ch_im_in,
+                                                         const uint16_t in_pixel_stride,
+                                                         const q7_t * wt,
+                                                         const uint16_t ch_im_out,
+                                                         const uint16_t dim_kernel_x,
+                                                         const uint16_t dim_kernel_y,
+                                                         const uint16_t padding_x,
+                                                         const uint16_t padding_y,
+                                                         const uint16_t stride_x,
+                                                         const uint16_t stride_y,
+                                                         const q7_t * bias,
+                                                         const uint16_t bias_shift,
+                                                         const uint16_t out_shift,
+                                                         q7_t * Im_out,
+                                                         const uint16_t dim_im_out_x,
+                                                         const uint16_t dim_im_out_y,
+                                                         const uint16_t out_pixel_stride,
+                                                         q15_t * bufferA,
+                                                         q7_t * bufferB);
+
   /**
    * @brief Q7 version of convolution for RGB image
    * @param[in]       Im_in       pointer to input tensor
@@ -431,6 +652,134 @@ extern    "C"
                                        q15_t * bufferA, 
                                        q7_t * bufferB);
 
+  /**
+   * @brief Q7 convolution function restricted to an output region
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       region      region of the output tensor to compute
+   * @param[in,out]   bufferA     pointer to buffer space for input 
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code> 
+   *
+   * Only the outputs inside region are written. The results are the
+   * same as arm_convolve_HWC_q7_basic, arm_convolve_HWC_q7_fast and
+   * arm_convolve_HWC_q7_RGB over that region.
+   */
+
+    arm_status arm_convolve_HWC_q7_region(const q7_t * Im_in,
+                                          const uint16_t dim_im_in,
+                                          const uint16_t ch_im_in,
+                                          const q7_t * wt,
+                                          const uint16_t ch_im_out,
+                                          const uint16_t dim_kernel,
+                                          const uint16_t padding,
+                                          const uint16_t stride,
+                                          const q7_t * bias,
+                                          const uint16_t bias_shift,
+                                          const uint16_t out_shift,
+                                          q7_t * Im_out,
+                                          const uint16_t dim_im_out,
+                                          const arm_nn_rect * region,
+                                          q15_t * bufferA,
+                                          q7_t * bufferB);
+
+  /**
+   * @brief Q7 convolution function with block-sparse weights
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to the non-zero weight blocks
+   * @param[in]       blk_idx     column index (in blocks of 4) of each non-zero block
+   * @param[in]       row_ptr     index of the first block of each filter, ch_im_out+1 entries
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input 
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * This function is the equivalent of arm_convolve_HWC_q7_basic for
+   * weights pruned in blocks of 4 input channels. ch_im_in must be a
+   * multiple of 4.
+   */
+
+    arm_status arm_convolve_HWC_q7_sparse(const q7_t * Im_in,
+                                          const uint16_t dim_im_in,
+                                          const uint16_t ch_im_in,
+                                          const q7_t * wt,
+                                          const uint16_t * blk_idx,
+                                          const uint16_t * row_ptr,
+                                          const uint16_t ch_im_out,
+                                          const uint16_t dim_kernel,
+                                          const uint16_t padding,
+                                          const uint16_t stride,
+                                          const q7_t * bias,
+                                          const uint16_t bias_shift,
+                                          const uint16_t out_shift,
+                                          q7_t * Im_out,
+                                          const uint16_t dim_im_out,
+                                          q15_t * bufferA,
+                                          q7_t * bufferB);
+
+  /**
+   * @brief Q7 convolution function with int4 packed weights
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to the packed int4 kernel weights
+   * @param[in]       wt_shift    left-shift from int4 to q7 of each filter
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input 
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * ch_im_in*dim_kernel*dim_kernel must be a multiple of 8.
+   */
+
+    arm_status arm_convolve_HWC_q7_int4(const q7_t * Im_in,
+                                        const uint16_t dim_im_in,
+                                        const uint16_t ch_im_in,
+                                        const q7_t * wt,
+                                        const uint8_t * wt_shift,
+                                        const uint16_t ch_im_out,
+                                        const uint16_t dim_kernel,
+                                        const uint16_t padding,
+                                        const uint16_t stride,
+                                        const q7_t * bias,
+                                        const uint16_t bias_shift,
+                                        const uint16_t out_shift,
+                                        q7_t * Im_out,
+                                        const uint16_t dim_im_out,
+                                        q15_t * bufferA,
+                                        q7_t * bufferB);
+
   /**
    * @brief Fast Q15 convolution function
    * @param[in]       Im_in       pointer to input tensor
@@ -536,6 +885,44 @@ extern    "C"
                               q15_t * bufferA, 
                               q7_t * bufferB);
 										 
+  /**
+   * @brief Mixed Q7-Q15 convolution function, q15 activations and q7 weights
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * Weights and bias are the same as for arm_convolve_HWC_q7_basic.
+   */
+
+    arm_status arm_convolve_HWC_mat_q7_im_q15(const q15_t * Im_in,
+                                              const uint16_t dim_im_in,
+                                              const uint16_t ch_im_in,
+                                              const q7_t * wt,
+                                              const uint16_t ch_im_out,
+                                              const uint16_t dim_kernel,
+                                              const uint16_t padding,
+                                              const uint16_t stride,
+                                              const q7_t * bias,
+                                              const uint16_t bias_shift,
+                                              const uint16_t out_shift,
+                                              q15_t * Im_out,
+                                              const uint16_t dim_im_out,
+                                              q15_t * bufferA,
+                                              q7_t * bufferB);
+
   /**
    * @brief Q7 depthwise separable convolution function
    * @param[in]       Im_in       pointer to input tensor
@@ -629,27 +1016,151 @@ extern    "C"
                                                              q15_t * bufferA,
                                                              q7_t * bufferB);
 
-
-/**
- * @defgroup FC Fully-connected Layer Functions
- *
- * Perform fully-connected layer
- *
- * Fully-connected layer is basically a matrix-vector multiplication
- * with bias. The matrix is the weights and the input/output vectors
- * are the activation values. Supported {weight, activation} precisions
- * include {8-bit, 8-bit}, {16-bit, 16-bit}, and {8-bit, 16-bit}.
- *
- * Here we have two types of kernel functions. The basic function
- * implements the function using regular GEMV approach. The opt functions
- * operates with weights in interleaved formats. 
- *
- */
-
   /**
-   * @brief Q7 basic fully-connected layer function
-   * @param[in]       pV          pointer to input vector
-   * @param[in]       pM          pointer to matrix weights
+   * @brief Q7 depthwise convolution function with channel multiplier
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_mult     channel multiplier
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * The output has ch_im_in*ch_mult channels, output channel
+   * i_ch*ch_mult + m is filter m of input channel i_ch.
+   */
+
+    arm_status arm_depthwise_separable_conv_HWC_q7_mult(const q7_t * Im_in,
+                                                        const uint16_t dim_im_in,
+                                                        const uint16_t ch_im_in,
+                                                        const q7_t * wt,
+                                                        const uint16_t ch_mult,
+                                                        const uint16_t dim_kernel,
+                                                        const uint16_t padding,
+                                                        const uint16_t stride,
+                                                        const q7_t * bias,
+                                                        const uint16_t bias_shift,
+                                                        const uint16_t out_shift,
+                                                        q7_t * Im_out,
+                                                        const uint16_t dim_im_out,
+                                                        q15_t * bufferA,
+                                                        q7_t * bufferB);
+
+  /**
+   * @brief Q7 3x3 depthwise convolution function
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * 3x3 kernel with ch_im_out equal to ch_im_in, no im2col buffer.
+   * Constraints:
+   *   ch_im_in is multiple of 4
+   *   stride is 1 or 2
+   */
+
+    arm_status arm_depthwise_separable_conv_HWC_q7_3x3(const q7_t * Im_in,
+                                                       const uint16_t dim_im_in,
+                                                       const uint16_t ch_im_in,
+                                                       const q7_t * wt,
+                                                       const uint16_t padding,
+                                                       const uint16_t stride,
+                                                       const q7_t * bias,
+                                                       const uint16_t bias_shift,
+                                                       const uint16_t out_shift,
+                                                       q7_t * Im_out,
+                                                       const uint16_t dim_im_out,
+                                                       q15_t * bufferA,
+                                                       q7_t * bufferB);
+
+  /**
+   * @brief Fused Q7 depthwise separable convolution block with ReLU
+   * @param[in]       Im_in          pointer to input tensor
+   * @param[in]       dim_im_in      input tensor dimention
+   * @param[in]       ch_im_in       number of input tensor channels
+   * @param[in]       dw_wt          pointer to depthwise kernel weights
+   * @param[in]       dim_kernel     depthwise filter kernel size
+   * @param[in]       padding        depthwise padding sizes
+   * @param[in]       stride         depthwise convolution stride
+   * @param[in]       dw_bias        pointer to depthwise bias
+   * @param[in]       dw_bias_shift  amount of left-shift for depthwise bias
+   * @param[in]       dw_out_shift   amount of right-shift for depthwise output
+   * @param[in]       pw_wt          pointer to pointwise kernel weights
+   * @param[in]       ch_im_out      number of pointwise filters, i.e., output tensor channels
+   * @param[in]       pw_bias        pointer to pointwise bias
+   * @param[in]       pw_bias_shift  amount of left-shift for pointwise bias
+   * @param[in]       pw_out_shift   amount of right-shift for pointwise output
+   * @param[in,out]   Im_out         pointer to output tensor
+   * @param[in]       dim_im_out     output tensor dimension
+   * @param[in,out]   bufferA        pointer to buffer space for the depthwise output row
+   * @param[in,out]   bufferB        pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * Depthwise convolution, ReLU, 1x1 convolution and ReLU without the
+   * intermediate tensor, only one row of it is kept in bufferA.
+   */
+
+    arm_status arm_depthwise_separable_block_HWC_q7(const q7_t * Im_in,
+                                                    const uint16_t dim_im_in,
+                                                    const uint16_t ch_im_in,
+                                                    const q7_t * dw_wt,
+                                                    const uint16_t dim_kernel,
+                                                    const uint16_t padding,
+                                                    const uint16_t stride,
+                                                    const q7_t * dw_bias,
+                                                    const uint16_t dw_bias_shift,
+                                                    const uint16_t dw_out_shift,
+                                                    const q7_t * pw_wt,
+                                                    const uint16_t ch_im_out,
+                                                    const q7_t * pw_bias,
+                                                    const uint16_t pw_bias_shift,
+                                                    const uint16_t pw_out_shift,
+                                                    q7_t * Im_out,
+                                                    const uint16_t dim_im_out,
+                                                    q15_t * bufferA,
+                                                    q7_t * bufferB);
+
+
+/**
+ * @defgroup FC Fully-connected Layer Functions
+ *
+ * Perform fully-connected layer
+ *
+ * Fully-connected layer is basically a matrix-vector multiplication
+ * with bias. The matrix is the weights and the input/output vectors
+ * are the activation values. Supported {weight, activation} precisions
+ * include {8-bit, 8-bit}, {16-bit, 16-bit}, and {8-bit, 16-bit}.
+ *
+ * Here we have two types of kernel functions. The basic function
+ * implements the function using regular GEMV approach. The opt functions
+ * operates with weights in interleaved formats. 
+ *
+ */
+
+  /**
+   * @brief Q7 basic fully-connected layer function
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to matrix weights
    * @param[in]       dim_vec     length of the vector
    * @param[in]       num_of_rows number of rows in weight matrix
    * @param[in]       bias_shift  amount of left-shift for bias
@@ -696,6 +1207,225 @@ extern    "C"
                                           q7_t * pOut, 
                                           q15_t * vec_buffer);
 
+  /**
+   * @brief Q7 opt fully-connected layer function with fused activation
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to matrix weights
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        pointer to bias
+   * @param[in]       act         activation applied before the saturation
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   */
+
+    arm_status arm_fully_connected_q7_opt_act(const q7_t * pV,
+                                              const q7_t * pM,
+                                              const uint16_t dim_vec,
+                                              const uint16_t num_of_rows,
+                                              const uint16_t bias_shift,
+                                              const uint16_t out_shift,
+                                              const q7_t * bias,
+                                              const arm_nn_act * act,
+                                              q7_t * pOut,
+                                              q15_t * vec_buffer);
+
+  /**
+   * @brief Q7 opt fully-connected layer function with Q31 output
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to matrix weights
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * The raw accumulators are written out, without output shift or saturation.
+   */
+
+    arm_status arm_fully_connected_q7_opt_q31(const q7_t * pV,
+                                              const q7_t * pM,
+                                              const uint16_t dim_vec,
+                                              const uint16_t num_of_rows,
+                                              const uint16_t bias_shift,
+                                              const q7_t * bias,
+                                              q31_t * pOut,
+                                              q15_t * vec_buffer);
+
+  /**
+   * @brief Q7 opt fully-connected layer function with Q31 output that skips zero inputs
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to matrix weights, in the arm_fully_connected_q7_opt() order
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       bias        pointer to bias
+   * @param[in]       max_nnz     largest number of non-zero inputs handled sparsely, at most dim_vec / 2
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * vec_buffer size: dim_vec
+   *
+   * Bit-exact with arm_fully_connected_q7_opt_q31(), which it falls back
+   * to when more than max_nnz inputs are non-zero.
+   */
+
+    arm_status arm_fully_connected_q7_opt_q31_zero_skip(const q7_t * pV,
+                                                        const q7_t * pM,
+                                                        const uint16_t dim_vec,
+                                                        const uint16_t num_of_rows,
+                                                        const uint16_t bias_shift,
+                                                        const q7_t * bias,
+                                                        const uint16_t max_nnz,
+                                                        q31_t * pOut,
+                                                        q15_t * vec_buffer);
+
+  /**
+   * @brief Q7 fully-connected layer function with block-sparse weights
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to the non-zero weight blocks
+   * @param[in]       blk_idx     column index (in blocks of 4) of each non-zero block
+   * @param[in]       row_ptr     index of the first block of each row, num_of_rows+1 entries
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   */
+
+    arm_status arm_fully_connected_q7_sparse(const q7_t * pV,
+                                             const q7_t * pM,
+                                             const uint16_t * blk_idx,
+                                             const uint16_t * row_ptr,
+                                             const uint16_t dim_vec,
+                                             const uint16_t num_of_rows,
+                                             const uint16_t bias_shift,
+                                             const uint16_t out_shift,
+                                             const q7_t * bias,
+                                             q7_t * pOut,
+                                             q15_t * vec_buffer);
+
+  /**
+   * @brief Q7 fully-connected layer function with block-sparse weights and Q31 output
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to the non-zero weight blocks
+   * @param[in]       blk_idx     column index (in blocks of 4) of each non-zero block
+   * @param[in]       row_ptr     index of the first block of each row, num_of_rows+1 entries
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   */
+
+    arm_status arm_fully_connected_q7_sparse_q31(const q7_t * pV,
+                                                 const q7_t * pM,
+                                                 const uint16_t * blk_idx,
+                                                 const uint16_t * row_ptr,
+                                                 const uint16_t dim_vec,
+                                                 const uint16_t num_of_rows,
+                                                 const uint16_t bias_shift,
+                                                 const q7_t * bias,
+                                                 q31_t * pOut,
+                                                 q15_t * vec_buffer);
+
+  /**
+   * @brief Q7 fully-connected layer function with int4 packed weights
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to the packed int4 matrix weights
+   * @param[in]       wt_shift    left-shift from int4 to q7 of each row
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   */
+
+    arm_status arm_fully_connected_q7_int4(const q7_t * pV,
+                                           const q7_t * pM,
+                                           const uint8_t * wt_shift,
+                                           const uint16_t dim_vec,
+                                           const uint16_t num_of_rows,
+                                           const uint16_t bias_shift,
+                                           const uint16_t out_shift,
+                                           const q7_t * bias,
+                                           q7_t * pOut,
+                                           q15_t * vec_buffer);
+
+  /**
+   * @brief Q7 fully-connected layer function with int4 packed weights and Q31 output
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to the packed int4 matrix weights
+   * @param[in]       wt_shift    left-shift from int4 to q7 of each row, at most 4
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   */
+
+    arm_status arm_fully_connected_q7_int4_q31(const q7_t * pV,
+                                               const q7_t * pM,
+                                               const uint8_t * wt_shift,
+                                               const uint16_t dim_vec,
+                                               const uint16_t num_of_rows,
+                                               const uint16_t bias_shift,
+                                               const q7_t * bias,
+                                               q31_t * pOut,
+                                               q15_t * vec_buffer);
+
+  /**
+   * @brief Q7 global average pooling followed by a basic fully-connected layer
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels, i.e., length of the vector
+   * @param[in]       pM          pointer to matrix weights
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   */
+
+    arm_status arm_fully_connected_q7_gap(const q7_t * Im_in,
+                                          const uint16_t dim_im_in,
+                                          const uint16_t ch_im_in,
+                                          const q7_t * pM,
+                                          const uint16_t num_of_rows,
+                                          const uint16_t bias_shift,
+                                          const uint16_t out_shift,
+                                          const q7_t * bias,
+                                          q7_t * pOut,
+                                          q15_t * vec_buffer);
+
   /**
    * @brief Q15 basic fully-connected layer function
    * @param[in]       pV          pointer to input vector
@@ -796,6 +1526,29 @@ extern    "C"
                                                       q15_t * pOut, 
                                                       q15_t * vec_buffer);
 
+  /**
+   * @brief Mixed Q15-Q7 opt fully-connected layer function with Q31 output
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to matrix weights
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   */
+
+    arm_status arm_fully_connected_mat_q7_vec_q15_opt_q31(const q15_t * pV,
+                                                          const q7_t * pM,
+                                                          const uint16_t dim_vec,
+                                                          const uint16_t num_of_rows,
+                                                          const uint16_t bias_shift,
+                                                          const q7_t * bias,
+                                                          q31_t * pOut,
+                                                          q15_t * vec_buffer);
+
 /**
  * @brief Matrix-Multiplication Kernels for Convolution
  *
@@ -852,6 +1605,260 @@ extern    "C"
                                                       const q7_t * bias, 
                                                       q7_t * pOut);
 
+  /**
+   * @brief Matrix-multiplication function for convolution with strided output
+   * @param[in]       pA          pointer to operand A
+   * @param[in]       pInBuffer   pointer to operand B, always conssists of 2 vectors
+   * @param[in]       ch_im_out   numRow of A
+   * @param[in]       numCol_A    numCol of A
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        the bias
+   * @param[in]       out_pixel_stride  distance between two output pixels, at least ch_im_out
+   * @param[in,out]   pOut        pointer to output
+   * @return     The function returns the incremented output pointer
+   */
+
+    q7_t     *arm_nn_mat_mult_kernel_q7_q15_reordered_ex(const q7_t * pA,
+                                                         const q15_t * pInBuffer,
+                                                         const uint16_t ch_im_out,
+                                                         const uint16_t numCol_A,
+                                                         const uint16_t bias_shift,
+                                                         const uint16_t out_shift,
+                                                         const q7_t * bias,
+                                                         const uint16_t out_pixel_stride,
+                                                         q7_t * pOut);
+
+  /**
+   * @brief Matrix-multiplication function for convolution with reordered columns and activation
+   * @param[in]       pA          pointer to operand A
+   * @param[in]       pInBuffer   pointer to operand B, always conssists of 2 vectors
+   * @param[in]       ch_im_out   numRow of A
+   * @param[in]       numCol_A    numCol of A
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        the bias
+   * @param[in]       act         activation applied before the saturation
+   * @param[in,out]   pOut        pointer to output
+   * @return     The function returns the incremented output pointer
+   */
+
+    q7_t     *arm_nn_mat_mult_kernel_q7_q15_reordered_act(const q7_t * pA,
+                                                          const q15_t * pInBuffer,
+                                                          const uint16_t ch_im_out,
+                                                          const uint16_t numCol_A,
+                                                          const uint16_t bias_shift,
+                                                          const uint16_t out_shift,
+                                                          const q7_t * bias,
+                                                          const arm_nn_act * act,
+                                                          q7_t * pOut);
+
+  /**
+   * @brief Matrix-multiplication function for convolution with block-sparse weights
+   * @param[in]       pA          pointer to the non-zero weight blocks
+   * @param[in]       blk_idx     column index (in blocks of 4) of each non-zero block
+   * @param[in]       row_ptr     index of the first block of each row, ch_im_out+1 entries
+   * @param[in]       pInBuffer   pointer to operand B, always conssists of 2 vectors
+   * @param[in]       ch_im_out   numRow of A
+   * @param[in]       numCol_A    numCol of A
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        the bias
+   * @param[in,out]   pOut        pointer to output
+   * @return     The function returns the incremented output pointer
+   */
+
+    q7_t     *arm_nn_mat_mult_kernel_q7_q15_sparse(const q7_t * pA,
+                                                   const uint16_t * blk_idx,
+                                                   const uint16_t * row_ptr,
+                                                   const q15_t * pInBuffer,
+                                                   const uint16_t ch_im_out,
+                                                   const uint16_t numCol_A,
+                                                   const uint16_t bias_shift,
+                                                   const uint16_t out_shift,
+                                                   const q7_t * bias,
+                                                   q7_t * pOut);
+
+  /**
+   * @brief Matrix-multiplication function for convolution with int4 packed weights
+   * @param[in]       pA          pointer to operand A, packed int4 weights
+   * @param[in]       wt_shift    left-shift from int4 to q7 of each row of A
+   * @param[in]       pInBuffer   pointer to operand B, always conssists of 2 vectors
+   * @param[in]       ch_im_out   numRow of A
+   * @param[in]       numCol_A    numCol of A
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        the bias
+   * @param[in,out]   pOut        pointer to output
+   * @return     The function returns the incremented output pointer
+   */
+
+    q7_t     *arm_nn_mat_mult_kernel_q7_q15_int4(const q7_t * pA,
+                                                 const uint8_t * wt_shift,
+                                                 const q15_t * pInBuffer,
+                                                 const uint16_t ch_im_out,
+                                                 const uint16_t numCol_A,
+                                                 const uint16_t bias_shift,
+                                                 const uint16_t out_shift,
+                                                 const q7_t * bias,
+                                                 q7_t * pOut);
+
+/**
+ * @defgroup Elementwise Elementwise Functions
+ *
+ * Perform elementwise add, subtract and multiply of two q7 tensors,
+ * e.g. the skip connection of a residual block. The second input can
+ * be broadcast along the channels, and an activation can be fused.
+ *
+ */
+
+  /**
+   * @brief Q7 elementwise addition with input shifts and channel broadcast
+   * @param[in]       in1         pointer to the first input tensor
+   * @param[in]       in2         pointer to the second input tensor, or to ch values if broadcast
+   * @param[in]       dim         number of pixels, i.e. height times width
+   * @param[in]       ch          number of channels
+   * @param[in]       broadcast   non-zero if in2 holds one value per channel for all pixels
+   * @param[in]       in1_shift   amount of left-shift for the first input, at most 14
+   * @param[in]       in2_shift   amount of left-shift for the second input, at most 14
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation, ARM_ACT_NONE for none
+   * @param[in,out]   out         pointer to output tensor, may be in1, or in2 without broadcast
+   * @return none.
+   */
+
+    void      arm_elementwise_add_q7(const q7_t * in1,
+                                     const q7_t * in2,
+                                     const uint16_t dim,
+                                     const uint16_t ch,
+                                     const uint16_t broadcast,
+                                     const uint16_t in1_shift,
+                                     const uint16_t in2_shift,
+                                     const uint16_t out_shift,
+                                     const arm_nn_act * act,
+                                     q7_t * out);
+
+  /**
+   * @brief Q7 elementwise subtraction with input shifts and channel broadcast
+   * @param[in]       in1         pointer to the first input tensor
+   * @param[in]       in2         pointer to the second input tensor, or to ch values if broadcast
+   * @param[in]       dim         number of pixels, i.e. height times width
+   * @param[in]       ch          number of channels
+   * @param[in]       broadcast   non-zero if in2 holds one value per channel for all pixels
+   * @param[in]       in1_shift   amount of left-shift for the first input, at most 14
+   * @param[in]       in2_shift   amount of left-shift for the second input, at most 14
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation, ARM_ACT_NONE for none
+   * @param[in,out]   out         pointer to output tensor, may be in1, or in2 without broadcast
+   * @return none.
+   */
+
+    void      arm_elementwise_sub_q7(const q7_t * in1,
+                                     const q7_t * in2,
+                                     const uint16_t dim,
+                                     const uint16_t ch,
+                                     const uint16_t broadcast,
+                                     const uint16_t in1_shift,
+                                     const uint16_t in2_shift,
+                                     const uint16_t out_shift,
+                                     const arm_nn_act * act,
+                                     q7_t * out);
+
+  /**
+   * @brief Q7 elementwise multiplication with channel broadcast
+   * @param[in]       in1         pointer to the first input tensor
+   * @param[in]       in2         pointer to the second input tensor, or to ch values if broadcast
+   * @param[in]       dim         number of pixels, i.e. height times width
+   * @param[in]       ch          number of channels
+   * @param[in]       broadcast   non-zero if in2 holds one value per channel for all pixels
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation, ARM_ACT_NONE for none
+   * @param[in,out]   out         pointer to output tensor, may be in1, or in2 without broadcast
+   * @return none.
+   */
+
+    void      arm_elementwise_mul_q7(const q7_t * in1,
+                                     const q7_t * in2,
+                                     const uint16_t dim,
+                                     const uint16_t ch,
+                                     const uint16_t broadcast,
+                                     const uint16_t out_shift,
+                                     const arm_nn_act * act,
+                                     q7_t * out);
+
+/**
+ * @defgroup Recurrent Recurrent Cell Functions
+ *
+ * Perform one time step of a recurrent cell. The gate products run on
+ * the mixed q7 weight, q15 activation fully-connected kernel and the
+ * state is updated in place.
+ *
+ */
+
+  /**
+   * @brief Mixed Q15-Q7 LSTM cell step
+   * @param[in]       x               pointer to input vector
+   * @param[in]       dim_x           length of the input vector
+   * @param[in]       dim_h           number of cells
+   * @param[in]       wt              pointer to the concatenated gate weights
+   * @param[in]       bias            pointer to the concatenated gate bias
+   * @param[in]       bias_shift      amount of left-shift for bias
+   * @param[in]       out_shift       amount of right-shift for the gate pre-activations
+   * @param[in]       gate_int_width  integer bits of the gate pre-activations, at most 3
+   * @param[in]       cell_int_width  integer bits of the cell state, at most 3
+   * @param[in,out]   h               pointer to hidden state, q0.15
+   * @param[in,out]   c               pointer to cell state
+   * @param[in,out]   bufferA         pointer to buffer space for the gates
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * bufferA size: dim_x + 5 * dim_h
+   */
+
+    arm_status arm_lstm_step_q15(const q15_t * x,
+                                 const uint16_t dim_x,
+                                 const uint16_t dim_h,
+                                 const q7_t * wt,
+                                 const q7_t * bias,
+                                 const uint16_t bias_shift,
+                                 const uint16_t out_shift,
+                                 const uint16_t gate_int_width,
+                                 const uint16_t cell_int_width,
+                                 q15_t * h,
+                                 q15_t * c,
+                                 q15_t * bufferA);
+
+  /**
+   * @brief Mixed Q15-Q7 GRU cell step
+   * @param[in]       x               pointer to input vector
+   * @param[in]       dim_x           length of the input vector
+   * @param[in]       dim_h           number of cells
+   * @param[in]       gate_wt         pointer to the concatenated update and reset gate weights
+   * @param[in]       gate_bias       pointer to the concatenated update and reset gate bias
+   * @param[in]       cand_wt         pointer to the candidate weights
+   * @param[in]       cand_bias       pointer to the candidate bias
+   * @param[in]       bias_shift      amount of left-shift for bias
+   * @param[in]       out_shift       amount of right-shift for the pre-activations
+   * @param[in]       gate_int_width  integer bits of the pre-activations, at most 3
+   * @param[in,out]   h               pointer to hidden state, q0.15
+   * @param[in,out]   bufferA         pointer to buffer space for the gates
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * bufferA size: dim_x + 4 * dim_h
+   */
+
+    arm_status arm_gru_step_q15(const q15_t * x,
+                                const uint16_t dim_x,
+                                const uint16_t dim_h,
+                                const q7_t * gate_wt,
+                                const q7_t * gate_bias,
+                                const q7_t * cand_wt,
+                                const q7_t * cand_bias,
+                                const uint16_t bias_shift,
+                                const uint16_t out_shift,
+                                const uint16_t gate_int_width,
+                                q15_t * h,
+                                q15_t * bufferA);
+
 #ifdef __cplusplus
 }
 #endif
@@ -893,6 +1900,31 @@ extern    "C"
 
     void      arm_relu_q15(q15_t * data, uint16_t size);
 
+  /**
+   * @brief Q7 RELU function restricted to a region of a HWC tensor
+   * @param[in,out]   data        pointer to input
+   * @param[in]       dim_im      tensor dimension
+   * @param[in]       ch_im       number of tensor channels
+   * @param[in]       region      region of the tensor to process
+   * @return none.
+   */
+
+    void      arm_relu_q7_region(q7_t * data,
+                                 const uint16_t dim_im,
+                                 const uint16_t ch_im,
+                                 const arm_nn_rect * region);
+
+  /**
+   * @brief Q7 RELU function with a bitmap tensor output
+   * @param[in,out]   data        pointer to input, a HWC tensor of out->dim x out->dim x out->ch
+   * @param[in,out]   out         bitmap tensor set up with arm_nn_bitmap_init_q7
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   */
+
+    arm_status arm_relu_q7_to_bitmap(q7_t * data,
+                                     arm_nn_bitmap_q7 * out);
+
   /**
    * @brief Q7 neural network activation function using direct table look-up
    * @param[in,out]   data        pointer to input
@@ -917,6 +1949,30 @@ extern    "C"
     void      arm_nn_activations_direct_q15(q15_t * data, uint16_t size, uint16_t int_width,
                                             arm_nn_activation_type type);
 
+  /**
+   * @brief Q7 neural network activation function using word-wide table look-up
+   * @param[in,out]   data        pointer to input
+   * @param[in]       size        number of elements
+   * @param[in]       int_width   bit-width of the integer part, assume to be smaller than 3
+   * @param[in]       type        type of activation functions
+   * @return none.
+   */
+
+    void      arm_nn_activations_fast_q7(q7_t * data, uint16_t size, uint16_t int_width,
+                                         arm_nn_activation_type type);
+
+  /**
+   * @brief Q15 neural network activation function using paired table look-up
+   * @param[in,out]   data        pointer to input
+   * @param[in]       size        number of elements
+   * @param[in]       int_width   bit-width of the integer part, assume to be smaller than 3
+   * @param[in]       type        type of activation functions
+   * @return none.
+   */
+
+    void      arm_nn_activations_fast_q15(q15_t * data, uint16_t size, uint16_t int_width,
+                                          arm_nn_activation_type type);
+
 /**
  * @defgroup Pooling Neural Network Pooling Functions
  *
@@ -949,6 +2005,115 @@ extern    "C"
                                  q7_t * bufferA, 
                                  q7_t * Im_out);
 
+  /**
+   * @brief Q7 max pooling function on strided tensors
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       in_pixel_stride   distance between two input pixels, at least ch_im_in
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       out_pixel_stride  distance between two output pixels, at least ch_im_in
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @return none.
+   *
+   * Im_in and Im_out may point into a channel slice of a wider tensor.
+   */
+
+    void      arm_maxpool_q7_HWC_ex(q7_t * Im_in,
+                                    const uint16_t dim_im_in,
+                                    const uint16_t ch_im_in,
+                                    const uint16_t in_pixel_stride,
+                                    const uint16_t dim_kernel,
+                                    const uint16_t padding,
+                                    const uint16_t stride,
+                                    const uint16_t dim_im_out,
+                                    const uint16_t out_pixel_stride,
+                                    q7_t * bufferA,
+                                    q7_t * Im_out);
+
+  /**
+   * @brief Q7 max pooling function restricted to an output region
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       region      region of the output tensor to compute
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @return none.
+   *
+   * The input tensor is not modified.
+   */
+
+    void      arm_maxpool_q7_HWC_region(const q7_t * Im_in,
+                                        const uint16_t dim_im_in,
+                                        const uint16_t ch_im_in,
+                                        const uint16_t dim_kernel,
+                                        const uint16_t padding,
+                                        const uint16_t stride,
+                                        const uint16_t dim_im_out,
+                                        const arm_nn_rect * region,
+                                        q7_t * Im_out);
+
+  /**
+   * @brief Q7 max pooling function with a bitmap tensor output
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for one output row
+   * @param[in,out]   Im_out      bitmap tensor set up with arm_nn_bitmap_init_q7
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * bufferA size: dim_im_out*ch_im_in. The input is left untouched.
+   */
+
+    arm_status arm_maxpool_q7_HWC_to_bitmap(const q7_t * Im_in,
+                                            const uint16_t dim_im_in,
+                                            const uint16_t ch_im_in,
+                                            const uint16_t dim_kernel,
+                                            const uint16_t padding,
+                                            const uint16_t stride,
+                                            const uint16_t dim_im_out,
+                                            q7_t * bufferA,
+                                            arm_nn_bitmap_q7 * Im_out);
+
+  /**
+   * @brief Q15 max pooling function
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @return none.
+   *
+   * The input tensor is not modified.
+   */
+
+    void      arm_maxpool_q15_HWC(const q15_t * Im_in,
+                                  const uint16_t dim_im_in,
+                                  const uint16_t ch_im_in,
+                                  const uint16_t dim_kernel,
+                                  const uint16_t padding,
+                                  const uint16_t stride,
+                                  const uint16_t dim_im_out,
+                                  q15_t * bufferA,
+                                  q15_t * Im_out);
+
   /**
    * @brief Q7 average pooling function
    * @param[in]       Im_in       pointer to input tensor
@@ -974,6 +2139,21 @@ extern    "C"
                                  q7_t * bufferA, 
                                  q7_t * Im_out);
 
+  /**
+   * @brief Q7 global average pooling function
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in,out]   Im_out      pointer to output vector
+   * @return none.
+   *
+   */
+
+    void      arm_global_avepool_q7_HWC(const q7_t * Im_in,
+                                        const uint16_t dim_im_in,
+                                        const uint16_t ch_im_in,
+                                        q7_t * Im_out);
+
 /**
  * @defgroup Softmax Softmax Functions
  *
@@ -1003,6 +2183,36 @@ extern    "C"
 
     void      arm_softmax_q15(const q15_t * vec_in, const uint16_t dim_vec, q15_t * p_out);
 
+  /**
+   * @brief Q7 softmax function on Q31 scores
+   * @param[in]       vec_in      pointer to input vector
+   * @param[in]       dim_vec     input vector dimention
+   * @param[in]       out_shift   amount of right-shift to bring the input to q7
+   * @param[out]      p_out       pointer to output vector
+   * @return none.
+   *
+   */
+
+    void      arm_softmax_q31_q7(const q31_t * vec_in, const uint16_t dim_vec, const uint16_t out_shift, q7_t * p_out);
+
+  /**
+   * @brief Top-k selection on Q31 scores
+   * @param[in]       vec_in      pointer to input vector
+   * @param[in]       dim_vec     input vector dimention
+   * @param[in]       k           number of indices to return, 0 < k <= dim_vec
+   * @param[out]      p_idx       pointer to the k indices, best first
+   * @param[out]      p_margin    pointer to the k margins, or NULL
+   * @return none.
+   *
+   * p_margin[i] is the score of p_idx[i] minus the score of the next best index.
+   */
+
+    void      arm_nn_topk_q31(const q31_t * vec_in,
+                              const uint16_t dim_vec,
+                              const uint16_t k,
+                              uint16_t * p_idx,
+                              q31_t * p_margin);
+
 #ifdef __cplusplus
 }
 #endif
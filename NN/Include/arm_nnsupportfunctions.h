@@ -64,6 +64,95 @@ typedef enum
              /**< Tanh activation function */
 } arm_nn_activation_type;
 
+/**
+ * @brief Struct for specifying a rectangular region of a HWC tensor
+ *
+ * The region covers columns [x0, x1) and rows [y0, y1). It is empty
+ * when x0 >= x1 or y0 >= y1.
+ */
+typedef struct
+{
+    int16_t   x0;
+            /**< first column */
+    int16_t   y0;
+            /**< first row */
+    int16_t   x1;
+            /**< one past the last column */
+    int16_t   y1;
+            /**< one past the last row */
+} arm_nn_rect;
+
+/**
+ * @brief Struct for dividing by a constant with a multiply and a shift
+ *
+ * See arm_nn_recip_init and arm_nn_div_recip.
+ */
+typedef struct
+{
+    uint32_t  mult;
+            /**< ceil(2^shift / n) */
+    uint16_t  shift;
+            /**< 31 + ceil(log2(n)) */
+} arm_nn_recip;
+
+/**
+ * @brief Activations that can be applied in the requantization of a layer
+ *
+ */
+typedef enum
+{
+    ARM_ACT_NONE = 0,
+                /**< Saturation only */
+    ARM_ACT_RELU = 1,
+                /**< max(x, 0) */
+    ARM_ACT_RELU6 = 2,
+                /**< min(max(x, 0), 6) */
+    ARM_ACT_LEAKY_RELU = 3,
+                /**< x, or alpha * x for x < 0 */
+    ARM_ACT_HARD_SIGMOID = 4,
+                /**< relu6(x + 3) / 6 */
+    ARM_ACT_HARD_SWISH = 5,
+                /**< x * relu6(x + 3) / 6 */
+} arm_nn_act_type;
+
+/**
+ * @brief Struct for specifying the activation of a layer
+ *
+ * See arm_nn_activate. The constants 3 and 6 of ReLU6, hard sigmoid and
+ * hard swish are taken in the Q format of the output.
+ */
+typedef struct
+{
+    arm_nn_act_type type;
+            /**< activation function */
+    uint16_t  frac;
+            /**< fractional bits of the output, 0..7 */
+    q15_t     alpha;
+            /**< negative slope of the leaky ReLU, q15 */
+} arm_nn_act;
+
+/**
+ * @brief Struct for a Q7 HWC tensor stored as a bitmap of its non-zero values
+ *
+ * Each row has one bit per element and its non-zero values packed in
+ * order from val + row_start[y]. See arm_nn_bitmap_init_q7.
+ */
+typedef struct
+{
+    uint16_t  dim;
+            /**< tensor dimension */
+    uint16_t  ch;
+            /**< number of channels */
+    uint32_t *bitmap;
+            /**< (dim * ch + 31) / 32 words per row */
+    uint32_t *row_start;
+            /**< dim + 1 offsets in val, the last one is the number of values */
+    q7_t     *val;
+            /**< packed non-zero values */
+    uint32_t  val_size;
+            /**< room in val */
+} arm_nn_bitmap_q7;
+
 /**
  * @defgroup nndata_convert Neural Network Data Conversion Functions
  *
@@ -93,6 +182,30 @@ void      arm_q7_to_q15_no_shift(const q7_t * pSrc, q15_t * pDst, uint32_t block
 
 void      arm_q7_to_q15_reordered_no_shift(const q7_t * pSrc, q15_t * pDst, uint32_t blockSize);
 
+/**
+ * @brief Converts the elements of the Q7 vector to Q15 vector with left-shift
+ * @param[in]       *pSrc points to the Q7 input vector
+ * @param[out]      *pDst points to the Q15 output vector
+ * @param[in]       shift number of fractional bits to add, at most 8
+ * @param[in]       blockSize length of the input vector
+ * @return none.
+ *
+ */
+
+void      arm_q7_to_q15_shift(const q7_t * pSrc, q15_t * pDst, const uint16_t shift, uint32_t blockSize);
+
+/**
+ * @brief Converts the elements of the Q15 vector to Q7 vector with rounding right-shift
+ * @param[in]       *pSrc points to the Q15 input vector
+ * @param[out]      *pDst points to the Q7 output vector
+ * @param[in]       shift number of fractional bits to drop
+ * @param[in]       blockSize length of the input vector
+ * @return none.
+ *
+ */
+
+void      arm_q15_to_q7_shift(const q15_t * pSrc, q7_t * pDst, const uint16_t shift, uint32_t blockSize);
+
 #if defined (ARM_MATH_DSP)
 
 /**
@@ -133,7 +246,177 @@ __STATIC_FORCEINLINE void *read_and_pad_reordered(void *source, q31_t * out1, q3
 
         return source;
 }
+
+/**
+ * @brief read and expand one word of packed int4 into four Q15 words
+ *
+ * The weights come out multiplied by 16, in natural order:
+ * out1 = (w0, w1), out2 = (w2, w3), out3 = (w4, w5), out4 = (w6, w7).
+ */
+
+__STATIC_FORCEINLINE void *read_and_pad_int4(void *source, q31_t * out1, q31_t * out2, q31_t * out3, q31_t * out4)
+{
+        q31_t     inA = *__SIMD32(source)++;
+        q31_t     inLo = (q31_t) (((uint32_t) inA << 4) & 0xF0F0F0F0u);
+        q31_t     inHi = (q31_t) ((uint32_t) inA & 0xF0F0F0F0u);
+
+#ifndef ARM_MATH_BIG_ENDIAN
+        *out1 = __SXTB16(inLo);
+        *out2 = __SXTB16(__ROR(inLo, 8));
+        *out3 = __SXTB16(inHi);
+        *out4 = __SXTB16(__ROR(inHi, 8));
+#else
+        *out2 = __SXTB16(inLo);
+        *out1 = __SXTB16(__ROR(inLo, 8));
+        *out4 = __SXTB16(inHi);
+        *out3 = __SXTB16(__ROR(inHi, 8));
+#endif
+
+        return source;
+}
+
+/**
+ * @brief signed multiply of the bottom halfwords, SMULBB
+ *
+ * The CMSIS core has no intrinsic for it, the C fallback is the same product.
+ */
+
+__STATIC_FORCEINLINE q31_t __SMULBB(q31_t op1, q31_t op2)
+{
+#if defined (__GNUC__) && defined (__ARM_FEATURE_DSP)
+        q31_t     result;
+
+        __ASM("smulbb %0, %1, %2" : "=r"(result) : "r"(op1), "r"(op2));
+        return result;
+#else
+        return (q31_t) (q15_t) op1 * (q15_t) op2;
 #endif
+}
+
+/**
+ * @brief signed multiply of the top halfwords, SMULTT
+ */
+
+__STATIC_FORCEINLINE q31_t __SMULTT(q31_t op1, q31_t op2)
+{
+#if defined (__GNUC__) && defined (__ARM_FEATURE_DSP)
+        q31_t     result;
+
+        __ASM("smultt %0, %1, %2" : "=r"(result) : "r"(op1), "r"(op2));
+        return result;
+#else
+        return (q31_t) (q15_t) (op1 >> 16) * (q15_t) (op2 >> 16);
+#endif
+}
+#endif
+
+/**
+ * @brief Unpacks 8 int4 weights into Q7 without scaling
+ * @param[in]       *pSrc points to the 4 packed bytes
+ * @param[out]      *pDst points to the 8 Q7 weights
+ * @return none.
+ *
+ * 8 consecutive weights w0..w7 are packed in 4 bytes as
+ * | w0 + w4 << 4 | w2 + w6 << 4 | w1 + w5 << 4 | w3 + w7 << 4 |
+ * so that masking the low or high nibbles of a word and sign-extending
+ * every other byte gives the q15 pairs in natural order, see read_and_pad_int4.
+ */
+
+__STATIC_FORCEINLINE void arm_nn_unpack_int4(const q7_t * pSrc, q7_t * pDst)
+{
+        /* sign-extend the nibbles */
+        pDst[0] = (q7_t) ((uint8_t)pSrc[0] << 4) >> 4;
+        pDst[4] = (q7_t) pSrc[0] >> 4;
+        pDst[2] = (q7_t) ((uint8_t)pSrc[1] << 4) >> 4;
+        pDst[6] = (q7_t) pSrc[1] >> 4;
+        pDst[1] = (q7_t) ((uint8_t)pSrc[2] << 4) >> 4;
+        pDst[5] = (q7_t) pSrc[2] >> 4;
+        pDst[3] = (q7_t) ((uint8_t)pSrc[3] << 4) >> 4;
+        pDst[7] = (q7_t) pSrc[3] >> 4;
+}
+
+/**
+ * @brief Sets up the reciprocal of a divisor
+ * @param[out]      *recip      reciprocal to fill in
+ * @param[in]       n           divisor, 0 < n < 2^24
+ * @return none.
+ *
+ * This does one 64-bit division, callers keep the result for as long as
+ * the divisor does not change.
+ */
+
+__STATIC_FORCEINLINE void arm_nn_recip_init(arm_nn_recip * recip, const uint32_t n)
+{
+        uint16_t  log2_n = 0;
+
+        while (((uint32_t)1 << log2_n) < n)
+        {
+            log2_n++;
+        }
+        recip->shift = 31 + log2_n;
+        recip->mult = (uint32_t) ((((uint64_t)1 << recip->shift) + n - 1) / n);
+}
+
+/**
+ * @brief Divides by a constant with a multiply and a shift
+ * @param[in]       x           dividend, |x| <= 128 * n
+ * @param[in]       *recip      reciprocal of n from arm_nn_recip_init
+ * @return x / n, rounded toward zero like the C division.
+ *
+ * With |x| <= 128 * n the rounding error of mult stays below one unit
+ * of the result, so this is exact for the average of up to n q7 values.
+ */
+
+__STATIC_FORCEINLINE q31_t arm_nn_div_recip(const q31_t x, const arm_nn_recip * recip)
+{
+        if (x >= 0)
+        {
+            return (q31_t) (((uint64_t)x * recip->mult) >> recip->shift);
+        }
+        return -(q31_t) (((uint64_t)(-x) * recip->mult) >> recip->shift);
+}
+
+/**
+ * @brief Applies an activation to a requantized value
+ * @param[in]       x           requantized value, before the saturation
+ * @param[in]       *act        activation
+ * @return the activated value, to be saturated by the caller.
+ *
+ * This is the epilogue of the _act kernels: x is the accumulator after
+ * the output right-shift, so the activation costs no pass over the
+ * output tensor. The hard sigmoid and hard swish divide by 6 with a q15
+ * reciprocal and round to nearest.
+ */
+
+__STATIC_FORCEINLINE q31_t arm_nn_activate(q31_t x, const arm_nn_act * act)
+{
+        const q31_t three = 3 << act->frac;
+        q31_t     r;
+
+        switch (act->type)
+        {
+        case ARM_ACT_RELU:
+            return x > 0 ? x : 0;
+        case ARM_ACT_RELU6:
+            return x > 0 ? (x < 2 * three ? x : 2 * three) : 0;
+        case ARM_ACT_LEAKY_RELU:
+            return x >= 0 ? x : (q31_t) (((q63_t) x * act->alpha) >> 15);
+        case ARM_ACT_HARD_SIGMOID:
+            /* anything outside q15 is far past the +-3 knees */
+            r = __SSAT(x, 16) + three;
+            r = r > 0 ? (r < 2 * three ? r : 2 * three) : 0;
+            return (r * 5461 + (1 << 14)) >> 15;
+        case ARM_ACT_HARD_SWISH:
+            if (x >= three)
+                return x;
+            if (x <= -three)
+                return 0;
+            /* |x * (x + 3)| < 18 << (2 * frac), times 5461 fits in 31 bits */
+            return (x * (x + three) * 5461 + (1 << (14 + act->frac))) >> (15 + act->frac);
+        default:
+            return x;
+        }
+}
 
 /**
  * @defgroup NNBasicMath Basic Math Functions for Neural Network Computation
@@ -185,7 +468,138 @@ void arm_nn_mult_q7(
   q7_t * pDst,
   const uint16_t out_shift,
   uint32_t blockSize);
+
+/**
+ * @brief           Q15 vector addition with saturation
+ * @param[in]       *pSrcA        pointer to the first input vector
+ * @param[in]       *pSrcB        pointer to the second input vector
+ * @param[out]      *pDst         pointer to the output vector
+ * @param[in]       blockSize     number of samples in each vector
+ * @return none.
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * The function uses saturating arithmetic.
+ * Results outside of the allowable Q15 range [0x8000 0x7FFF] will be saturated.
+ */
+
+void arm_nn_add_q15(
+  q15_t * pSrcA,
+  q15_t * pSrcB,
+  q15_t * pDst,
+  uint32_t blockSize);
+
+/**
+ * @brief           Q7 count of the all-zero groups of four values
+ * @param[in]       *pSrc         pointer to the input vector
+ * @param[in]       blockSize     number of samples in the vector
+ * @return          number of groups of four consecutive samples that are all zero.
+ */
+
+uint32_t arm_nn_zero_groups_q7(
+  const q7_t * pSrc,
+  uint32_t blockSize);
  
+/**
+ * @defgroup NNRegion Region Tracking Functions for Incremental Execution
+ *
+ * Track the part of each activation tensor that changed since the
+ * previous frame, so that only the affected outputs are recomputed
+ *
+ */
+
+/**
+ * @brief Finds the region of a Q7 HWC tensor that changed and updates the cache
+ * @param[in]       *pIn          pointer to the new input tensor
+ * @param[in,out]   *pCache       pointer to the cached tensor of the previous frame
+ * @param[in]       dim_im        tensor dimension
+ * @param[in]       ch_im         number of tensor channels
+ * @param[out]      *rect         bounding rectangle of the changed pixels
+ * @return none.
+ */
+
+void arm_nn_diff_rect_q7(const q7_t * pIn,
+                         q7_t * pCache,
+                         const uint16_t dim_im,
+                         const uint16_t ch_im,
+                         arm_nn_rect * rect);
+
+/**
+ * @brief Propagates a changed region through a convolution or pooling layer
+ * @param[in]       *in           changed region of the layer input
+ * @param[in]       dim_kernel    filter kernel size
+ * @param[in]       padding       padding sizes
+ * @param[in]       stride        convolution stride
+ * @param[in]       dim_im_out    output tensor dimension
+ * @param[out]      *out          region of the layer output that must be recomputed
+ * @return none.
+ */
+
+void arm_nn_rect_propagate(const arm_nn_rect * in,
+                           const uint16_t dim_kernel,
+                           const uint16_t padding,
+                           const uint16_t stride,
+                           const uint16_t dim_im_out,
+                           arm_nn_rect * out);
+
+/**
+ * @defgroup NNBitmap Bitmap Storage of Activations
+ *
+ * Store the activations between two layers as a bitmap and the packed
+ * non-zero values, row by row, to cut the memory of sparse tensors
+ *
+ */
+
+/**
+ * @brief Lays out a bitmap tensor over a buffer
+ * @param[out]      *t            bitmap tensor to set up
+ * @param[in]       dim_im        tensor dimension
+ * @param[in]       ch_im         number of tensor channels
+ * @param[in]       *buffer       pointer to the storage, word aligned
+ * @param[in]       buffer_size   size of the storage in bytes
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ */
+
+arm_status arm_nn_bitmap_init_q7(arm_nn_bitmap_q7 * t,
+                                 const uint16_t dim_im,
+                                 const uint16_t ch_im,
+                                 q7_t * buffer,
+                                 const uint32_t buffer_size);
+
+/**
+ * @brief Appends a row to a bitmap tensor
+ * @param[in,out]   *t            bitmap tensor
+ * @param[in]       y             row index, the rows are written in order
+ * @param[in]       *row          pointer to the dense row, dim * ch values
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ */
+
+arm_status arm_nn_bitmap_put_row_q7(arm_nn_bitmap_q7 * t,
+                                    const uint16_t y,
+                                    const q7_t * row);
+
+/**
+ * @brief Expands a row of a bitmap tensor
+ * @param[in]       *t            bitmap tensor
+ * @param[in]       y             row index
+ * @param[out]      *row          pointer to the dense row, dim * ch values
+ * @return none.
+ */
+
+void arm_nn_bitmap_get_row_q7(const arm_nn_bitmap_q7 * t,
+                              const uint16_t y,
+                              q7_t * row);
+
+/**
+ * @brief Storage used by a complete bitmap tensor
+ * @param[in]       *t            bitmap tensor with all its rows written
+ * @return          bytes from the start of the buffer to the last value.
+ */
+
+uint32_t arm_nn_bitmap_size_q7(const arm_nn_bitmap_q7 * t);
+
 /**
  * @brief macro for adding rounding offset
  */
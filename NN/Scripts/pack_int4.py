@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Int4 quantization of a CMSIS-NN q7 model.
+
+Reads the weight header of the CIFAR-10 example (e.g.
+arm_nnexamples_cifar10_weights.h) and writes a header with the weights of
+the selected layers in the packed int4 format of arm_convolve_HWC_q7_int4
+and arm_fully_connected_q7_int4:
+
+    <LAYER>_I4_WT     two weights per byte, rows of cols/2 bytes
+    <LAYER>_I4_SHIFT  per row left-shift from int4 to q7 (0..4)
+
+Each row w is approximated by w4 << shift with w4 in [-8, 7]. The shift
+of a row is the one with the smallest squared error, which trades the
+clipping of the largest weights against the resolution of the small
+ones. The bias and output shifts of the layers do not change.
+
+8 consecutive weights w0..w7 of a row are packed in 4 bytes as
+    | w0 + w4 << 4 | w2 + w6 << 4 | w1 + w5 << 4 | w3 + w7 << 4 |
+
+IP1 is stored in the interleaved format of arm_fully_connected_q7_opt and
+is de-interleaved first; the int4 FC kernel takes the row-major order.
+
+Example:
+    python pack_int4.py ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_weights.h \\
+        ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_int4_weights.h
+"""
+
+import argparse
+import sys
+
+from prune_model import LAYERS, parse_header, deinterleave_opt
+
+
+def quantize_row(row):
+    """Returns (int4 values, shift) with the smallest squared error."""
+    best = None
+    for shift in range(5):
+        q = [max(-8, min(7, int(round(v / float(1 << shift))))) for v in row]
+        err = sum((v - (w << shift)) ** 2 for v, w in zip(row, q))
+        if best is None or err < best[0]:
+            best = (err, q, shift)
+    return best[1], best[2]
+
+
+def pack_row(q):
+    """Packs a row of int4 values, 8 weights in 4 bytes."""
+    packed = []
+    for g in range(0, len(q), 8):
+        w = [v & 0xF for v in q[g:g + 8]]
+        for lo, hi in ((0, 4), (2, 6), (1, 5), (3, 7)):
+            byte = w[lo] | (w[hi] << 4)
+            packed.append(byte - 256 if byte > 127 else byte)
+    return packed
+
+
+def c_array(values):
+    return '{' + ','.join(str(v) for v in values) + '}'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Int4 quantization of the CIFAR-10 q7 weights')
+    parser.add_argument('weights', help='q7 weight header')
+    parser.add_argument('output', help='int4 weight header to write')
+    parser.add_argument('--layers', default='CONV2,CONV3,IP1',
+                        help='comma separated layers to quantize (default CONV2,CONV3,IP1)')
+    args = parser.parse_args()
+
+    defines = parse_header(args.weights)
+
+    out = ['/* Generated by NN/Scripts/pack_int4.py from %s */'
+           % args.weights.replace('\\', '/').split('/')[-1], '']
+    for name in args.layers.split(','):
+        rows, cols, interleaved = LAYERS[name]
+        wt = defines[name + '_WT']
+        if cols % 8 != 0 or len(wt) != rows * cols:
+            sys.exit('%s: unexpected weight size %d' % (name, len(wt)))
+
+        m = deinterleave_opt(wt, rows, cols) if interleaved else \
+            [wt[r * cols:(r + 1) * cols] for r in range(rows)]
+
+        packed, shifts, err = [], [], 0.0
+        for row in m:
+            q, shift = quantize_row(row)
+            packed.extend(pack_row(q))
+            shifts.append(shift)
+            err += sum(abs(v - (w << shift)) for v, w in zip(row, q))
+        print('%-5s %5d -> %5d bytes, mean abs error %.2f q7 LSB'
+              % (name, rows * cols, len(packed), err / (rows * cols)))
+
+        out.append('#define %s_I4_WT %s' % (name, c_array(packed)))
+        out.append('#define %s_I4_SHIFT %s' % (name, c_array(shifts)))
+        out.append('')
+
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
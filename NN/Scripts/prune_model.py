@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+"""
+Block-sparse pruning of a CMSIS-NN q7 model.
+
+Reads the weight header of the CIFAR-10 example (e.g.
+arm_nnexamples_cifar10_weights.h), removes the blocks of 4 consecutive
+weights with the smallest L1 norm and writes a header with the sparse
+weights in the format used by arm_convolve_HWC_q7_sparse and
+arm_fully_connected_q7_sparse:
+
+    <LAYER>_SP_WT   non-zero blocks, 4 weights each, row by row
+    <LAYER>_SP_IDX  column index of each block, in units of 4 columns
+    <LAYER>_SP_PTR  index of the first block of each row, rows+1 entries
+
+For convolutions a row is one filter in [ky][kx][ch_in] order, so a block
+is 4 input channels at one kernel position. IP1 is stored in the
+interleaved format of arm_fully_connected_q7_opt and is de-interleaved
+first; the sparse FC kernel takes the regular row-major order.
+
+Re-quantization: with --float, the weights are taken from a .npz file
+holding the float weights of the layers (keys conv2_wt, conv3_wt, ip1_wt,
+same element order as the header, ip1 row-major). Pruning is then done
+on the float values and the surviving weights are quantized again with
+the fractional bits that fit their new range. The bias left-shift and
+output right-shift are adjusted by the same amount. Without --float the
+q7 values and shifts are kept as they are.
+
+Accuracy: with --calibration (a .npz with 'images', N x 32 x 32 x 3 uint8,
+and optionally 'labels') and --parameters, the dense and the pruned q7
+networks of CNN_Run are simulated bit-accurately on the calibration set
+and the top-1 agreement of the pruned one with the dense one (or the
+accuracy of both with labels) is reported. Without --sparsity the largest
+sparsity, in steps of 0.05, whose loss stays within --budget percentage
+points is then picked. CNN_Run takes the top classes from the int32
+accumulators of the sparse ip1 (arm_fully_connected_q7_sparse_q31), as
+it does for the dense one, so they are compared unsaturated. Without a
+calibration set the default sparsity is DEFAULT_SPARSITY: only the
+all-zero blocks are removed, which keeps the conv layers exact. The
+example model is not trained for sparsity and loses
+several points of agreement from 0.05 on, a retrained model can be pruned
+harder this way.
+
+Example:
+    python prune_model.py ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_weights.h \\
+        ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_sparse_weights.h \\
+        --parameters ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_parameter.h \\
+        --calibration calib.npz --budget 1
+"""
+
+import argparse
+import math
+import re
+import sys
+
+# name, number of rows, number of columns, interleaved (q7_opt) layout
+LAYERS = {
+    'CONV2': (16, 5 * 5 * 32, False),
+    'CONV3': (32, 5 * 5 * 16, False),
+    'IP1':   (10, 4 * 4 * 32, True),
+}
+
+DEFAULT_SPARSITY = 0.0
+SPARSITY_STEP = 0.05
+
+
+def parse_header(path):
+    """Returns the #define values of the header, arrays as lists of int."""
+    defines = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'\s*#define\s+(\w+)\s+(.*)', line)
+            if not m:
+                continue
+            name, value = m.group(1), m.group(2).strip()
+            if value.startswith('{'):
+                defines[name] = [int(v) for v in value.strip('{}').split(',') if v.strip()]
+            else:
+                try:
+                    defines[name] = int(value)
+                except ValueError:
+                    pass
+    return defines
+
+
+def deinterleave_opt(wt, rows, cols):
+    """Undoes the weight interleaving of arm_fully_connected_q7_opt."""
+    m = [[0] * cols for _ in range(rows)]
+    p = 0
+    r = 0
+    while r + 4 <= rows:
+        c = 0
+        while c + 4 <= cols:
+            # | a11 a21 a13 a23 a31 a41 a33 a43 | a12 a22 a14 a24 a32 a42 a34 a44 |
+            for half in (0, 1):
+                for pair in (0, 2):
+                    for cc in (0, 2):
+                        for rr in (0, 1):
+                            m[r + pair + rr][c + half + cc] = wt[p]
+                            p += 1
+            c += 4
+        # left-over columns are in-order over the 4 rows
+        while c < cols:
+            for rr in range(4):
+                m[r + rr][c] = wt[p]
+                p += 1
+            c += 1
+        r += 4
+    # left-over rows are stored as they are
+    while r < rows:
+        for c in range(cols):
+            m[r][c] = wt[p]
+            p += 1
+        r += 1
+    return m
+
+
+def prune(m, sparsity):
+    """Returns the (row, block) keep mask dropping the weakest blocks."""
+    rows, cols = len(m), len(m[0])
+    norms = []
+    for r in range(rows):
+        for b in range(cols // 4):
+            norms.append((sum(abs(v) for v in m[r][4 * b:4 * b + 4]), r, b))
+    norms.sort()
+    n_drop = int(len(norms) * sparsity)
+    keep = set((r, b) for n, r, b in norms[n_drop:] if n != 0)
+    return keep
+
+
+def requantize(m, old_frac):
+    """Quantizes float weights to q7, returns (matrix, fractional bits)."""
+    peak = max(abs(v) for row in m for v in row)
+    frac = 7 - int(math.ceil(math.log2(peak))) if peak > 0 else old_frac
+    q = [[max(-128, min(127, int(round(v * 2 ** frac)))) for v in row] for row in m]
+    return q, frac
+
+
+def to_sparse(m, keep):
+    wt, idx, ptr = [], [], [0]
+    for r in range(len(m)):
+        for b in range(len(m[0]) // 4):
+            if (r, b) in keep and any(m[r][4 * b:4 * b + 4]):
+                wt.extend(m[r][4 * b:4 * b + 4])
+                idx.append(b)
+        ptr.append(len(idx))
+    return wt, idx, ptr
+
+
+def c_array(values):
+    return '{' + ','.join(str(v) for v in values) + '}'
+
+
+def prune_layers(defines, layers, sparsity, floats):
+    """Prunes each layer, returns {name: (q7 matrix, keep mask, bias left-shift, out right-shift)}."""
+    pruned = {}
+    for name in layers:
+        rows, cols, interleaved = LAYERS[name]
+        wt = defines[name + '_WT']
+        bias_lshift = defines[name + '_BIAS_LSHIFT']
+        out_rshift = defines[name + '_OUT_RSHIFT']
+        if cols % 4 != 0 or len(wt) != rows * cols:
+            sys.exit('%s: unexpected weight size %d' % (name, len(wt)))
+
+        m = deinterleave_opt(wt, rows, cols) if interleaved else \
+            [wt[r * cols:(r + 1) * cols] for r in range(rows)]
+
+        if floats is not None:
+            fm = floats[name.lower() + '_wt'].reshape(rows, cols).tolist()
+            # the current format is the one that maps the float weights onto the q7 ones
+            peak = max(range(rows * cols), key=lambda i: abs(fm[i // cols][i % cols]))
+            old_frac = int(round(math.log2(abs(m[peak // cols][peak % cols]) /
+                                           abs(fm[peak // cols][peak % cols]))))
+            keep = prune(fm, sparsity)
+            fm = [[v if (r, c // 4) in keep else 0.0 for c, v in enumerate(row)] for r, row in enumerate(fm)]
+            m, frac = requantize(fm, old_frac)
+            bias_lshift += frac - old_frac
+            out_rshift += frac - old_frac
+            if bias_lshift < 0:
+                sys.exit('%s: weights need fewer fractional bits than the bias' % name)
+        else:
+            keep = prune(m, sparsity)
+        m = [[v if (r, c // 4) in keep else 0 for c, v in enumerate(row)] for r, row in enumerate(m)]
+        pruned[name] = (m, keep, bias_lshift, out_rshift)
+    return pruned
+
+
+def top1(images, p, pruned):
+    """Top-1 classes of CNN_Run with the pruned layers, see select_precision.simulate."""
+    from select_precision import simulate, TENSORS
+
+    p = dict(p)
+    rows, cols, _ = LAYERS['IP1']
+    ip1_m = deinterleave_opt(p['IP1_WT'], rows, cols)
+    for name, (m, keep, bias_lshift, out_rshift) in pruned.items():
+        if name == 'IP1':
+            ip1_m = m
+        else:
+            p[name + '_WT'] = [v for row in m for v in row]
+            p[name + '_OUT_RSHIFT'] = out_rshift
+        p[name + '_BIAS_LSHIFT'] = bias_lshift
+    # the ip1 accumulators, as arm_fully_connected_q7_sparse_q31 writes them
+    scores = simulate(images, p, (False,) * len(TENSORS), dict.fromkeys(TENSORS, 0), ip1_m)[0]
+    return scores.argmax(axis=1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Block-sparse pruning of the CIFAR-10 q7 weights')
+    parser.add_argument('weights', help='dense weight header')
+    parser.add_argument('output', help='sparse weight header to write')
+    parser.add_argument('--sparsity', type=float,
+                        help='fraction of weight blocks to remove in each layer (default: the largest '
+                             'within --budget with --calibration, %.2f without)' % DEFAULT_SPARSITY)
+    parser.add_argument('--layers', default='CONV2,CONV3,IP1',
+                        help='comma separated layers to prune (default CONV2,CONV3,IP1)')
+    parser.add_argument('--float', dest='float_path', help='.npz with the float weights, enables re-quantization')
+    parser.add_argument('--parameters', help='parameter header, needed by --calibration')
+    parser.add_argument('--calibration', help='.npz with images (N x 32 x 32 x 3 uint8) and optionally labels')
+    parser.add_argument('--budget', type=float, default=1.0,
+                        help='accuracy loss allowed against the dense model, in percentage points (default 1)')
+    args = parser.parse_args()
+
+    if args.sparsity is not None and not 0.0 <= args.sparsity < 1.0:
+        sys.exit('sparsity must be in [0, 1)')
+    if args.calibration and not args.parameters:
+        sys.exit('--calibration needs --parameters')
+
+    defines = parse_header(args.weights)
+    layers = args.layers.split(',')
+    floats = None
+    if args.float_path:
+        import numpy as np
+        floats = np.load(args.float_path)
+
+    if args.calibration:
+        import numpy as np
+        p = parse_header(args.parameters)
+        p.update(defines)
+        calib = np.load(args.calibration)
+        images = calib['images']
+        if images.shape[1:] != (32, 32, 3):
+            sys.exit('calibration images must be N x 32 x 32 x 3')
+        dense = top1(images, p, {})
+        target = calib['labels'].astype(np.int64) if 'labels' in calib else dense
+        ref = 100.0 * np.mean(dense == target)
+
+        steps = [args.sparsity] if args.sparsity is not None else \
+            [i * SPARSITY_STEP for i in range(int(round(1.0 / SPARSITY_STEP)))]
+        print('sparsity  %s  (dense %.2f%%)' % ('accuracy' if 'labels' in calib else 'agreement', ref))
+        sparsity = None
+        for step in steps:
+            acc = 100.0 * np.mean(top1(images, p, prune_layers(defines, layers, step, floats)) == target)
+            print('%8.2f  %8.2f%%' % (step, acc))
+            if acc >= ref - args.budget:
+                sparsity = step
+            elif args.sparsity is None:
+                break
+        if sparsity is None:
+            print('warning: sparsity %.2f loses more than %.2f points' % (steps[0], args.budget))
+            sparsity = steps[0]
+        elif args.sparsity is None:
+            print('selected sparsity %.2f' % sparsity)
+    else:
+        sparsity = args.sparsity if args.sparsity is not None else DEFAULT_SPARSITY
+
+    out = ['/* Generated by NN/Scripts/prune_model.py from %s, sparsity %.2f */'
+           % (args.weights.replace('\\', '/').split('/')[-1], sparsity), '']
+    for name, (m, keep, bias_lshift, out_rshift) in prune_layers(defines, layers, sparsity, floats).items():
+        rows, cols, _ = LAYERS[name]
+        sp_wt, sp_idx, sp_ptr = to_sparse(m, keep)
+        total = rows * cols // 4
+        print('%-5s kept %4d of %4d blocks (%.0f%% of the MACs)'
+              % (name, len(sp_idx), total, 100.0 * len(sp_idx) / total))
+
+        out.append('#define %s_SP_NNZ %d' % (name, len(sp_idx)))
+        out.append('#define %s_SP_WT %s' % (name, c_array(sp_wt)))
+        out.append('#define %s_SP_IDX %s' % (name, c_array(sp_idx)))
+        out.append('#define %s_SP_PTR %s' % (name, c_array(sp_ptr)))
+        out.append('#define %s_SP_BIAS_LSHIFT %d' % (name, bias_lshift))
+        out.append('#define %s_SP_OUT_RSHIFT %d' % (name, out_rshift))
+        out.append('')
+
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""
+Per-layer precision selection for the CIFAR-10 CMSIS-NN model.
+
+Each activation tensor of the network (the input and the pooled output of
+conv1, conv2 and conv3) is kept either in q7, as in the original model,
+or in q15 with <T>_FRAC more fractional bits. The weights stay q7: a layer
+with a q15 input or output runs arm_convolve_HWC_mat_q7_im_q15,
+arm_relu_q15 and arm_maxpool_q15_HWC on the same weights, with the bias
+left-shift and output right-shift adjusted by the fractional bits of its
+input and output.
+
+All 16 combinations are simulated bit-accurately on a calibration set
+(a .npz with 'images', N x 32 x 32 x 3 uint8, and optionally 'labels').
+The reference is the all-q15 model. Without labels the accuracy of a
+combination is its top-1 agreement with the reference. The cheapest
+combination whose accuracy is within --budget percentage points of the
+reference is written as arm_nnexamples_cifar10_precision.h:
+
+    <T>_Q15         1 if tensor T is q15, T in INPUT, CONV1, CONV2, CONV3
+    <T>_FRAC        extra fractional bits of T, 0 for q7
+    IP1_WT_VEC_Q15  ip1 weights for arm_fully_connected_mat_q7_vec_q15_opt_q31
+
+The fractional bits of a q15 tensor are the most that keep the largest
+value seen on the calibration set within 16 bits, less --headroom bits.
+The cost of a combination is the number of MACs, those of the layers that
+run the q15 kernels weighted by --q15-cost.
+
+ip1 keeps its int32 accumulators either way, the top classes are taken
+from them. IP1_WT is stored in the interleaved format of
+arm_fully_connected_q7_opt. arm_fully_connected_mat_q7_vec_q15_opt_q31 pairs the columns differently
+(a11 a21 a12 a22 instead of a11 a21 a13 a23) and reads the left-over rows
+without reordering, so ip1 is de-interleaved and interleaved again for it.
+
+Example:
+    python select_precision.py ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_weights.h \\
+        ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_parameter.h calib.npz \\
+        ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_precision.h --budget 0.5
+"""
+
+import argparse
+import itertools
+import sys
+
+import numpy as np
+
+from prune_model import parse_header, deinterleave_opt, c_array
+
+# tensors whose precision is selected, in network order
+TENSORS = ['INPUT', 'CONV1', 'CONV2', 'CONV3']
+CONVS = ['CONV1', 'CONV2', 'CONV3']
+MAX_FRAC = 8
+
+
+def ssat(x, bits):
+    return np.clip(x, -(1 << (bits - 1)), (1 << (bits - 1)) - 1)
+
+
+def nn_round(shift):
+    return (1 << shift) >> 1
+
+
+def preprocess(images, p, frac, bits):
+    """CNN_Preprocess (bits 8) and CNN_PreprocessQ15 (bits 16)."""
+    x = (images.astype(np.int64) - np.array(p['INPUT_MEAN_SHIFT'])) << 7
+    shift = np.array(p['INPUT_RIGHT_SHIFT']) - frac
+    return ssat((x + (1 << shift) // 2) >> shift, bits)
+
+
+def conv_acc(x, wt, bias, k, pad, stride, bias_shift):
+    """int64 accumulators of an HWC convolution, weights [out][ky][kx][in]."""
+    n, dim, _, ch = x.shape
+    co = len(bias)
+    xp = np.pad(x, ((0, 0), (pad, pad), (pad, pad), (0, 0)))
+    win = np.lib.stride_tricks.sliding_window_view(xp, (k, k), axis=(1, 2))[:, ::stride, ::stride]
+    dim_out = win.shape[1]
+    cols = win.transpose(0, 1, 2, 4, 5, 3).reshape(-1, k * k * ch)
+    w = np.array(wt, dtype=np.float64).reshape(co, k * k * ch)
+    # float64 is exact here, the sums stay far below 2^53
+    acc = np.rint(cols.astype(np.float64) @ w.T).astype(np.int64)
+    acc += np.array(bias, dtype=np.int64) << bias_shift
+    return acc.reshape(n, dim_out, dim_out, co)
+
+
+def maxpool(x, k, pad, stride, dim_out):
+    """arm_maxpool_q7_HWC / arm_maxpool_q15_HWC, window clipped to the input."""
+    lo = np.iinfo(np.int64).min
+    xp = np.pad(x, ((0, 0), (pad, pad + k), (pad, pad + k), (0, 0)), constant_values=lo)
+    win = np.lib.stride_tricks.sliding_window_view(xp, (k, k), axis=(1, 2))[:, ::stride, ::stride]
+    return win[:, :dim_out, :dim_out].max(axis=(4, 5))
+
+
+def simulate(images, p, cfg, frac, ip1_m):
+    """Returns (ip1 scores, ip1 frac, largest |accumulator|, largest |q7 value| per tensor)."""
+    q15 = dict(zip(TENSORS, cfg))
+    g = {t: frac[t] if q15[t] else 0 for t in TENSORS}
+    peak_acc = 0
+    peak = {}
+
+    act = preprocess(images, p, g['INPUT'], 16 if q15['INPUT'] else 8)
+    peak['INPUT'] = np.abs(preprocess(images, p, 0, 32)).max()
+    prev = 'INPUT'
+    for name in CONVS:
+        n = name[-1]
+        bs = p[name + '_BIAS_LSHIFT'] + g[prev]
+        os_ = p[name + '_OUT_RSHIFT'] + g[prev] - g[name]
+        acc = conv_acc(act, p[name + '_WT'], p[name + '_BIAS'], p[name + '_KER_DIM'],
+                       p[name + '_PADDING'], p[name + '_STRIDE'], bs)
+        peak_acc = max(peak_acc, np.abs(acc).max() + nn_round(os_))
+        out = np.maximum((acc + nn_round(os_)) >> os_, 0)
+        peak[name] = out.max() / 2.0 ** g[name]
+        out = ssat(out, 16 if q15[name] else 8)
+        act = maxpool(out, p['POOL%s_KER_DIM' % n], p['POOL%s_PADDING' % n],
+                      p['POOL%s_STRIDE' % n], p['POOL%s_OUT_DIM' % n])
+        prev = name
+
+    x = act.reshape(act.shape[0], -1).astype(np.float64)
+    acc = np.rint(x @ np.array(ip1_m, dtype=np.float64).T).astype(np.int64)
+    # arm_fully_connected_q7_opt_q31 or arm_fully_connected_mat_q7_vec_q15_opt_q31,
+    # raw accumulators with the extra fractional bits of a q15 input
+    acc += np.array(p['IP1_BIAS'], dtype=np.int64) << (p['IP1_BIAS_LSHIFT'] + g['CONV3'])
+    peak_acc = max(peak_acc, np.abs(acc).max())
+    return acc, g['CONV3'], peak_acc, peak
+
+
+def pick_frac(peak, limit, headroom):
+    """Most fractional bits that keep peak (in q7 units) within q15."""
+    g = MAX_FRAC
+    while g > 0 and peak * 2 ** (g + headroom) > 32767:
+        g -= 1
+    return max(0, min(g, limit))
+
+
+def interleave_vec_q15_opt(m):
+    """Interleaves a row-major matrix for arm_fully_connected_mat_q7_vec_q15_opt_q31."""
+    rows, cols = len(m), len(m[0])
+    wt = []
+    r = 0
+    while r + 4 <= rows:
+        c = 0
+        while c + 4 <= cols:
+            # | a11 a21 a12 a22 a31 a41 a32 a42 | a13 a23 a14 a24 a33 a43 a34 a44 |
+            for half in (0, 2):
+                for pair in (0, 2):
+                    for cc in (0, 1):
+                        for rr in (0, 1):
+                            wt.append(m[r + pair + rr][c + half + cc])
+            c += 4
+        # left-over columns are in-order over the 4 rows
+        while c < cols:
+            for rr in range(4):
+                wt.append(m[r + rr][c])
+            c += 1
+        r += 4
+    # left-over rows are stored as they are
+    while r < rows:
+        wt.extend(m[r])
+        r += 1
+    return wt
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Per-layer q7/q15 precision selection of the CIFAR-10 model')
+    parser.add_argument('weights', help='weight header')
+    parser.add_argument('parameters', help='parameter header')
+    parser.add_argument('calibration', help='.npz with images (N x 32 x 32 x 3 uint8) and optionally labels')
+    parser.add_argument('output', help='precision header to write')
+    parser.add_argument('--budget', type=float, default=0.5,
+                        help='accuracy loss allowed against the all-q15 model, in percentage points (default 0.5)')
+    parser.add_argument('--headroom', type=int, default=1,
+                        help='bits kept free above the calibration range of a q15 tensor (default 1)')
+    parser.add_argument('--q15-cost', type=float, default=1.6,
+                        help='relative cost of a MAC of the q15 kernels (default 1.6)')
+    args = parser.parse_args()
+
+    p = parse_header(args.parameters)
+    p.update(parse_header(args.weights))
+    p['IP1_DIM'] = p['POOL3_OUT_DIM'] ** 2 * p['CONV3_OUT_CH']
+    calib = np.load(args.calibration)
+    images = calib['images']
+    labels = calib['labels'] if 'labels' in calib else None
+    if images.shape[1:] != (32, 32, 3):
+        sys.exit('calibration images must be N x 32 x 32 x 3')
+
+    ip1_m = deinterleave_opt(p['IP1_WT'], p['IP1_OUT'], p['IP1_DIM'])
+
+    # ranges of the q7 model set the fractional bits of each q15 tensor
+    scores, _, _, peak = simulate(images, p, (False,) * 4, dict.fromkeys(TENSORS, 0), ip1_m)
+    frac = {'INPUT': pick_frac(peak['INPUT'], min(p['INPUT_RIGHT_SHIFT']), args.headroom)}
+    # the output right-shift must stay >= 0 also when the input of the layer is q7
+    for name in CONVS:
+        frac[name] = pick_frac(peak[name], p[name + '_OUT_RSHIFT'], args.headroom)
+
+    macs = {}
+    for name in CONVS:
+        macs[name] = (p[name + '_OUT_DIM'] ** 2 * p[name + '_OUT_CH'] *
+                      p[name + '_KER_DIM'] ** 2 * p[name + '_IM_CH'])
+    macs['IP1'] = p['IP1_DIM'] * p['IP1_OUT']
+
+    results = []
+    for cfg in itertools.product((False, True), repeat=len(TENSORS)):
+        q15 = dict(zip(TENSORS, cfg))
+        scores, _, peak_acc, _ = simulate(images, p, cfg, frac, ip1_m)
+        top1 = scores.argmax(axis=1)
+        cost = macs['IP1'] * (args.q15_cost if q15['CONV3'] else 1.0)
+        prev = 'INPUT'
+        for name in CONVS:
+            cost += macs[name] * (args.q15_cost if q15[prev] or q15[name] else 1.0)
+            prev = name
+        results.append((cfg, top1, cost, peak_acc < 2 ** 31))
+
+    ref = results[-1][1]
+    target = labels if labels is not None else ref
+    best = None
+    print('INPUT CONV1 CONV2 CONV3     cost(MAC)  accuracy')
+    for cfg, top1, cost, fits in results:
+        acc = 100.0 * np.mean(top1 == target)
+        ok = fits and acc >= 100.0 * np.mean(ref == target) - args.budget
+        print('%5s %5s %5s %5s %13.0f  %6.2f%%%s' % (tuple('q15' if q else 'q7' for q in cfg) +
+              (cost, acc, '' if fits else '  accumulator overflow')))
+        if ok and (best is None or cost < best[1]):
+            best = (cfg, cost)
+    if best is None:
+        sys.exit('no combination fits in 32-bit accumulators')
+
+    q15 = dict(zip(TENSORS, best[0]))
+    print('selected: ' + ' '.join('%s=%s' % (t, 'q15 (+%d)' % frac[t] if q15[t] else 'q7') for t in TENSORS))
+
+    out = ['/* Generated by NN/Scripts/select_precision.py from %s, budget %.2f%% */'
+           % (args.weights.replace('\\', '/').split('/')[-1], args.budget), '']
+    for t in TENSORS:
+        out.append('#define %s_Q15 %d' % (t, int(q15[t])))
+        out.append('#define %s_FRAC %d' % (t, frac[t] if q15[t] else 0))
+    out.append('')
+    out.append('#define IP1_WT_VEC_Q15 %s' % c_array(interleave_vec_q15_opt(ip1_m)))
+    out.append('')
+
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+Training and export of the early-exit head of the CIFAR-10 CMSIS-NN model.
+
+The head is one fully connected layer from the pool2 output (8 x 8 x 16,
+HWC) to the 10 classes, followed by arm_softmax_q7. CNN_Run takes its
+result and skips conv3/pool3/ip1 when the largest softmax output reaches
+EXIT1_THRESHOLD (q7, 128 = 100%).
+
+The q7 network is simulated bit-accurately up to pool2 on a calibration
+set (a .npz with 'images', N x 32 x 32 x 3 uint8, and optionally
+'labels'), the head is fitted on the pool2 outputs by softmax regression
+and quantized to q7. Without labels it learns the top-1 class of the full
+network, i.e. it is distilled from ip1. The header written holds:
+
+    EXIT1_WT            weights, interleaved for arm_fully_connected_q7_opt
+    EXIT1_BIAS          bias
+    EXIT1_BIAS_LSHIFT   bias left-shift
+    EXIT1_OUT_RSHIFT    right-shift of the accumulators to the q7 scores
+
+arm_softmax_q7 is a base-2 softmax of its q7 inputs, so the scores are
+scaled by log2(e) to give the probabilities the head was trained for.
+
+The quantized head is then checked bit-accurately, together with the exit
+test of CNN_Run, on the calibration set. For a range of thresholds the
+report gives the share of frames that exit, their top-1 agreement with the
+full network (or accuracy with labels) and the agreement of the whole
+pipeline. The largest exit rate whose agreement loss stays within
+--budget percentage points is suggested as EXIT1_THRESHOLD. With --check
+an existing header is only checked.
+
+Procedure:
+    1. Put the CIFAR-10 test images, or frames of the target camera, in
+       calib.npz (images, uint8 N x 32 x 32 x 3 RGB, and labels if known).
+       Use other images than the ones the result is judged on.
+    2. python train_exit_head.py ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_weights.h \\
+           ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_parameter.h calib.npz \\
+           ../../CNN_Project_IPC.cydsn/arm_nnexamples_cifar10_exit_weights.h
+    3. Set EXIT1_THRESHOLD in arm_nnexamples_cifar10_parameter.h to the
+       suggested value and enable CNN_EXIT_HEAD in cnn_cifar10.h.
+"""
+
+import argparse
+import sys
+
+import numpy as np
+
+from prune_model import parse_header, deinterleave_opt, c_array
+from select_precision import preprocess, conv_acc, maxpool, simulate, nn_round, ssat, TENSORS
+
+LOG2E = 1.4426950408889634
+
+
+def pool2_features(images, p):
+    """q7 pool2 output of CNN_Run, flattened in HWC order."""
+    act = preprocess(images, p, 0, 8)
+    for name in ('CONV1', 'CONV2'):
+        n = name[-1]
+        os_ = p[name + '_OUT_RSHIFT']
+        acc = conv_acc(act, p[name + '_WT'], p[name + '_BIAS'], p[name + '_KER_DIM'],
+                       p[name + '_PADDING'], p[name + '_STRIDE'], p[name + '_BIAS_LSHIFT'])
+        out = np.maximum(ssat((acc + nn_round(os_)) >> os_, 8), 0)
+        act = maxpool(out, p['POOL%s_KER_DIM' % n], p['POOL%s_PADDING' % n],
+                      p['POOL%s_STRIDE' % n], p['POOL%s_OUT_DIM' % n])
+    return act.reshape(act.shape[0], -1)
+
+
+def fit(x, target, classes, epochs, l2):
+    """Softmax regression by gradient descent with Adam, returns (W, b) for x / 128."""
+    x = x / 128.0
+    n, dim = x.shape
+    w = np.zeros((classes, dim))
+    b = np.zeros(classes)
+    onehot = np.eye(classes)[target]
+    mw, vw, mb, vb = 0.0, 0.0, 0.0, 0.0
+    rate, beta1, beta2 = 0.01, 0.9, 0.999
+    for t in range(1, epochs + 1):
+        z = x @ w.T + b
+        z -= z.max(axis=1, keepdims=True)
+        prob = np.exp(z)
+        prob /= prob.sum(axis=1, keepdims=True)
+        err = (prob - onehot) / n
+        gw = err.T @ x + l2 * w
+        gb = err.sum(axis=0)
+        mw = beta1 * mw + (1 - beta1) * gw
+        vw = beta2 * vw + (1 - beta2) * gw * gw
+        mb = beta1 * mb + (1 - beta1) * gb
+        vb = beta2 * vb + (1 - beta2) * gb * gb
+        corr = np.sqrt(1 - beta2 ** t) / (1 - beta1 ** t)
+        w -= rate * corr * mw / (np.sqrt(vw) + 1e-8)
+        b -= rate * corr * mb / (np.sqrt(vb) + 1e-8)
+    return w / 128.0, b
+
+
+def quantize(w, b):
+    """q7 weights, bias and shifts of the head, the scores in log2 units."""
+    w = w * LOG2E
+    b = b * LOG2E
+    # the most fractional bits of the accumulators that keep the weights in q7
+    out_rshift = 0
+    while out_rshift < 24 and np.abs(w).max() * 2 ** (out_rshift + 1) <= 127.5:
+        out_rshift += 1
+    wq = np.clip(np.rint(w * 2 ** out_rshift), -128, 127).astype(np.int64)
+    # the fewest bias left-shift bits that keep the bias in q7
+    bacc = b * 2 ** out_rshift
+    bias_lshift = 0
+    while np.abs(bacc).max() / 2 ** bias_lshift > 127.5:
+        bias_lshift += 1
+    bq = np.clip(np.rint(bacc / 2 ** bias_lshift), -128, 127).astype(np.int64)
+    return wq, bq, bias_lshift, out_rshift
+
+
+def interleave_opt(m):
+    """Interleaves a row-major matrix for arm_fully_connected_q7_opt, see deinterleave_opt."""
+    rows, cols = len(m), len(m[0])
+    wt = []
+    r = 0
+    while r + 4 <= rows:
+        c = 0
+        while c + 4 <= cols:
+            # | a11 a21 a13 a23 a31 a41 a33 a43 | a12 a22 a14 a24 a32 a42 a34 a44 |
+            for half in (0, 1):
+                for pair in (0, 2):
+                    for cc in (0, 2):
+                        for rr in (0, 1):
+                            wt.append(m[r + pair + rr][c + half + cc])
+            c += 4
+        # left-over columns are in-order over the 4 rows
+        while c < cols:
+            for rr in range(4):
+                wt.append(m[r + rr][c])
+            c += 1
+        r += 4
+    # left-over rows are stored as they are
+    while r < rows:
+        wt.extend(m[r])
+        r += 1
+    return wt
+
+
+def softmax_q7(v):
+    """arm_softmax_q7 on rows of q7 values."""
+    v = v.astype(np.int64)
+    base = np.maximum(v.max(axis=1, keepdims=True), -257) - 8
+    above = v > base
+    total = np.where(above, 1 << np.clip(v - base, 0, 31), 0).sum(axis=1, keepdims=True)
+    out_base = 0x100000 // total
+    shift = np.clip(13 + base - v, 0, 31)
+    return np.where(above, ssat(out_base >> shift, 8), 0)
+
+
+def head_probs(x, wq, bq, bias_lshift, out_rshift):
+    """arm_fully_connected_q7_opt_q31 + arm_softmax_q31_q7 of CNN_Run."""
+    acc = np.rint(x.astype(np.float64) @ wq.astype(np.float64).T).astype(np.int64)
+    acc += bq << bias_lshift
+    scores = ssat((acc + nn_round(out_rshift)) >> out_rshift, 8)
+    return acc, softmax_q7(scores)
+
+
+def report(acc, prob, full, target, threshold, budget):
+    """Prints the exit rate and agreement per threshold, returns the suggested one."""
+    exit_cls = acc.argmax(axis=1)
+    conf = prob.max(axis=1)
+    ref = 100.0 * np.mean(full == target)
+    # the exit test of CNN_Run: the largest output reaches the threshold
+    if conf.max() >= 128:
+        sys.exit('softmax output of 128: a threshold of 128 would not disable the exit')
+    best = None
+    print('threshold  exit  exited ok   overall  (full network %.2f%%)' % ref)
+    for t in sorted(set(list(range(0, 128, 8)) + [threshold, 127, 128])):
+        taken = conf >= t
+        cls = np.where(taken, exit_cls, full)
+        overall = 100.0 * np.mean(cls == target)
+        exited = 100.0 * np.mean(exit_cls[taken] == target[taken]) if taken.any() else 0.0
+        mark = '  EXIT1_THRESHOLD' if t == threshold else ''
+        print('%9d %5.1f%% %9.2f%% %8.2f%%%s' % (t, 100.0 * taken.mean(), exited, overall, mark))
+        if overall >= ref - budget and t < 128 and (best is None or taken.mean() > best[1]):
+            best = (t, taken.mean())
+    return best[0] if best else 128
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Early-exit head of the CIFAR-10 model')
+    parser.add_argument('weights', help='weight header')
+    parser.add_argument('parameters', help='parameter header')
+    parser.add_argument('calibration', help='.npz with images (N x 32 x 32 x 3 uint8) and optionally labels')
+    parser.add_argument('output', help='exit head header to write, or to read with --check')
+    parser.add_argument('--check', action='store_true', help='only check the head of the output header')
+    parser.add_argument('--budget', type=float, default=1.0,
+                        help='agreement loss allowed against the full network, in percentage points (default 1)')
+    parser.add_argument('--epochs', type=int, default=500, help='gradient descent steps (default 500)')
+    parser.add_argument('--l2', type=float, default=1e-3, help='weight decay (default 1e-3)')
+    args = parser.parse_args()
+
+    p = parse_header(args.parameters)
+    p.update(parse_header(args.weights))
+    p['IP1_DIM'] = p['POOL3_OUT_DIM'] ** 2 * p['CONV3_OUT_CH']
+    p['EXIT1_DIM'] = p['POOL2_OUT_DIM'] ** 2 * p['CONV2_OUT_CH']
+    calib = np.load(args.calibration)
+    images = calib['images']
+    if images.shape[1:] != (32, 32, 3):
+        sys.exit('calibration images must be N x 32 x 32 x 3')
+
+    ip1_m = deinterleave_opt(p['IP1_WT'], p['IP1_OUT'], p['IP1_DIM'])
+    scores = simulate(images, p, (False,) * 4, dict.fromkeys(TENSORS, 0), ip1_m)[0]
+    full = scores.argmax(axis=1)
+    target = calib['labels'].astype(np.int64) if 'labels' in calib else full
+    x = pool2_features(images, p)
+
+    if args.check:
+        h = parse_header(args.output)
+        wq = np.array(deinterleave_opt(h['EXIT1_WT'], p['EXIT1_OUT'], p['EXIT1_DIM']), dtype=np.int64)
+        bq = np.array(h['EXIT1_BIAS'], dtype=np.int64)
+        bias_lshift, out_rshift = h['EXIT1_BIAS_LSHIFT'], h['EXIT1_OUT_RSHIFT']
+    else:
+        w, b = fit(x, target, p['EXIT1_OUT'], args.epochs, args.l2)
+        wq, bq, bias_lshift, out_rshift = quantize(w, b)
+        wt = interleave_opt(wq.tolist())
+        if deinterleave_opt(wt, p['EXIT1_OUT'], p['EXIT1_DIM']) != wq.tolist():
+            sys.exit('interleaving does not round-trip')
+
+    acc, prob = head_probs(x, wq, bq, bias_lshift, out_rshift)
+    best = report(acc, prob, full, target, p['EXIT1_THRESHOLD'], args.budget)
+    print('suggested EXIT1_THRESHOLD: %d' % best)
+    if args.check:
+        return
+
+    out = ['/* Generated by NN/Scripts/train_exit_head.py from %s, %d calibration images */'
+           % (args.weights.replace('\\', '/').split('/')[-1], len(images)), '',
+           '#define EXIT1_WT %s' % c_array(wt), '',
+           '#define EXIT1_BIAS %s' % c_array(bq.tolist()), '',
+           '#define EXIT1_BIAS_LSHIFT %d' % bias_lshift,
+           '#define EXIT1_OUT_RSHIFT %d' % out_rshift, '']
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
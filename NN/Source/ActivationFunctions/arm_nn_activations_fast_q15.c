@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_activations_fast_q15.c
+ * Description:  Q15 neural network activation function using paired table look-up
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores, x86 hosts with SSE2 or AVX2
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+#include "arm_nnfunctions.h"
+
+#if !defined (ARM_MATH_DSP) && defined (__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Acti
+ * @{
+ */
+
+  /**
+   * @brief Q15 neural network activation function using paired table look-up
+   * @param[in,out]   data        pointer to input
+   * @param[in]       size        number of elements
+   * @param[in]       int_width   bit-width of the integer part, assume to be smaller than 3
+   * @param[in]       type        type of activation functions
+   * @return none.
+   *
+   * @details
+   *
+   * Same interpolated look-up as arm_nn_activations_direct_q15(), but two
+   * elements are handled per word on cores with the DSP extension:
+   *
+   * - one AND and one SSUB16 give both fractions and their complements
+   * - each element reads its two neighbouring table entries with a single
+   *   word load
+   * - each interpolation is one SMUAD of that pair with (full - frac, frac)
+   *
+   * Host builds handle eight elements per vector the same way, with PMADDWD
+   * in place of SMUAD. With AVX2 one masked gather reads the eight pairs,
+   * with SSE2 they are read one by one.
+   *
+   * The results are bit-exact with arm_nn_activations_direct_q15().
+   */
+
+void arm_nn_activations_fast_q15(q15_t * data, uint16_t size, uint16_t int_width, arm_nn_activation_type type)
+{
+    q15_t    *pIn = data;
+    q15_t    *pOut = data;
+    uint16_t  shift_size = 8 + 3 - int_width;
+    uint32_t  bit_mask = 0x7FF >> int_width;
+    uint32_t  full_frac = bit_mask + 1;
+    const q15_t *lookup_table;
+    uint16_t  i;
+
+    switch (type)
+    {
+    case ARM_SIGMOID:
+        lookup_table = sigmoidTable_q15;
+        break;
+    case ARM_TANH:
+    default:
+        lookup_table = tanhTable_q15;
+        break;
+    }
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    q31_t     mask2 = __PKHBT(bit_mask, bit_mask, 16);
+    q31_t     full2 = __PKHBT(full_frac, full_frac, 16);
+    /* pairs that cannot be read with one load: after the largest positive entry
+       comes -8, so it is paired with itself, and the entry just below zero is
+       followed by the first one */
+    q31_t     pair_top = __PKHBT(lookup_table[0x7F], lookup_table[0x7F], 16);
+#ifndef ARM_MATH_BIG_ENDIAN
+    q31_t     pair_wrap = __PKHBT(lookup_table[0xFF], lookup_table[0x00], 16);
+#else
+    q31_t     pair_wrap = __PKHBT(lookup_table[0x00], lookup_table[0xFF], 16);
+#endif
+
+    i = size >> 1;
+    while (i)
+    {
+        q31_t     in = *__SIMD32(pIn)++;
+        q31_t     frac2 = in & mask2;
+        q31_t     comp2 = __SSUB16(full2, frac2);
+        uint8_t   idx_lo = (uint8_t) ((q15_t) in >> shift_size);
+        uint8_t   idx_hi = (uint8_t) (in >> (16 + shift_size));
+        q31_t     pair_lo, pair_hi;
+        q31_t     coef_lo, coef_hi;
+        q31_t     out_lo, out_hi;
+
+#ifndef ARM_MATH_BIG_ENDIAN
+        coef_lo = __PKHBT(comp2, frac2, 16);
+        coef_hi = __PKHTB(frac2, comp2, 16);
+#else
+        coef_lo = __PKHBT(frac2, comp2, 16);
+        coef_hi = __PKHTB(comp2, frac2, 16);
+#endif
+
+        if ((idx_lo & 0x7F) != 0x7F)
+        {
+            pair_lo = *__SIMD32_CONST(lookup_table + idx_lo);
+        }
+        else
+        {
+            pair_lo = (idx_lo == 0x7F) ? pair_top : pair_wrap;
+        }
+        if ((idx_hi & 0x7F) != 0x7F)
+        {
+            pair_hi = *__SIMD32_CONST(lookup_table + idx_hi);
+        }
+        else
+        {
+            pair_hi = (idx_hi == 0x7F) ? pair_top : pair_wrap;
+        }
+
+        out_lo = __SMUAD(pair_lo, coef_lo) >> shift_size;
+        out_hi = __SMUAD(pair_hi, coef_hi) >> shift_size;
+
+        *__SIMD32(pOut)++ = __PKHBT(out_lo, out_hi, 16);
+        i--;
+    }
+
+    i = size & 0x1;
+#elif defined (__AVX2__)
+    /* Run the following code on x86 hosts with AVX2 */
+
+    const __m128i shift = _mm_cvtsi32_si128(shift_size);
+    const __m256i mask8 = _mm256_set1_epi32(bit_mask);
+    const __m256i full8 = _mm256_set1_epi32(full_frac);
+    const __m256i byte8 = _mm256_set1_epi32(0xFF);
+    const __m256i edge8 = _mm256_set1_epi32(0x7F);
+    const __m256i ones8 = _mm256_set1_epi32(-1);
+    /* the same pairs as on Cortex-M4 for the entries 0x7F and 0xFF */
+    const __m256i top8 = _mm256_set1_epi32((uint16_t) lookup_table[0x7F] |
+                                            ((uint32_t) (uint16_t) lookup_table[0x7F] << 16));
+    const __m256i wrap8 = _mm256_set1_epi32((uint16_t) lookup_table[0xFF] |
+                                             ((uint32_t) (uint16_t) lookup_table[0x00] << 16));
+
+    i = size >> 3;
+    while (i)
+    {
+        __m256i   in = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) pIn));
+        __m256i   frac = _mm256_and_si256(in, mask8);
+        __m256i   coef = _mm256_or_si256(_mm256_sub_epi32(full8, frac), _mm256_slli_epi32(frac, 16));
+        __m256i   idx = _mm256_and_si256(_mm256_sra_epi32(in, shift), byte8);
+        __m256i   edge = _mm256_cmpeq_epi32(_mm256_and_si256(idx, edge8), edge8);
+        __m256i   pair = _mm256_blendv_epi8(wrap8, top8, _mm256_cmpeq_epi32(idx, edge8));
+        __m256i   out;
+
+        /* the lanes at the edges keep their pair, the others load theirs */
+        pair = _mm256_mask_i32gather_epi32(pair, (const int *) lookup_table, idx,
+                                           _mm256_xor_si256(edge, ones8), 2);
+        out = _mm256_sra_epi32(_mm256_madd_epi16(pair, coef), shift);
+
+        _mm_storeu_si128((__m128i *) pOut, _mm_packs_epi32(_mm256_castsi256_si128(out),
+                                                           _mm256_extracti128_si256(out, 1)));
+        pIn += 8;
+        pOut += 8;
+        i--;
+    }
+
+    i = size & 0x7;
+#elif defined (__SSE2__)
+    /* Run the following code on x86 hosts with SSE2 */
+
+    const __m128i shift = _mm_cvtsi32_si128(shift_size);
+    const __m128i mask8 = _mm_set1_epi16(bit_mask);
+    const __m128i full8 = _mm_set1_epi16(full_frac);
+    const __m128i byte8 = _mm_set1_epi16(0xFF);
+    uint16_t  idx[8];
+    q31_t     pair[8];
+
+    i = size >> 3;
+    while (i)
+    {
+        __m128i   in = _mm_loadu_si128((const __m128i *) pIn);
+        __m128i   frac = _mm_and_si128(in, mask8);
+        __m128i   comp = _mm_sub_epi16(full8, frac);
+        __m128i   out_lo, out_hi;
+        uint16_t  j;
+
+        _mm_storeu_si128((__m128i *) idx, _mm_and_si128(_mm_sra_epi16(in, shift), byte8));
+        for (j = 0; j < 8; j++)
+        {
+            q15_t     value = lookup_table[idx[j]];
+            q15_t     value2 = (idx[j] == 0x7F) ? value : lookup_table[(uint8_t) (idx[j] + 1)];
+
+            pair[j] = (q31_t) ((uint16_t) value | ((uint32_t) (uint16_t) value2 << 16));
+        }
+
+        out_lo = _mm_madd_epi16(_mm_loadu_si128((const __m128i *) pair), _mm_unpacklo_epi16(comp, frac));
+        out_hi = _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (pair + 4)), _mm_unpackhi_epi16(comp, frac));
+
+        _mm_storeu_si128((__m128i *) pOut, _mm_packs_epi32(_mm_sra_epi32(out_lo, shift),
+                                                           _mm_sra_epi32(out_hi, shift)));
+        pIn += 8;
+        pOut += 8;
+        i--;
+    }
+
+    i = size & 0x7;
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    i = size;
+#endif                          /* ARM_MATH_DSP, __AVX2__, __SSE2__ */
+
+    while (i)
+    {
+        q15_t     in = *pIn++;
+        q15_t     frac = (uint32_t) in & bit_mask;
+        uint8_t   idx = (uint8_t) (in >> shift_size);
+        q15_t     value = lookup_table[idx];
+        q15_t     value2 = (idx == 0x7F) ? value : lookup_table[(uint8_t) (idx + 1)];
+
+        *pOut++ = ((q31_t) (full_frac - frac) * value + (q31_t) value2 * frac) >> shift_size;
+        i--;
+    }
+}
+
+/**
+ * @} end of Acti group
+ */
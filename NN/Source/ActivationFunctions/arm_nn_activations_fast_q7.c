@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_activations_fast_q7.c
+ * Description:  Q7 neural network activation function using word-wide table look-up
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores, x86 hosts with SSE2
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+#include "arm_nnfunctions.h"
+
+#if !defined (ARM_MATH_DSP) && defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Acti
+ * @{
+ */
+
+  /**
+   * @brief Q7 neural network activation function using word-wide table look-up
+   * @param[in,out]   data        pointer to input
+   * @param[in]       size        number of elements
+   * @param[in]       int_width   bit-width of the integer part, assume to be smaller than 3
+   * @param[in]       type        type of activation functions
+   * @return none.
+   *
+   * @details
+   *
+   * Same look-up as arm_nn_activations_direct_q7(), but on cores with the
+   * DSP extension four inputs are loaded as one word, the four table indexes
+   * are formed with SHADD8 (a halving add with zero is a per-byte arithmetic
+   * shift by one) and the four results are stored as one word.
+   *
+   * Host builds form sixteen indexes per vector, with a 16-bit logical
+   * shift, a byte mask and a sign extension by XOR and SUB. x86 has no byte
+   * gather, so the look-ups stay scalar, and AVX2 builds take the same path.
+   */
+
+void arm_nn_activations_fast_q7(q7_t * data, uint16_t size, uint16_t int_width, arm_nn_activation_type type)
+{
+    q7_t     *pIn = data;
+    q7_t     *pOut = data;
+    uint16_t  shift_size = 3 - int_width;
+    const q7_t *lookup_table;
+    uint16_t  i;
+
+    switch (type)
+    {
+    case ARM_SIGMOID:
+        lookup_table = sigmoidTable_q7;
+        break;
+    case ARM_TANH:
+    default:
+        lookup_table = tanhTable_q7;
+        break;
+    }
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    i = size >> 2;
+    while (i)
+    {
+        q31_t     in = *__SIMD32(pIn)++;
+        uint16_t  shift = shift_size;
+
+        while (shift)
+        {
+            in = __SHADD8(in, 0);
+            shift--;
+        }
+
+        /* every byte goes back to the lane it came from, so this is endian neutral */
+        *__SIMD32(pOut)++ = (q31_t) ((uint32_t) (uint8_t) lookup_table[(uint8_t) in] |
+                                     ((uint32_t) (uint8_t) lookup_table[(uint8_t) (in >> 8)] << 8) |
+                                     ((uint32_t) (uint8_t) lookup_table[(uint8_t) (in >> 16)] << 16) |
+                                     ((uint32_t) (uint8_t) lookup_table[(uint8_t) (in >> 24)] << 24));
+        i--;
+    }
+
+    i = size & 0x3;
+#elif defined (__SSE2__)
+    /* Run the following code on x86 hosts with SSE2 */
+
+    const __m128i shift = _mm_cvtsi32_si128(shift_size);
+    const __m128i keep16 = _mm_set1_epi8((char) (0xFF >> shift_size));
+    const __m128i sign16 = _mm_set1_epi8((char) (0x80 >> shift_size));
+    uint8_t   idx[16];
+
+    i = size >> 4;
+    while (i)
+    {
+        __m128i   in = _mm_loadu_si128((const __m128i *) pIn);
+        uint16_t  j;
+
+        /* per-byte arithmetic shift: the sign bit lands at 0x80 >> shift_size */
+        in = _mm_and_si128(_mm_srl_epi16(in, shift), keep16);
+        in = _mm_sub_epi8(_mm_xor_si128(in, sign16), sign16);
+        _mm_storeu_si128((__m128i *) idx, in);
+
+        for (j = 0; j < 16; j++)
+        {
+            pOut[j] = lookup_table[idx[j]];
+        }
+        pIn += 16;
+        pOut += 16;
+        i--;
+    }
+
+    i = size & 0xF;
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    i = size;
+#endif                          /* ARM_MATH_DSP, __SSE2__ */
+
+    while (i)
+    {
+        q7_t      in = *pIn++;
+
+        *pOut++ = lookup_table[(uint8_t) (in >> shift_size)];
+        i--;
+    }
+}
+
+/**
+ * @} end of Acti group
+ */
@@ -84,8 +84,11 @@ void arm_nn_activations_direct_q15(q15_t * data, uint16_t size, uint16_t int_wid
         q15_t     out;
         q15_t     in = *pIn++;
         q15_t     frac = (uint32_t) in & bit_mask;
-        q15_t     value = lookup_table[__USAT(in >> shift_size, 8)];
-        q15_t     value2 = lookup_table[__USAT(1 + (in >> shift_size), 8)];
+        /* the table is indexed with the two's complement byte, as in the q7 version */
+        uint8_t   idx = (uint8_t) (in >> shift_size);
+        q15_t     value = lookup_table[idx];
+        /* the entry after the largest positive one is -8, keep the last value instead */
+        q15_t     value2 = (idx == 0x7F) ? value : lookup_table[(uint8_t) (idx + 1)];
 
         /* doing the interpolation here for better accuracy */
         out = ((q31_t) (full_frac - frac) * value + (q31_t) value2 * frac) >> shift_size;
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_relu_q7_bitmap.c
+ * Description:  Q7 ReLU function writing a bitmap tensor
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Acti
+ * @{
+ */
+
+  /**
+   * @brief Q7 RELU function with a bitmap tensor output
+   * @param[in,out]   data        pointer to input, a HWC tensor of out->dim x out->dim x out->ch
+   * @param[in,out]   out         bitmap tensor set up with arm_nn_bitmap_init_q7
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   * 
+   * @details
+   *
+   * Each row is rectified in place by arm_relu_q7 and appended to out, the
+   * values that ReLU zeroes take one bit of storage. The input is left
+   * rectified, ARM_MATH_SIZE_MISMATCH is returned when the non-zero values
+   * do not fit in out.
+   *
+   */
+
+arm_status arm_relu_q7_to_bitmap(q7_t * data,
+                                 arm_nn_bitmap_q7 * out)
+{
+    uint16_t  row_len = out->dim * out->ch;
+    uint16_t  i_y;
+
+    for (i_y = 0; i_y < out->dim; i_y++)
+    {
+        q7_t     *row = data + i_y * row_len;
+
+        arm_relu_q7(row, row_len);
+        if (arm_nn_bitmap_put_row_q7(out, i_y, row) != ARM_MATH_SUCCESS)
+        {
+            return ARM_MATH_SIZE_MISMATCH;
+        }
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of Acti group
+ */
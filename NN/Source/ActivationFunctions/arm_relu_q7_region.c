@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_relu_q7_region.c
+ * Description:  Q7 ReLU restricted to a region of a HWC tensor
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Acti
+ * @{
+ */
+
+  /**
+   * @brief Q7 RELU function restricted to a region of a HWC tensor
+   * @param[in,out]   data        pointer to input
+   * @param[in]       dim_im      tensor dimension
+   * @param[in]       ch_im       number of tensor channels
+   * @param[in]       region      region of the tensor to process
+   * @return none.
+   * 
+   * @details
+   *
+   * Each row of the region is contiguous in HWC layout and is handed
+   * to arm_relu_q7.
+   *
+   */
+
+void arm_relu_q7_region(q7_t * data,
+                        const uint16_t dim_im,
+                        const uint16_t ch_im,
+                        const arm_nn_rect * region)
+{
+    int16_t   i_y;
+
+    for (i_y = region->y0; i_y < region->y1; i_y++)
+    {
+        arm_relu_q7(data + (i_y * dim_im + region->x0) * ch_im, (region->x1 - region->x0) * ch_im);
+    }
+}
+
+/**
+ * @} end of Acti group
+ */
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_convolve_HWC_mat_q7_im_q15.c
+ * Description:  Mixed Q7-Q15 convolution function
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Q7-Q15 convolution function, q15 activations and q7 weights
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size: ch_im_in*dim_kernel*dim_kernel
+   *
+   * bufferB size: 0
+   *
+   * Takes the same weights and bias as arm_convolve_HWC_q7_basic, so a
+   * q7 layer can be moved to q15 activations without new weights. If the
+   * input carries f more fractional bits than the q7 one would, the
+   * accumulator does too: add f to bias_shift and to out_shift to get the
+   * q7 result, or add f - g to out_shift to keep g extra bits in the
+   * q15 output.
+   *
+   * This basic version is designed to work for any input tensor and weight
+   * dimension.
+   */
+
+arm_status
+arm_convolve_HWC_mat_q7_im_q15(const q15_t * Im_in,
+                               const uint16_t dim_im_in,
+                               const uint16_t ch_im_in,
+                               const q7_t * wt,
+                               const uint16_t ch_im_out,
+                               const uint16_t dim_kernel,
+                               const uint16_t padding,
+                               const uint16_t stride,
+                               const q7_t * bias,
+                               const uint16_t bias_shift,
+                               const uint16_t out_shift,
+                               q15_t * Im_out,
+                               const uint16_t dim_im_out,
+                               q15_t * bufferA,
+                               q7_t * bufferB)
+{
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    int16_t   i_out_y, i_out_x, i_ker_y, i_ker_x;
+    const uint16_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    q15_t    *pBuffer = bufferA;
+    q15_t    *pOut = Im_out;
+    const q7_t *pA;
+    const q7_t *pBias;
+    uint16_t  rowCnt;
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            /* im2col, the input is already q15 so this is a plain copy */
+            for (i_ker_y = i_out_y * stride - padding; i_ker_y < i_out_y * stride - padding + dim_kernel; i_ker_y++)
+            {
+                for (i_ker_x = i_out_x * stride - padding; i_ker_x < i_out_x * stride - padding + dim_kernel; i_ker_x++)
+                {
+                    if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                    {
+                        /* Filling 0 for out-of-bound paddings */
+                        memset(pBuffer, 0, sizeof(q15_t) * ch_im_in);
+                    } else
+                    {
+                        memcpy(pBuffer, (q15_t *) Im_in + (i_ker_y * dim_im_in + i_ker_x) * ch_im_in,
+                               sizeof(q15_t) * ch_im_in);
+                    }
+                    pBuffer += ch_im_in;
+                }
+            }
+
+            /* two filters at a time share the loads of the column */
+            pA = wt;
+            pBias = bias;
+            rowCnt = ch_im_out >> 1;
+            while (rowCnt)
+            {
+                const q7_t *pA2 = pA + numCol;
+                const q15_t *pB = bufferA;
+                q31_t     sum =  ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+                q31_t     sum2 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+                uint16_t  colCnt = numCol >> 2;
+
+                while (colCnt)
+                {
+                    q31_t     inA11, inA12, inA21, inA22;
+                    q31_t     inB1 = *__SIMD32(pB)++;
+                    q31_t     inB2 = *__SIMD32(pB)++;
+
+                    pA = (q7_t *) read_and_pad((void *)pA, &inA11, &inA12);
+                    pA2 = (q7_t *) read_and_pad((void *)pA2, &inA21, &inA22);
+
+                    sum = __SMLAD(inA11, inB1, sum);
+                    sum2 = __SMLAD(inA21, inB1, sum2);
+                    sum = __SMLAD(inA12, inB2, sum);
+                    sum2 = __SMLAD(inA22, inB2, sum2);
+
+                    colCnt--;
+                }
+                colCnt = numCol & 0x3;
+                while (colCnt)
+                {
+                    q15_t     inB1 = *pB++;
+                    sum += *pA++ * inB1;
+                    sum2 += *pA2++ * inB1;
+                    colCnt--;
+                }
+                *pOut++ = (q15_t) __SSAT((sum >> out_shift), 16);
+                *pOut++ = (q15_t) __SSAT((sum2 >> out_shift), 16);
+
+                /* skip the row computed with pA2 */
+                pA += numCol;
+                rowCnt--;
+            }
+
+            if (ch_im_out & 0x1)
+            {
+                const q15_t *pB = bufferA;
+                q31_t     sum = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+                uint16_t  colCnt = numCol >> 2;
+
+                while (colCnt)
+                {
+                    q31_t     inA11, inA12;
+                    q31_t     inB1 = *__SIMD32(pB)++;
+                    q31_t     inB2 = *__SIMD32(pB)++;
+
+                    pA = (q7_t *) read_and_pad((void *)pA, &inA11, &inA12);
+
+                    sum = __SMLAD(inA11, inB1, sum);
+                    sum = __SMLAD(inA12, inB2, sum);
+
+                    colCnt--;
+                }
+                colCnt = numCol & 0x3;
+                while (colCnt)
+                {
+                    sum += *pA++ * *pB++;
+                    colCnt--;
+                }
+                *pOut++ = (q15_t) __SSAT((sum >> out_shift), 16);
+            }
+
+            /* counter reset */
+            pBuffer = bufferA;
+        }
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+    int       i, j, k, l, m, n;
+    int       conv_out;
+    int       in_row, in_col;
+
+    for (i = 0; i < ch_im_out; i++)
+    {
+        for (j = 0; j < dim_im_out; j++)
+        {
+            for (k = 0; k < dim_im_out; k++)
+            {
+                conv_out = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+                for (m = 0; m < dim_kernel; m++)
+                {
+                    for (n = 0; n < dim_kernel; n++)
+                    {
+                        in_row = stride * j + m - padding;
+                        in_col = stride * k + n - padding;
+                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in && in_col < dim_im_in)
+                        {
+                            for (l = 0; l < ch_im_in; l++)
+                            {
+                                conv_out +=
+                                    Im_in[(in_row * dim_im_in + in_col) * ch_im_in +
+                                          l] * wt[i * ch_im_in * dim_kernel * dim_kernel + (m * dim_kernel +
+                                                                                            n) * ch_im_in + l];
+                            }
+                        }
+                    }
+                }
+                Im_out[i + (j * dim_im_out + k) * ch_im_out] = (q15_t) __SSAT((conv_out >> out_shift), 16);
+            }
+        }
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_convolve_HWC_q7_fast_bitmap.c
+ * Description:  Fast Q7 convolution with fused activation reading a bitmap tensor
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/*
+ * Expands into the window the input rows [row_first, row_first + dim_kernel)
+ * that it does not hold yet. Row r goes to slot r % dim_kernel and the rows
+ * come in increasing order, so the slots of the rows still needed are kept.
+ */
+static void load_window_rows_q7(const arm_nn_bitmap_q7 * Im_in,
+                                q7_t * window,
+                                const int16_t row_first,
+                                const uint16_t dim_kernel,
+                                int16_t * next_row)
+{
+    int16_t   r = row_first > *next_row ? row_first : *next_row;
+
+    if (r < 0)
+    {
+        r = 0;
+    }
+    for (; r < row_first + dim_kernel && r < Im_in->dim; r++)
+    {
+        arm_nn_bitmap_get_row_q7(Im_in, r, window + (r % dim_kernel) * Im_in->dim * Im_in->ch);
+    }
+    *next_row = r;
+}
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+  /**
+   * @brief Fast Q7 convolution function with fused activation and a bitmap tensor input
+   * @param[in]       Im_in       input tensor, written by a bitmap ReLU or pooling
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input 
+   * @param[in,out]   bufferB     pointer to buffer space for the input row window
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size: 2*ch_im_in*dim_kernel*dim_kernel
+   *
+   * bufferB size: dim_kernel*dim_im_in*ch_im_in
+   *
+   * with dim_im_in and ch_im_in the dimension and channels of Im_in.
+   *
+   * <b>Input dimension constraints:</b>
+   *
+   * ch_im_in is multiple of 4    ( because of the SIMD32 read and swap )
+   *
+   * ch_im_out is multipe of 2    ( bacause 2x2 mat_mult kernel )
+   *
+   * Same result as arm_convolve_HWC_q7_fast_act() on the dense input. Only
+   * the dim_kernel input rows an output row depends on are expanded, into
+   * a ring of rows in bufferB, each input row once. The im2col and
+   * arm_nn_mat_mult_kernel_q7_q15_reordered_act() then run on the window
+   * as on a dense tensor.
+   */
+
+arm_status
+arm_convolve_HWC_q7_fast_bitmap(const arm_nn_bitmap_q7 * Im_in,
+                                const q7_t * wt,
+                                const uint16_t ch_im_out,
+                                const uint16_t dim_kernel,
+                                const uint16_t padding,
+                                const uint16_t stride,
+                                const q7_t * bias,
+                                const uint16_t bias_shift,
+                                const uint16_t out_shift,
+                                const arm_nn_act * act,
+                                q7_t * Im_out,
+                                const uint16_t dim_im_out,
+                                q15_t * bufferA,
+                                q7_t * bufferB)
+{
+    const uint16_t dim_im_in = Im_in->dim;
+    const uint16_t ch_im_in = Im_in->ch;
+    const uint16_t row_len = dim_im_in * ch_im_in;
+    int16_t   next_row = 0;
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    int16_t   i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t   in_row, in_col;
+
+    /*
+     *  Here we use bufferA as q15_t internally as computation are done with q15_t level
+     *  im2col are done to output in q15_t format from q7_t input
+     */
+
+    q15_t    *pBuffer = bufferA;
+    q7_t     *pOut = Im_out;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 2 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        load_window_rows_q7(Im_in, bufferB, i_out_y * stride - padding, dim_kernel, &next_row);
+
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            /* This part implements the im2col function on the window */
+            for (i_ker_y = 0; i_ker_y < dim_kernel; i_ker_y++)
+            {
+                const q7_t *pRow;
+
+                in_row = i_out_y * stride - padding + i_ker_y;
+                if (in_row < 0 || in_row >= dim_im_in)
+                {
+                    memset(pBuffer, 0, sizeof(q15_t) * ch_im_in * dim_kernel);
+                    pBuffer += ch_im_in * dim_kernel;
+                    continue;
+                }
+                pRow = bufferB + (in_row % dim_kernel) * row_len;
+
+                for (i_ker_x = 0; i_ker_x < dim_kernel; i_ker_x++)
+                {
+                    in_col = i_out_x * stride - padding + i_ker_x;
+                    if (in_col < 0 || in_col >= dim_im_in)
+                    {
+                        /* arm_fill_q15(0, pBuffer, ch_im_in); */
+                        memset(pBuffer, 0, sizeof(q15_t)*ch_im_in);
+                    } else
+                    {
+                        arm_q7_to_q15_reordered_no_shift((q7_t *) pRow + in_col * ch_im_in, pBuffer, ch_im_in);
+                    }
+                    pBuffer += ch_im_in;
+                }
+            }
+
+            if (pBuffer == bufferA + 2 * ch_im_in * dim_kernel * dim_kernel)
+            {
+                pOut = arm_nn_mat_mult_kernel_q7_q15_reordered_act(wt, bufferA, ch_im_out, ch_im_in * dim_kernel * dim_kernel,
+                                                                   bias_shift, out_shift, bias, act, pOut);
+                /* counter reset */
+                pBuffer = bufferA;
+            }
+        }
+    }
+
+    /* check if there is left-over for compute */
+    if (pBuffer != bufferA)
+    {
+        const q7_t *pA = wt;
+        int       i;
+
+        for (i = 0; i < ch_im_out; i++)
+        {
+            q31_t     sum = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+            q15_t    *pB = bufferA;
+            /* each time it process 4 entries */
+            uint16_t  colCnt = ch_im_in * dim_kernel * dim_kernel >> 2;
+
+            while (colCnt)
+            {
+
+                q31_t     inA1, inA2;
+                q31_t     inB1, inB2;
+
+                pA = (q7_t *) read_and_pad_reordered((void *)pA, &inA1, &inA2);
+
+                inB1 = *__SIMD32(pB)++;
+                sum = __SMLAD(inA1, inB1, sum);
+                inB2 = *__SIMD32(pB)++;
+                sum = __SMLAD(inA2, inB2, sum);
+
+                colCnt--;
+            }
+            colCnt = ch_im_in * dim_kernel * dim_kernel & 0x3;
+            while (colCnt)
+            {
+                q7_t      inA1 = *pA++;
+                q15_t     inB1 = *pB++;
+                sum += inA1 * inB1;
+                colCnt--;
+            }
+            *pOut = (q7_t) __SSAT(arm_nn_activate(sum >> out_shift, act), 8);
+            pOut++;
+
+        }
+
+    }
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    uint16_t  i, j, k, l, m, n;
+    int       conv_out;
+    signed char in_row, in_col;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 2 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (j = 0; j < dim_im_out; j++)
+    {
+        load_window_rows_q7(Im_in, bufferB, stride * j - padding, dim_kernel, &next_row);
+
+        for (k = 0; k < dim_im_out; k++)
+        {
+            for (i = 0; i < ch_im_out; i++)
+            {
+                conv_out = (bias[i] << bias_shift) + NN_ROUND(out_shift);
+                for (m = 0; m < dim_kernel; m++)
+                {
+                    for (n = 0; n < dim_kernel; n++)
+                    {
+                        // if-for implementation
+                        in_row = stride * j + m - padding;
+                        in_col = stride * k + n - padding;
+                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in && in_col < dim_im_in)
+                        {
+                            for (l = 0; l < ch_im_in; l++)
+                            {
+                                conv_out +=
+                                    bufferB[(in_row % dim_kernel) * row_len + in_col * ch_im_in +
+                                            l] * wt[i * ch_im_in * dim_kernel * dim_kernel + (m * dim_kernel +
+                                                                                              n) * ch_im_in + l];
+                            }
+                        }
+                    }
+                }
+                Im_out[i + (j * dim_im_out + k) * ch_im_out] = (q7_t) __SSAT(arm_nn_activate(conv_out >> out_shift, act), 8);
+            }
+        }
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_convolve_HWC_q7_fast_zero_skip.c
+ * Description:  Q7 convolution with fused activation that skips zero input channel groups
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+  /**
+   * @brief Q7 convolution function with fused activation that skips zero inputs
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input 
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size: 2*ch_im_in*dim_kernel*dim_kernel
+   *
+   * bufferB size: 0
+   *
+   * <b>Input dimension constraints:</b>
+   *
+   * ch_im_in is multiple of 4    ( because of the SIMD32 read )
+   *
+   * ch_im_out is multipe of 2    ( because two filters share the gathered inputs )
+   *
+   * Same result as arm_convolve_HWC_q7_fast_act(). After a ReLU, and more
+   * so after a max pooling, many input pixels have whole groups of four
+   * channels at zero. Instead of the im2col column, the receptive field of
+   * each output pixel is gathered as a list of its non-zero groups of four
+   * channels, tested with one word compare, expanded to q15 with their
+   * offset in the column. Zero groups and padding cost no MAC and their
+   * weights are not read.
+   *
+   * The filters are computed two at a time on the list, one output pixel
+   * at a time, so the kernel only beats the 2x2 blocked
+   * arm_nn_mat_mult_kernel_q7_q15_reordered_act() when a large part of
+   * the groups are zero. arm_nn_zero_groups_q7() measures that fraction
+   * on the actual data.
+   */
+
+arm_status
+arm_convolve_HWC_q7_fast_zero_skip(const q7_t * Im_in,
+                                   const uint16_t dim_im_in,
+                                   const uint16_t ch_im_in,
+                                   const q7_t * wt,
+                                   const uint16_t ch_im_out,
+                                   const uint16_t dim_kernel,
+                                   const uint16_t padding,
+                                   const uint16_t stride,
+                                   const q7_t * bias,
+                                   const uint16_t bias_shift,
+                                   const uint16_t out_shift,
+                                   const arm_nn_act * act,
+                                   q7_t * Im_out,
+                                   const uint16_t dim_im_out,
+                                   q15_t * bufferA,
+                                   q7_t * bufferB)
+{
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    int16_t   i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t   in_row, in_col;
+    uint16_t  i, k, i_ch, nnz;
+    const uint16_t colLen = ch_im_in * dim_kernel * dim_kernel;
+
+    /*
+     *  bufferA holds, for the current output pixel, the non-zero groups of
+     *  four input channels expanded to two q31_t words each, followed by
+     *  their offsets in the im2col column
+     */
+
+    q31_t    *pVal = (q31_t *) bufferA;
+    uint16_t *pOff = (uint16_t *) (bufferA + colLen);
+    q7_t     *pOut = Im_out;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 2 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            const q7_t *pA = wt;
+
+            /* gather the non-zero channel groups, the padding is skipped as well */
+            nnz = 0;
+            for (i_ker_y = 0; i_ker_y < dim_kernel; i_ker_y++)
+            {
+                in_row = i_out_y * stride - padding + i_ker_y;
+                if (in_row < 0 || in_row >= dim_im_in)
+                {
+                    continue;
+                }
+                for (i_ker_x = 0; i_ker_x < dim_kernel; i_ker_x++)
+                {
+                    const q7_t *pIn;
+                    uint16_t  off;
+
+                    in_col = i_out_x * stride - padding + i_ker_x;
+                    if (in_col < 0 || in_col >= dim_im_in)
+                    {
+                        continue;
+                    }
+                    pIn = Im_in + (in_row * dim_im_in + in_col) * ch_im_in;
+                    off = (i_ker_y * dim_kernel + i_ker_x) * ch_im_in;
+
+                    for (i_ch = 0; i_ch < ch_im_in; i_ch += 4)
+                    {
+                        if (*__SIMD32_CONST(pIn + i_ch) != 0)
+                        {
+                            read_and_pad_reordered((void *)(pIn + i_ch), &pVal[2 * nnz], &pVal[2 * nnz + 1]);
+                            pOff[nnz] = off + i_ch;
+                            nnz++;
+                        }
+                    }
+                }
+            }
+
+            /* two filters at a time over the gathered groups */
+            for (i = 0; i < ch_im_out; i += 2)
+            {
+                const q7_t *pA2 = pA + colLen;
+                q31_t     sum = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+                q31_t     sum2 = ((q31_t)bias[i + 1] << bias_shift) + NN_ROUND(out_shift);
+
+                for (k = 0; k < nnz; k++)
+                {
+                    q31_t     inA1, inA2;
+                    q31_t     inB1 = pVal[2 * k];
+                    q31_t     inB2 = pVal[2 * k + 1];
+
+                    read_and_pad_reordered((void *)(pA + pOff[k]), &inA1, &inA2);
+                    sum = __SMLAD(inA1, inB1, sum);
+                    sum = __SMLAD(inA2, inB2, sum);
+
+                    read_and_pad_reordered((void *)(pA2 + pOff[k]), &inA1, &inA2);
+                    sum2 = __SMLAD(inA1, inB1, sum2);
+                    sum2 = __SMLAD(inA2, inB2, sum2);
+                }
+
+                *pOut++ = (q7_t) __SSAT(arm_nn_activate(sum >> out_shift, act), 8);
+                *pOut++ = (q7_t) __SSAT(arm_nn_activate(sum2 >> out_shift, act), 8);
+
+                pA += 2 * colLen;
+            }
+        }
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    uint16_t  i, j, k, l, m, n;
+    int       conv_out;
+    signed char in_row, in_col;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 2 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i = 0; i < ch_im_out; i++)
+    {
+        for (j = 0; j < dim_im_out; j++)
+        {
+            for (k = 0; k < dim_im_out; k++)
+            {
+                conv_out = (bias[i] << bias_shift) + NN_ROUND(out_shift);
+                for (m = 0; m < dim_kernel; m++)
+                {
+                    for (n = 0; n < dim_kernel; n++)
+                    {
+                        // if-for implementation
+                        in_row = stride * j + m - padding;
+                        in_col = stride * k + n - padding;
+                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in && in_col < dim_im_in)
+                        {
+                            const q7_t *pIn = Im_in + (in_row * dim_im_in + in_col) * ch_im_in;
+                            const q7_t *pW = wt + i * ch_im_in * dim_kernel * dim_kernel + (m * dim_kernel + n) * ch_im_in;
+
+                            for (l = 0; l < ch_im_in; l += 4)
+                            {
+                                /* skip the all-zero groups of four channels */
+                                if (*__SIMD32_CONST(pIn + l) == 0)
+                                {
+                                    continue;
+                                }
+                                conv_out += pIn[l] * pW[l] + pIn[l + 1] * pW[l + 1] +
+                                    pIn[l + 2] * pW[l + 2] + pIn[l + 3] * pW[l + 3];
+                            }
+                        }
+                    }
+                }
+                Im_out[i + (j * dim_im_out + k) * ch_im_out] = (q7_t) __SSAT(arm_nn_activate(conv_out >> out_shift, act), 8);
+            }
+        }
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_convolve_HWC_q7_region.c
+ * Description:  Q7 convolution restricted to a region of the output
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+  /**
+   * @brief Q7 convolution function restricted to an output region
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       region      region of the output tensor to compute
+   * @param[in,out]   bufferA     pointer to buffer space for input 
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code> 
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size: 2*ch_im_in*dim_kernel*dim_kernel
+   *
+   * bufferB size: 0
+   *
+   * Only the output pixels inside region are written, the rest of Im_out
+   * is left untouched. This is used for incremental execution, where
+   * Im_out keeps the result of the previous frame and only the pixels
+   * whose receptive field changed (see arm_nn_rect_propagate) are
+   * recomputed. The results are bit-exact with arm_convolve_HWC_q7_basic,
+   * arm_convolve_HWC_q7_fast and arm_convolve_HWC_q7_RGB, and there is
+   * no constraint on ch_im_in or ch_im_out.
+   *
+   * Columns are paired within an output row for the 2-column GEMM kernel,
+   * the odd pixel at the end of a row is computed on its own.
+   */
+
+arm_status
+arm_convolve_HWC_q7_region(const q7_t * Im_in,
+                           const uint16_t dim_im_in,
+                           const uint16_t ch_im_in,
+                           const q7_t * wt,
+                           const uint16_t ch_im_out,
+                           const uint16_t dim_kernel,
+                           const uint16_t padding,
+                           const uint16_t stride,
+                           const q7_t * bias,
+                           const uint16_t bias_shift,
+                           const uint16_t out_shift,
+                           q7_t * Im_out,
+                           const uint16_t dim_im_out,
+                           const arm_nn_rect * region,
+                           q15_t * bufferA,
+                           q7_t * bufferB)
+{
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    int16_t   i_out_y, i_out_x, i_ker_y, i_ker_x;
+    const uint16_t numCol = ch_im_in * dim_kernel * dim_kernel;
+
+    /* 
+     *  Here we use bufferA as q15_t internally as computation are done with q15_t level
+     *  im2col are done to output in q15_t format from q7_t input
+     */
+    q15_t    *pBuffer;
+    q7_t     *pOut;
+
+    for (i_out_y = region->y0; i_out_y < region->y1; i_out_y++)
+    {
+        pBuffer = bufferA;
+        pOut = Im_out + (i_out_y * dim_im_out + region->x0) * ch_im_out;
+
+        for (i_out_x = region->x0; i_out_x < region->x1; i_out_x++)
+        {
+            /* This part implements the im2col function */
+            for (i_ker_y = i_out_y * stride - padding; i_ker_y < i_out_y * stride - padding + dim_kernel; i_ker_y++)
+            {
+                for (i_ker_x = i_out_x * stride - padding; i_ker_x < i_out_x * stride - padding + dim_kernel; i_ker_x++)
+                {
+                    if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                    {
+                        /* Filling 0 for out-of-bound paddings */
+                        memset(pBuffer, 0, sizeof(q15_t)*ch_im_in);
+                    } else
+                    {
+                        /* Copying the pixel data to column */
+                        arm_q7_to_q15_no_shift((q7_t *)
+                                               Im_in + (i_ker_y * dim_im_in + i_ker_x) * ch_im_in, pBuffer, ch_im_in);
+                    }
+                    pBuffer += ch_im_in;
+                }
+            }
+
+            /* Computation is filed for every 2 columns of the same row */
+            if (pBuffer == bufferA + 2 * numCol)
+            {
+                pOut = arm_nn_mat_mult_kernel_q7_q15(wt, bufferA, ch_im_out, numCol,
+                                                     bias_shift, out_shift, bias, pOut);
+
+                /* counter reset */
+                pBuffer = bufferA;
+            }
+        }
+
+        /* left-over because odd number of pixels in the row */
+        if (pBuffer != bufferA)
+        {
+            const q7_t *pA = wt;
+            int       i;
+
+            for (i = 0; i < ch_im_out; i++)
+            {
+                /* Load the accumulator with bias first */
+                q31_t     sum = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+
+                /* Point to the beging of the im2col buffer */
+                q15_t    *pB = bufferA;
+
+                /* Each time it process 4 entries */
+                uint16_t  colCnt = numCol >> 2;
+
+                while (colCnt)
+                {
+                    q31_t     inA1, inA2;
+                    q31_t     inB1, inB2;
+
+                    pA = (q7_t *) read_and_pad((void *)pA, &inA1, &inA2);
+
+                    inB1 = *__SIMD32(pB)++;
+                    sum = __SMLAD(inA1, inB1, sum);
+                    inB2 = *__SIMD32(pB)++;
+                    sum = __SMLAD(inA2, inB2, sum);
+
+                    colCnt--;
+                }
+                colCnt = numCol & 0x3;
+                while (colCnt)
+                {
+                    q7_t      inA1 = *pA++;
+                    q15_t     inB1 = *pB++;
+                    sum += inA1 * inB1;
+                    colCnt--;
+                }
+                *pOut++ = (q7_t) __SSAT((sum >> out_shift), 8);
+            }
+        }
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    int16_t   i, j, k, l, m, n;
+    int       conv_out;
+    int16_t   in_row, in_col;
+
+    for (i = 0; i < ch_im_out; i++)
+    {
+        for (j = region->y0; j < region->y1; j++)
+        {
+            for (k = region->x0; k < region->x1; k++)
+            {
+                conv_out = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+                for (m = 0; m < dim_kernel; m++)
+                {
+                    for (n = 0; n < dim_kernel; n++)
+                    {
+                        in_row = stride * j + m - padding;
+                        in_col = stride * k + n - padding;
+                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in && in_col < dim_im_in)
+                        {
+                            for (l = 0; l < ch_im_in; l++)
+                            {
+                                conv_out +=
+                                    Im_in[(in_row * dim_im_in + in_col) * ch_im_in +
+                                          l] * wt[i * ch_im_in * dim_kernel * dim_kernel + (m * dim_kernel +
+                                                                                            n) * ch_im_in + l];
+                            }
+                        }
+                    }
+                }
+                Im_out[i + (j * dim_im_out + k) * ch_im_out] = (q7_t) __SSAT((conv_out >> out_shift), 8);
+            }
+        }
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_depthwise_separable_block_HWC_q7.c
+ * Description:  Fused Q7 depthwise + pointwise convolution block with ReLU
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+#if defined (ARM_MATH_DSP)
+
+/*
+ * Depthwise convolution of one output pixel from its im2col buffer,
+ * with ReLU folded into the requantization. The result is written as
+ * q15 so that the pointwise GEMM can read it without conversion.
+ */
+static void depthwise_pixel_relu(const q7_t * colBuffer,
+                                 const q7_t * wt,
+                                 const uint16_t ch_im_in,
+                                 const uint16_t dim_kernel,
+                                 const q7_t * bias,
+                                 const uint16_t bias_shift,
+                                 const uint16_t out_shift,
+                                 q15_t * pOut)
+{
+    const q7_t *pBias = bias;
+    uint16_t  row_shift = 0;
+    uint16_t  rowCnt = ch_im_in >> 2;
+
+    while (rowCnt)
+    {
+        q31_t     sum =  ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum2 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum3 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum4 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+
+        uint16_t  colCnt = (dim_kernel * dim_kernel) >> 1;
+        const q7_t *pB = colBuffer + row_shift;
+        const q7_t *pA = wt + row_shift;
+        row_shift += 4;
+
+        while (colCnt)
+        {
+            q31_t     inA1, inA2, inB1, inB2, opA, opB;
+
+            /* pair the same 4 channels of two kernel positions */
+            inB1 = *__SIMD32(pB);
+            pB += ch_im_in;
+            opB = *__SIMD32(pB);
+            pB += ch_im_in;
+#ifndef ARM_MATH_BIG_ENDIAN
+            inB2 = __PKHTB(opB, inB1, 16);
+            inB1 = __PKHBT(inB1, opB, 16);
+#else
+            inB2 = __PKHBT(opB, inB1, 16);
+            inB1 = __PKHTB(inB1, opB, 16);
+#endif
+            inA1 = *__SIMD32(pA);
+            pA += ch_im_in;
+            opB = *__SIMD32(pA);
+            pA += ch_im_in;
+#ifndef ARM_MATH_BIG_ENDIAN
+            inA2 = __PKHTB(opB, inA1, 16);
+            inA1 = __PKHBT(inA1, opB, 16);
+            opA = __SXTB16(inA1);
+            opB = __SXTB16(inB1);
+            sum = __SMLAD(opA, opB, sum);
+            opA = __SXTB16(__ROR(inA1, 8));
+            opB = __SXTB16(__ROR(inB1, 8));
+            sum2 = __SMLAD(opA, opB, sum2);
+            opA = __SXTB16(inA2);
+            opB = __SXTB16(inB2);
+            sum3 = __SMLAD(opA, opB, sum3);
+            opA = __SXTB16(__ROR(inA2, 8));
+            opB = __SXTB16(__ROR(inB2, 8));
+            sum4 = __SMLAD(opA, opB, sum4);
+#else
+            inA2 = __PKHBT(opB, inA1, 16);
+            inA1 = __PKHTB(inA1, opB, 16);
+            opA = __SXTB16(inA1);
+            opB = __SXTB16(inB1);
+            sum2 = __SMLAD(opA, opB, sum2);
+            opA = __SXTB16(__ROR(inA1, 8));
+            opB = __SXTB16(__ROR(inB1, 8));
+            sum = __SMLAD(opA, opB, sum);
+            opA = __SXTB16(inA2);
+            opB = __SXTB16(inB2);
+            sum4 = __SMLAD(opA, opB, sum4);
+            opA = __SXTB16(__ROR(inA2, 8));
+            opB = __SXTB16(__ROR(inB2, 8));
+            sum3 = __SMLAD(opA, opB, sum3);
+#endif                          /* ARM_MATH_BIG_ENDIAN */
+            colCnt--;
+        }
+
+        colCnt = (dim_kernel * dim_kernel) & 0x1;
+        while (colCnt)
+        {
+            union arm_nnword inA, inB;
+            inA.word = *__SIMD32(pA);
+            pA += ch_im_in;
+            inB.word = *__SIMD32(pB);
+            pB += ch_im_in;
+            sum += inA.bytes[0] * inB.bytes[0];
+            sum2 += inA.bytes[1] * inB.bytes[1];
+            sum3 += inA.bytes[2] * inB.bytes[2];
+            sum4 += inA.bytes[3] * inB.bytes[3];
+            colCnt--;
+        }
+
+        /* ReLU and saturation in one step */
+        *pOut++ = (q15_t) __USAT((sum >> out_shift), 7);
+        *pOut++ = (q15_t) __USAT((sum2 >> out_shift), 7);
+        *pOut++ = (q15_t) __USAT((sum3 >> out_shift), 7);
+        *pOut++ = (q15_t) __USAT((sum4 >> out_shift), 7);
+
+        rowCnt--;
+    }
+
+    rowCnt = ch_im_in & 0x3;
+    while (rowCnt)
+    {
+        const q7_t *pB = colBuffer + row_shift;
+        const q7_t *pA = wt + row_shift;
+        q31_t     sum = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        uint16_t  colCnt = (dim_kernel * dim_kernel);
+
+        row_shift += 1;
+
+        while (colCnt)
+        {
+            sum += *pA * *pB;
+            pA += ch_im_in;
+            pB += ch_im_in;
+            colCnt--;
+        }
+        *pOut++ = (q15_t) __USAT((sum >> out_shift), 7);
+        rowCnt--;
+    }
+}
+
+/*
+ * Pointwise (1x1) convolution of 2 pixels of the depthwise row, with ReLU
+ * folded into the requantization. Same structure as
+ * arm_nn_mat_mult_kernel_q7_q15, 2 filters by 2 pixels at a time.
+ */
+static q7_t *pointwise_2pixels_relu(const q7_t * pA,
+                                    const q15_t * pInBuffer,
+                                    const uint16_t ch_im_out,
+                                    const uint16_t numCol_A,
+                                    const uint16_t bias_shift,
+                                    const uint16_t out_shift,
+                                    const q7_t * bias,
+                                    q7_t * pOut)
+{
+    q7_t     *pOut2 = pOut + ch_im_out;
+    const q7_t *pBias = bias;
+    uint16_t  rowCnt = ch_im_out >> 1;
+
+    while (rowCnt)
+    {
+        const q15_t *pB = pInBuffer;
+        const q15_t *pB2 = pB + numCol_A;
+        const q7_t *pA2 = pA + numCol_A;
+
+        q31_t     sum =  ((q31_t)(*pBias) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum2 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum3 = ((q31_t)(*pBias) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum4 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+
+        uint16_t  colCnt = numCol_A >> 2;
+        while (colCnt)
+        {
+            q31_t     inA11, inA12, inA21, inA22;
+            q31_t     inB1 = *__SIMD32(pB)++;
+            q31_t     inB2 = *__SIMD32(pB2)++;
+
+            pA = (q7_t *) read_and_pad((void *)pA, &inA11, &inA12);
+            pA2 = (q7_t *) read_and_pad((void *)pA2, &inA21, &inA22);
+
+            sum = __SMLAD(inA11, inB1, sum);
+            sum2 = __SMLAD(inA11, inB2, sum2);
+            sum3 = __SMLAD(inA21, inB1, sum3);
+            sum4 = __SMLAD(inA21, inB2, sum4);
+
+            inB1 = *__SIMD32(pB)++;
+            inB2 = *__SIMD32(pB2)++;
+
+            sum = __SMLAD(inA12, inB1, sum);
+            sum2 = __SMLAD(inA12, inB2, sum2);
+            sum3 = __SMLAD(inA22, inB1, sum3);
+            sum4 = __SMLAD(inA22, inB2, sum4);
+
+            colCnt--;
+        }
+        colCnt = numCol_A & 0x3;
+        while (colCnt)
+        {
+            q7_t      inA1 = *pA++;
+            q15_t     inB1 = *pB++;
+            q7_t      inA2 = *pA2++;
+            q15_t     inB2 = *pB2++;
+
+            sum += inA1 * inB1;
+            sum2 += inA1 * inB2;
+            sum3 += inA2 * inB1;
+            sum4 += inA2 * inB2;
+            colCnt--;
+        }
+        *pOut++ = (q7_t) __USAT((sum >> out_shift), 7);
+        *pOut++ = (q7_t) __USAT((sum3 >> out_shift), 7);
+        *pOut2++ = (q7_t) __USAT((sum2 >> out_shift), 7);
+        *pOut2++ = (q7_t) __USAT((sum4 >> out_shift), 7);
+
+        /* skip the row computed with A2 */
+        pA += numCol_A;
+        rowCnt--;
+    }
+
+    /* compute left-over row if any */
+    if (ch_im_out & 0x1)
+    {
+        const q15_t *pB = pInBuffer;
+        const q15_t *pB2 = pB + numCol_A;
+        q31_t     sum = ((q31_t)(*pBias) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum2 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        uint16_t  colCnt = numCol_A;
+
+        while (colCnt)
+        {
+            q7_t      inA1 = *pA++;
+            sum += inA1 * *pB++;
+            sum2 += inA1 * *pB2++;
+            colCnt--;
+        }
+        *pOut++ = (q7_t) __USAT((sum >> out_shift), 7);
+        *pOut2++ = (q7_t) __USAT((sum2 >> out_shift), 7);
+    }
+
+    pOut += ch_im_out;
+
+    /* return the new output pointer with offset */
+    return pOut;
+}
+
+#endif                          /* ARM_MATH_DSP */
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+/**
+ * @brief Fused Q7 depthwise separable convolution block with ReLU
+ * @param[in]       Im_in          pointer to input tensor
+ * @param[in]       dim_im_in      input tensor dimention
+ * @param[in]       ch_im_in       number of input tensor channels
+ * @param[in]       dw_wt          pointer to depthwise kernel weights
+ * @param[in]       dim_kernel     depthwise filter kernel size
+ * @param[in]       padding        depthwise padding sizes
+ * @param[in]       stride         depthwise convolution stride
+ * @param[in]       dw_bias        pointer to depthwise bias
+ * @param[in]       dw_bias_shift  amount of left-shift for depthwise bias
+ * @param[in]       dw_out_shift   amount of right-shift for depthwise output
+ * @param[in]       pw_wt          pointer to pointwise kernel weights
+ * @param[in]       ch_im_out      number of pointwise filters, i.e., output tensor channels
+ * @param[in]       pw_bias        pointer to pointwise bias
+ * @param[in]       pw_bias_shift  amount of left-shift for pointwise bias
+ * @param[in]       pw_out_shift   amount of right-shift for pointwise output
+ * @param[in,out]   Im_out         pointer to output tensor
+ * @param[in]       dim_im_out     output tensor dimension
+ * @param[in,out]   bufferA        pointer to buffer space for the depthwise output row
+ * @param[in,out]   bufferB        pointer to buffer space for input
+ * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+ *
+ * @details
+ *
+ * <b>Buffer size:</b>
+ *
+ * bufferA size: dim_im_out*ch_im_in
+ *
+ * bufferB size: ch_im_in*dim_kernel*dim_kernel
+ *
+ * Computes relu(pointwise(relu(depthwise(Im_in)))), i.e. the same as
+ * arm_depthwise_separable_conv_HWC_q7, arm_relu_q7, a 1x1
+ * arm_convolve_HWC_q7_basic and arm_relu_q7 back to back, without
+ * materializing the depthwise output tensor. One row of depthwise output
+ * is computed into bufferA and consumed right away by the pointwise GEMM.
+ * The row is kept as q15 so the GEMM needs no conversion.
+ *
+ * The depthwise weights are in [dim_kernel][dim_kernel][ch_im_in] order,
+ * the pointwise weights in [ch_im_out][ch_im_in] order. The ReLU is folded
+ * into both requantizations with a saturation to [0, 127].
+ */
+
+arm_status arm_depthwise_separable_block_HWC_q7(const q7_t * Im_in,
+                                                const uint16_t dim_im_in,
+                                                const uint16_t ch_im_in,
+                                                const q7_t * dw_wt,
+                                                const uint16_t dim_kernel,
+                                                const uint16_t padding,
+                                                const uint16_t stride,
+                                                const q7_t * dw_bias,
+                                                const uint16_t dw_bias_shift,
+                                                const uint16_t dw_out_shift,
+                                                const q7_t * pw_wt,
+                                                const uint16_t ch_im_out,
+                                                const q7_t * pw_bias,
+                                                const uint16_t pw_bias_shift,
+                                                const uint16_t pw_out_shift,
+                                                q7_t * Im_out,
+                                                const uint16_t dim_im_out,
+                                                q15_t * bufferA,
+                                                q7_t * bufferB)
+{
+    int16_t   i_out_y, i_out_x;
+    q7_t     *pOut = Im_out;
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    int16_t   i_ker_y, i_ker_x;
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        q15_t    *pRow = bufferA;
+        q15_t    *pPix;
+
+        /* depthwise: one output row into bufferA */
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            q7_t     *pBuffer = bufferB;
+
+            /* we first do im2col here */
+            for (i_ker_y = i_out_y * stride - padding; i_ker_y < i_out_y * stride - padding + dim_kernel; i_ker_y++)
+            {
+                for (i_ker_x = i_out_x * stride - padding; i_ker_x < i_out_x * stride - padding + dim_kernel; i_ker_x++)
+                {
+                    if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                    {
+                        memset(pBuffer, 0, ch_im_in);
+                    } else
+                    {
+                        memcpy(pBuffer, (q7_t *) Im_in + (i_ker_y * dim_im_in + i_ker_x) * ch_im_in, ch_im_in);
+                    }
+                    pBuffer += ch_im_in;
+                }
+            }
+
+            depthwise_pixel_relu(bufferB, dw_wt, ch_im_in, dim_kernel, dw_bias, dw_bias_shift, dw_out_shift, pRow);
+            pRow += ch_im_in;
+        }
+
+        /* pointwise: consume the row 2 pixels at a time */
+        for (pPix = bufferA; pPix + 2 * ch_im_in <= pRow; pPix += 2 * ch_im_in)
+        {
+            pOut = pointwise_2pixels_relu(pw_wt, pPix, ch_im_out, ch_im_in, pw_bias_shift, pw_out_shift, pw_bias, pOut);
+        }
+
+        /* left-over because odd number of pixels in the row */
+        if (pPix != pRow)
+        {
+            const q7_t *pA = pw_wt;
+            int       i;
+
+            for (i = 0; i < ch_im_out; i++)
+            {
+                q31_t     sum = ((q31_t)pw_bias[i] << pw_bias_shift) + NN_ROUND(pw_out_shift);
+                const q15_t *pB = pPix;
+                uint16_t  colCnt = ch_im_in >> 2;
+
+                while (colCnt)
+                {
+                    q31_t     inA1, inA2;
+
+                    pA = (q7_t *) read_and_pad((void *)pA, &inA1, &inA2);
+                    sum = __SMLAD(inA1, *__SIMD32(pB)++, sum);
+                    sum = __SMLAD(inA2, *__SIMD32(pB)++, sum);
+                    colCnt--;
+                }
+                colCnt = ch_im_in & 0x3;
+                while (colCnt)
+                {
+                    sum += *pA++ * *pB++;
+                    colCnt--;
+                }
+                *pOut++ = (q7_t) __USAT((sum >> pw_out_shift), 7);
+            }
+        }
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    int       i_ch, i_ch_out, i_ker_x, i_ker_y;
+    int       conv_out;
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        /* depthwise: one output row into bufferA */
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            for (i_ch = 0; i_ch < ch_im_in; i_ch++)
+            {
+                conv_out = ((q31_t)(dw_bias[i_ch]) << dw_bias_shift) + NN_ROUND(dw_out_shift);
+                for (i_ker_y = 0; i_ker_y < dim_kernel; i_ker_y++)
+                {
+                    for (i_ker_x = 0; i_ker_x < dim_kernel; i_ker_x++)
+                    {
+                        int       in_row = stride * i_out_y + i_ker_y - padding;
+                        int       in_col = stride * i_out_x + i_ker_x - padding;
+                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in && in_col < dim_im_in)
+                        {
+                            conv_out += Im_in[(in_row * dim_im_in + in_col) * ch_im_in + i_ch] *
+                                dw_wt[(i_ker_y * dim_kernel + i_ker_x) * ch_im_in + i_ch];
+                        }
+                    }
+                }
+                bufferA[i_out_x * ch_im_in + i_ch] = (q15_t) __USAT((conv_out >> dw_out_shift), 7);
+            }
+        }
+
+        /* pointwise: consume the row */
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            for (i_ch_out = 0; i_ch_out < ch_im_out; i_ch_out++)
+            {
+                conv_out = ((q31_t)(pw_bias[i_ch_out]) << pw_bias_shift) + NN_ROUND(pw_out_shift);
+                for (i_ch = 0; i_ch < ch_im_in; i_ch++)
+                {
+                    conv_out += bufferA[i_out_x * ch_im_in + i_ch] * pw_wt[i_ch_out * ch_im_in + i_ch];
+                }
+                *pOut++ = (q7_t) __USAT((conv_out >> pw_out_shift), 7);
+            }
+        }
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_depthwise_separable_conv_HWC_q7_3x3.c
+ * Description:  Q7 3x3 depthwise convolution
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+#if defined (ARM_MATH_DSP)
+
+/*
+ * Loads one column of the 3x3 window: the 4-channel words of rows
+ * in_y .. in_y + 2 at column in_x, zero outside the image.
+ */
+static void load_col_3x3(const q7_t * Im_in,
+                         const int16_t dim_im_in,
+                         const uint16_t ch_im_in,
+                         const int16_t in_y,
+                         const int16_t in_x,
+                         q31_t * col)
+{
+    int16_t   i;
+
+    for (i = 0; i < 3; i++)
+    {
+        if (in_x < 0 || in_x >= dim_im_in || in_y + i < 0 || in_y + i >= dim_im_in)
+        {
+            col[i] = 0;
+        } else
+        {
+            col[i] = *__SIMD32_CONST(Im_in + ((in_y + i) * dim_im_in + in_x) * ch_im_in);
+        }
+    }
+}
+
+#endif                          /* ARM_MATH_DSP */
+
+/**
+ * @brief Q7 3x3 depthwise convolution function
+ * @param[in]       Im_in       pointer to input tensor
+ * @param[in]       dim_im_in   input tensor dimention
+ * @param[in]       ch_im_in    number of input tensor channels
+ * @param[in]       wt          pointer to kernel weights
+ * @param[in]       padding     padding sizes
+ * @param[in]       stride      convolution stride
+ * @param[in]       bias        pointer to bias
+ * @param[in]       bias_shift  amount of left-shift for bias
+ * @param[in]       out_shift   amount of right-shift for output
+ * @param[in,out]   Im_out      pointer to output tensor
+ * @param[in]       dim_im_out  output tensor dimension
+ * @param[in,out]   bufferA     pointer to buffer space for input
+ * @param[in,out]   bufferB     pointer to buffer space for output
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ *
+ * @details
+ *
+ * <b>Buffer size:</b>
+ *
+ * bufferA size: 0
+ *
+ * bufferB size: 0
+ *
+ * <b>Input dimension constraints:</b>
+ *
+ * ch_im_in is multiple of 4
+ *
+ * stride is 1 or 2
+ *
+ * Same result as arm_depthwise_separable_conv_HWC_q7 with dim_kernel 3 and
+ * ch_im_out equal to ch_im_in.
+ *
+ * The outer loop walks groups of 4 channels. The 9 weight words of a
+ * group are paired by tap and sign-extended once, and stay live while the
+ * group sweeps the whole output. The input window is held as 3 columns of
+ * words; moving one output pixel to the right keeps 3 - stride columns
+ * and loads only the new ones, so no im2col buffer is needed.
+ */
+
+arm_status arm_depthwise_separable_conv_HWC_q7_3x3(const q7_t * Im_in,
+                                                   const uint16_t dim_im_in,
+                                                   const uint16_t ch_im_in,
+                                                   const q7_t * wt,
+                                                   const uint16_t padding,
+                                                   const uint16_t stride,
+                                                   const q7_t * bias,
+                                                   const uint16_t bias_shift,
+                                                   const uint16_t out_shift,
+                                                   q7_t * Im_out,
+                                                   const uint16_t dim_im_out,
+                                                   q15_t * bufferA,
+                                                   q7_t * bufferB)
+{
+    /* check if the input dimension meets the constraints */
+    if (ch_im_in % 4 != 0 || (stride != 1 && stride != 2))
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    int16_t   i_out_y, i_out_x, i_ch;
+    int16_t   i, j;
+
+    for (i_ch = 0; i_ch < ch_im_in; i_ch += 4)
+    {
+        /* taps (0,1) (2,3) (4,5) (6,7) (8,-), one word per channel */
+        q31_t     wt_c0[5], wt_c1[5], wt_c2[5], wt_c3[5];
+        q31_t     b0, b1, b2, b3;
+        const q7_t *pIn = Im_in + i_ch;
+        q7_t     *pOut = Im_out + i_ch;
+
+        for (i = 0; i < 5; i++)
+        {
+            q31_t     inA1, inA2, opB;
+
+            inA1 = *__SIMD32_CONST(wt + (2 * i) * ch_im_in + i_ch);
+            opB = (i < 4) ? *__SIMD32_CONST(wt + (2 * i + 1) * ch_im_in + i_ch) : 0;
+#ifndef ARM_MATH_BIG_ENDIAN
+            inA2 = __PKHTB(opB, inA1, 16);
+            inA1 = __PKHBT(inA1, opB, 16);
+#else
+            inA2 = __PKHBT(opB, inA1, 16);
+            inA1 = __PKHTB(inA1, opB, 16);
+#endif
+            wt_c0[i] = __SXTB16(inA1);
+            wt_c1[i] = __SXTB16(__ROR(inA1, 8));
+            wt_c2[i] = __SXTB16(inA2);
+            wt_c3[i] = __SXTB16(__ROR(inA2, 8));
+        }
+
+        b0 = ((q31_t)bias[i_ch] << bias_shift) + NN_ROUND(out_shift);
+        b1 = ((q31_t)bias[i_ch + 1] << bias_shift) + NN_ROUND(out_shift);
+        b2 = ((q31_t)bias[i_ch + 2] << bias_shift) + NN_ROUND(out_shift);
+        b3 = ((q31_t)bias[i_ch + 3] << bias_shift) + NN_ROUND(out_shift);
+
+        for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+        {
+            int16_t   in_y = i_out_y * stride - padding;
+            int16_t   in_x = -padding;
+            /* win[kx][ky] */
+            q31_t     win[3][3];
+
+            load_col_3x3(pIn, dim_im_in, ch_im_in, in_y, in_x, win[0]);
+            load_col_3x3(pIn, dim_im_in, ch_im_in, in_y, in_x + 1, win[1]);
+            load_col_3x3(pIn, dim_im_in, ch_im_in, in_y, in_x + 2, win[2]);
+
+            for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+            {
+                q31_t     sum = b0;
+                q31_t     sum2 = b1;
+                q31_t     sum3 = b2;
+                q31_t     sum4 = b3;
+                q31_t     tap[10];
+
+                if (i_out_x > 0)
+                {
+                    in_x += stride;
+                    if (stride == 1)
+                    {
+                        for (j = 0; j < 3; j++)
+                        {
+                            win[0][j] = win[1][j];
+                            win[1][j] = win[2][j];
+                        }
+                        load_col_3x3(pIn, dim_im_in, ch_im_in, in_y, in_x + 2, win[2]);
+                    } else
+                    {
+                        for (j = 0; j < 3; j++)
+                        {
+                            win[0][j] = win[2][j];
+                        }
+                        load_col_3x3(pIn, dim_im_in, ch_im_in, in_y, in_x + 1, win[1]);
+                        load_col_3x3(pIn, dim_im_in, ch_im_in, in_y, in_x + 2, win[2]);
+                    }
+                }
+
+                /* row-major tap order, to match the weights */
+                for (j = 0; j < 3; j++)
+                {
+                    tap[3 * j] = win[0][j];
+                    tap[3 * j + 1] = win[1][j];
+                    tap[3 * j + 2] = win[2][j];
+                }
+                tap[9] = 0;
+
+                for (i = 0; i < 5; i++)
+                {
+                    q31_t     inB1, inB2, opB;
+
+                    inB1 = tap[2 * i];
+                    opB = tap[2 * i + 1];
+#ifndef ARM_MATH_BIG_ENDIAN
+                    inB2 = __PKHTB(opB, inB1, 16);
+                    inB1 = __PKHBT(inB1, opB, 16);
+                    sum = __SMLAD(wt_c0[i], __SXTB16(inB1), sum);
+                    sum2 = __SMLAD(wt_c1[i], __SXTB16(__ROR(inB1, 8)), sum2);
+                    sum3 = __SMLAD(wt_c2[i], __SXTB16(inB2), sum3);
+                    sum4 = __SMLAD(wt_c3[i], __SXTB16(__ROR(inB2, 8)), sum4);
+#else
+                    inB2 = __PKHBT(opB, inB1, 16);
+                    inB1 = __PKHTB(inB1, opB, 16);
+                    sum2 = __SMLAD(wt_c0[i], __SXTB16(inB1), sum2);
+                    sum = __SMLAD(wt_c1[i], __SXTB16(__ROR(inB1, 8)), sum);
+                    sum4 = __SMLAD(wt_c2[i], __SXTB16(inB2), sum4);
+                    sum3 = __SMLAD(wt_c3[i], __SXTB16(__ROR(inB2, 8)), sum3);
+#endif                          /* ARM_MATH_BIG_ENDIAN */
+                }
+
+                pOut[0] = (q7_t) __SSAT((sum >> out_shift), 8);
+                pOut[1] = (q7_t) __SSAT((sum2 >> out_shift), 8);
+                pOut[2] = (q7_t) __SSAT((sum3 >> out_shift), 8);
+                pOut[3] = (q7_t) __SSAT((sum4 >> out_shift), 8);
+                pOut += ch_im_in;
+            }
+        }
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+    int       i_out_y, i_out_x, i_ch_out, i_ker_x, i_ker_y;
+    int       conv_out;
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            for (i_ch_out = 0; i_ch_out < ch_im_in; i_ch_out++)
+            {
+                conv_out = ((q31_t)(bias[i_ch_out]) << bias_shift) + NN_ROUND(out_shift);
+                for (i_ker_y = 0; i_ker_y < 3; i_ker_y++)
+                {
+                    for (i_ker_x = 0; i_ker_x < 3; i_ker_x++)
+                    {
+                        int       in_row = stride * i_out_y + i_ker_y - padding;
+                        int       in_col = stride * i_out_x + i_ker_x - padding;
+                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in && in_col < dim_im_in)
+                        {
+                            conv_out += Im_in[(in_row * dim_im_in + in_col) * ch_im_in + i_ch_out] *
+                                wt[(i_ker_y * 3 + i_ker_x) * ch_im_in + i_ch_out];
+                        }
+                    }
+                }
+                Im_out[(i_out_y * dim_im_out + i_out_x) * ch_im_in + i_ch_out] =
+                    (q7_t) __SSAT((conv_out >> out_shift), 8);
+            }
+        }
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_mat_mult_kernel_q7_q15_int4.c
+ * Description:  Matrix-multiplication function for convolution with int4 packed weights
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+  /**
+   * @brief Matrix-multiplication function for convolution with int4 packed weights
+   * @param[in]       pA          pointer to operand A, packed int4 weights
+   * @param[in]       wt_shift    left-shift from int4 to q7 of each row of A
+   * @param[in]       pInBuffer   pointer to operand B, always conssists of 2 vectors
+   * @param[in]       ch_im_out   numRow of A
+   * @param[in]       numCol_A    numCol of A
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        the bias
+   * @param[in,out]   pOut        pointer to output
+   * @return     The function returns the incremented output pointer
+   *
+   * @details
+   *
+   * This function does the matrix multiplication with an int4 weight
+   * matrix and 2 columns from im2col. Each row takes numCol_A/2 bytes,
+   * see arm_nn_unpack_int4 for the packing, and numCol_A must be a
+   * multiple of 8.
+   *
+   * Row i is equivalent to q7 weights w << wt_shift[i] (wt_shift[i] <= 4).
+   * The unpacked weights are 16 times the int4 values, so the accumulator
+   * is scaled by 2^(4 - wt_shift[i]) and the bias and output shifts are
+   * raised by the same amount. The result is the same as with the
+   * equivalent q7 weights.
+   */
+
+q7_t     *arm_nn_mat_mult_kernel_q7_q15_int4(const q7_t * pA,
+                                             const uint8_t * wt_shift,
+                                             const q15_t * pInBuffer,
+                                             const uint16_t ch_im_out,
+                                             const uint16_t numCol_A,
+                                             const uint16_t bias_shift,
+                                             const uint16_t out_shift,
+                                             const q7_t * bias,
+                                             q7_t * pOut)
+{
+    /* set up the second output pointers */
+    q7_t     *pOut2 = pOut + ch_im_out;
+    uint16_t  i;
+
+    /* this loop over rows in A */
+    for (i = 0; i < ch_im_out; i++)
+    {
+        /* shifts of the scaled accumulator */
+        const uint16_t scale = 4 - wt_shift[i];
+        const uint16_t row_bias_shift = bias_shift + scale;
+        const uint16_t row_out_shift = out_shift + scale;
+
+        /* setup pointers for B */
+        const q15_t *pB = pInBuffer;
+        const q15_t *pB2 = pB + numCol_A;
+
+        /* init the sum with bias */
+        q31_t     sum = ((q31_t)bias[i] << row_bias_shift) + NN_ROUND(row_out_shift);
+        q31_t     sum2 = ((q31_t)bias[i] << row_bias_shift) + NN_ROUND(row_out_shift);
+
+        /* each time it process 8 entries */
+        uint16_t  colCnt = numCol_A >> 3;
+
+#if defined (ARM_MATH_DSP)
+        /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+        while (colCnt)
+        {
+            q31_t     inA1, inA2, inA3, inA4;
+            q31_t     inB1, inB2;
+
+            pA = (q7_t *) read_and_pad_int4((void *)pA, &inA1, &inA2, &inA3, &inA4);
+
+            inB1 = *__SIMD32(pB)++;
+            inB2 = *__SIMD32(pB2)++;
+            sum = __SMLAD(inA1, inB1, sum);
+            sum2 = __SMLAD(inA1, inB2, sum2);
+
+            inB1 = *__SIMD32(pB)++;
+            inB2 = *__SIMD32(pB2)++;
+            sum = __SMLAD(inA2, inB1, sum);
+            sum2 = __SMLAD(inA2, inB2, sum2);
+
+            inB1 = *__SIMD32(pB)++;
+            inB2 = *__SIMD32(pB2)++;
+            sum = __SMLAD(inA3, inB1, sum);
+            sum2 = __SMLAD(inA3, inB2, sum2);
+
+            inB1 = *__SIMD32(pB)++;
+            inB2 = *__SIMD32(pB2)++;
+            sum = __SMLAD(inA4, inB1, sum);
+            sum2 = __SMLAD(inA4, inB2, sum2);
+
+            colCnt--;
+        }
+#else
+        /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+        while (colCnt)
+        {
+            q7_t      w[8];
+            int       j;
+
+            arm_nn_unpack_int4(pA, w);
+            pA += 4;
+
+            for (j = 0; j < 8; j++)
+            {
+                sum += w[j] * 16 * pB[j];
+                sum2 += w[j] * 16 * pB2[j];
+            }
+            pB += 8;
+            pB2 += 8;
+
+            colCnt--;
+        }
+#endif                          /* ARM_MATH_DSP */
+
+        *pOut++ = (q7_t) __SSAT((sum >> row_out_shift), 8);
+        *pOut2++ = (q7_t) __SSAT((sum2 >> row_out_shift), 8);
+    }
+
+    pOut += ch_im_out;
+
+    /* return the new output pointer with offset */
+    return pOut;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_mat_mult_kernel_q7_q15_sparse.c
+ * Description:  Matrix-multiplication function for convolution with block-sparse weights
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+  /**
+   * @brief Matrix-multiplication function for convolution with block-sparse weights
+   * @param[in]       pA          pointer to the non-zero weight blocks
+   * @param[in]       blk_idx     column index (in blocks of 4) of each non-zero block
+   * @param[in]       row_ptr     index of the first block of each row, ch_im_out+1 entries
+   * @param[in]       pInBuffer   pointer to B input
+   * @param[in]       ch_im_out   numRow of A
+   * @param[in]       numCol_A    numCol of A
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        the bias
+   * @param[in,out]   pOut        pointer to output
+   * @return     The function returns the incremented output pointer
+   *
+   * @details
+   *
+   * This function does the matrix multiplication with a block-sparse
+   * weight matrix and 2 columns from im2col. The weight matrix is split
+   * into blocks of 4 consecutive columns; only the non-zero blocks are
+   * stored, row by row, and row i uses blocks row_ptr[i] to
+   * row_ptr[i+1]-1. Block b holds the 4 weights at columns
+   * 4*blk_idx[b] to 4*blk_idx[b]+3 in their original order.
+   *
+   * numCol_A must be a multiple of 4. The cost scales with the number of
+   * non-zero blocks instead of the size of the weight matrix.
+   */
+
+q7_t     *arm_nn_mat_mult_kernel_q7_q15_sparse(const q7_t * pA,
+                                               const uint16_t * blk_idx,
+                                               const uint16_t * row_ptr,
+                                               const q15_t * pInBuffer,
+                                               const uint16_t ch_im_out,
+                                               const uint16_t numCol_A,
+                                               const uint16_t bias_shift,
+                                               const uint16_t out_shift,
+                                               const q7_t * bias,
+                                               q7_t * pOut)
+{
+    /* set up the second output pointers */
+    q7_t     *pOut2 = pOut + ch_im_out;
+    const uint16_t *pIdx = blk_idx;
+    uint16_t  i;
+
+    /* this loop over rows in A */
+    for (i = 0; i < ch_im_out; i++)
+    {
+        /* init the sum with bias */
+        q31_t     sum = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum2 = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+
+        uint16_t  blkCnt = row_ptr[i + 1] - row_ptr[i];
+
+#if defined (ARM_MATH_DSP)
+        /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+        /* accumulate over the non-zero blocks */
+        while (blkCnt)
+        {
+            q31_t     inA1, inA2;
+            q31_t     inB1, inB2;
+            const q15_t *pB = pInBuffer + (*pIdx++ << 2);
+            const q15_t *pB2 = pB + numCol_A;
+
+            pA = (q7_t *) read_and_pad((void *)pA, &inA1, &inA2);
+
+            inB1 = *__SIMD32(pB)++;
+            inB2 = *__SIMD32(pB2)++;
+            sum = __SMLAD(inA1, inB1, sum);
+            sum2 = __SMLAD(inA1, inB2, sum2);
+
+            inB1 = *__SIMD32(pB);
+            inB2 = *__SIMD32(pB2);
+            sum = __SMLAD(inA2, inB1, sum);
+            sum2 = __SMLAD(inA2, inB2, sum2);
+
+            blkCnt--;
+        }
+#else
+        /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+        while (blkCnt)
+        {
+            const q15_t *pB = pInBuffer + (*pIdx++ << 2);
+            const q15_t *pB2 = pB + numCol_A;
+            int       j;
+
+            for (j = 0; j < 4; j++)
+            {
+                sum += pA[j] * pB[j];
+                sum2 += pA[j] * pB2[j];
+            }
+            pA += 4;
+
+            blkCnt--;
+        }
+#endif                          /* ARM_MATH_DSP */
+
+        *pOut++ = (q7_t) __SSAT((sum >> out_shift), 8);
+        *pOut2++ = (q7_t) __SSAT((sum2 >> out_shift), 8);
+    }
+
+    pOut += ch_im_out;
+
+    /* return the new output pointer with offset */
+    return pOut;
+}
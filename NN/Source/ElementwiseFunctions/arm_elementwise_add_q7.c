@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_elementwise_add_q7.c
+ * Description:  Q7 elementwise addition and subtraction with input shifts and channel broadcast
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/*
+ * Shared body of the addition and the subtraction, sign is 1 or -1 and
+ * multiplies the shifted second input.
+ */
+
+static void arm_elementwise_add_sub_q7(const q7_t * in1,
+                                       const q7_t * in2,
+                                       const uint16_t dim,
+                                       const uint16_t ch,
+                                       const uint16_t broadcast,
+                                       const uint16_t in1_shift,
+                                       const uint16_t in2_shift,
+                                       const int16_t sign,
+                                       const uint16_t out_shift,
+                                       const arm_nn_act * act,
+                                       q7_t * out)
+{
+    const q7_t *pA = in1;
+    const q7_t *pB = in2;
+    q7_t     *pOut = out;
+    uint32_t  rows = broadcast ? dim : 1;
+    uint32_t  len = broadcast ? ch : (uint32_t) dim * ch;
+    uint32_t  blkCnt;
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    q31_t     scale = __PKHBT(1 << in1_shift, sign * (1 << in2_shift), 16);
+    q31_t     rnd = NN_ROUND(out_shift);
+#endif
+
+    while (rows)
+    {
+        if (broadcast)
+        {
+            pB = in2;
+        }
+
+#if defined (ARM_MATH_DSP)
+        blkCnt = len >> 2;
+        while (blkCnt)
+        {
+            q31_t     inA = *__SIMD32(pA)++;
+            q31_t     inB = *__SIMD32(pB)++;
+            /* lanes 0 and 2, then lanes 1 and 3 */
+            q31_t     a02 = __SXTB16(inA);
+            q31_t     a13 = __SXTB16(__ROR(inA, 8));
+            q31_t     b02 = __SXTB16(inB);
+            q31_t     b13 = __SXTB16(__ROR(inB, 8));
+            q31_t     sum0, sum1, sum2, sum3;
+
+            sum0 = __SMLAD(__PKHBT(a02, b02, 16), scale, rnd) >> out_shift;
+            sum1 = __SMLAD(__PKHBT(a13, b13, 16), scale, rnd) >> out_shift;
+            sum2 = __SMLAD(__PKHTB(b02, a02, 16), scale, rnd) >> out_shift;
+            sum3 = __SMLAD(__PKHTB(b13, a13, 16), scale, rnd) >> out_shift;
+
+            sum0 = __SSAT(arm_nn_activate(sum0, act), 8);
+            sum1 = __SSAT(arm_nn_activate(sum1, act), 8);
+            sum2 = __SSAT(arm_nn_activate(sum2, act), 8);
+            sum3 = __SSAT(arm_nn_activate(sum3, act), 8);
+
+#ifndef ARM_MATH_BIG_ENDIAN
+            *__SIMD32(pOut)++ = __PACKq7(sum0, sum1, sum2, sum3);
+#else
+            *__SIMD32(pOut)++ = __PACKq7(sum3, sum2, sum1, sum0);
+#endif
+            blkCnt--;
+        }
+
+        blkCnt = len & 0x3;
+#else
+        /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+        blkCnt = len;
+#endif                          /* ARM_MATH_DSP */
+
+        while (blkCnt)
+        {
+            q31_t     sum = ((q31_t) *pA++ << in1_shift) + sign * ((q31_t) *pB++ << in2_shift) + NN_ROUND(out_shift);
+
+            *pOut++ = (q7_t) __SSAT(arm_nn_activate(sum >> out_shift, act), 8);
+            blkCnt--;
+        }
+
+        rows--;
+    }
+}
+
+
+/**
+ * @addtogroup Elementwise
+ * @{
+ */
+
+  /**
+   * @brief Q7 elementwise addition with input shifts and channel broadcast
+   * @param[in]       in1         pointer to the first input tensor
+   * @param[in]       in2         pointer to the second input tensor, or to ch values if broadcast
+   * @param[in]       dim         number of pixels, i.e. height times width
+   * @param[in]       ch          number of channels
+   * @param[in]       broadcast   non-zero if in2 holds one value per channel for all pixels
+   * @param[in]       in1_shift   amount of left-shift for the first input, at most 14
+   * @param[in]       in2_shift   amount of left-shift for the second input, at most 14
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation, ARM_ACT_NONE for none
+   * @param[in,out]   out         pointer to output tensor, may be in1, or in2 without broadcast
+   * @return none.
+   *
+   * @details
+   *
+   * out = act(((in1 << in1_shift) + (in2 << in2_shift)) >> out_shift), saturated to q7.
+   *
+   * The shifts bring the two inputs to a common q-format, so the branches
+   * of a residual block can keep their own formats. With the DSP extension
+   * four elements are processed per word: each element is paired with its
+   * counterpart and the shifted sum is a single SMLAD against the
+   * packed (1 << in1_shift, 1 << in2_shift).
+   */
+
+void arm_elementwise_add_q7(const q7_t * in1,
+                            const q7_t * in2,
+                            const uint16_t dim,
+                            const uint16_t ch,
+                            const uint16_t broadcast,
+                            const uint16_t in1_shift,
+                            const uint16_t in2_shift,
+                            const uint16_t out_shift,
+                            const arm_nn_act * act,
+                            q7_t * out)
+{
+    arm_elementwise_add_sub_q7(in1, in2, dim, ch, broadcast, in1_shift, in2_shift, 1, out_shift, act, out);
+}
+
+  /**
+   * @brief Q7 elementwise subtraction with input shifts and channel broadcast
+   * @param[in]       in1         pointer to the first input tensor
+   * @param[in]       in2         pointer to the second input tensor, or to ch values if broadcast
+   * @param[in]       dim         number of pixels, i.e. height times width
+   * @param[in]       ch          number of channels
+   * @param[in]       broadcast   non-zero if in2 holds one value per channel for all pixels
+   * @param[in]       in1_shift   amount of left-shift for the first input, at most 14
+   * @param[in]       in2_shift   amount of left-shift for the second input, at most 14
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation, ARM_ACT_NONE for none
+   * @param[in,out]   out         pointer to output tensor, may be in1, or in2 without broadcast
+   * @return none.
+   *
+   * @details
+   *
+   * out = act(((in1 << in1_shift) - (in2 << in2_shift)) >> out_shift), saturated to q7.
+   *
+   * Same as arm_elementwise_add_q7() with the second input negated: the
+   * packed scale of the SMLAD is (1 << in1_shift, -(1 << in2_shift)).
+   */
+
+void arm_elementwise_sub_q7(const q7_t * in1,
+                            const q7_t * in2,
+                            const uint16_t dim,
+                            const uint16_t ch,
+                            const uint16_t broadcast,
+                            const uint16_t in1_shift,
+                            const uint16_t in2_shift,
+                            const uint16_t out_shift,
+                            const arm_nn_act * act,
+                            q7_t * out)
+{
+    arm_elementwise_add_sub_q7(in1, in2, dim, ch, broadcast, in1_shift, in2_shift, -1, out_shift, act, out);
+}
+
+/**
+ * @} end of Elementwise group
+ */
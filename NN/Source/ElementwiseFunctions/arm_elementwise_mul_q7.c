@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_elementwise_mul_q7.c
+ * Description:  Q7 elementwise multiplication with channel broadcast
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Elementwise
+ * @{
+ */
+
+  /**
+   * @brief Q7 elementwise multiplication with channel broadcast
+   * @param[in]       in1         pointer to the first input tensor
+   * @param[in]       in2         pointer to the second input tensor, or to ch values if broadcast
+   * @param[in]       dim         number of pixels, i.e. height times width
+   * @param[in]       ch          number of channels
+   * @param[in]       broadcast   non-zero if in2 holds one value per channel for all pixels
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       act         activation applied before the saturation, ARM_ACT_NONE for none
+   * @param[in,out]   out         pointer to output tensor, may be in1, or in2 without broadcast
+   * @return none.
+   *
+   * @details
+   *
+   * out = act((in1 * in2) >> out_shift), saturated to q7.
+   *
+   * Unlike arm_nn_mult_q7(), in2 can be a per-channel vector, e.g. the
+   * channel scales of a squeeze-and-excitation block. The formats of the
+   * inputs add up in the product, so out_shift alone sets the output format.
+   * With the DSP extension four elements are processed per word: the even
+   * and the odd lanes are sign-extended in pairs and multiplied by an
+   * SMULBB and an SMULTT each.
+   */
+
+void arm_elementwise_mul_q7(const q7_t * in1,
+                            const q7_t * in2,
+                            const uint16_t dim,
+                            const uint16_t ch,
+                            const uint16_t broadcast,
+                            const uint16_t out_shift,
+                            const arm_nn_act * act,
+                            q7_t * out)
+{
+    const q7_t *pA = in1;
+    const q7_t *pB = in2;
+    q7_t     *pOut = out;
+    uint32_t  rows = broadcast ? dim : 1;
+    uint32_t  len = broadcast ? ch : (uint32_t) dim * ch;
+    uint32_t  blkCnt;
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    q31_t     rnd = NN_ROUND(out_shift);
+#endif
+
+    while (rows)
+    {
+        if (broadcast)
+        {
+            pB = in2;
+        }
+
+#if defined (ARM_MATH_DSP)
+        blkCnt = len >> 2;
+        while (blkCnt)
+        {
+            q31_t     inA = *__SIMD32(pA)++;
+            q31_t     inB = *__SIMD32(pB)++;
+            /* lanes 0 and 2, then lanes 1 and 3 */
+            q31_t     a02 = __SXTB16(inA);
+            q31_t     a13 = __SXTB16(__ROR(inA, 8));
+            q31_t     b02 = __SXTB16(inB);
+            q31_t     b13 = __SXTB16(__ROR(inB, 8));
+            q31_t     mul0, mul1, mul2, mul3;
+
+            mul0 = __SMULBB(a02, b02) + rnd;
+            mul1 = __SMULBB(a13, b13) + rnd;
+            mul2 = __SMULTT(a02, b02) + rnd;
+            mul3 = __SMULTT(a13, b13) + rnd;
+
+            mul0 = __SSAT(arm_nn_activate(mul0 >> out_shift, act), 8);
+            mul1 = __SSAT(arm_nn_activate(mul1 >> out_shift, act), 8);
+            mul2 = __SSAT(arm_nn_activate(mul2 >> out_shift, act), 8);
+            mul3 = __SSAT(arm_nn_activate(mul3 >> out_shift, act), 8);
+
+#ifndef ARM_MATH_BIG_ENDIAN
+            *__SIMD32(pOut)++ = __PACKq7(mul0, mul1, mul2, mul3);
+#else
+            *__SIMD32(pOut)++ = __PACKq7(mul3, mul2, mul1, mul0);
+#endif
+            blkCnt--;
+        }
+
+        blkCnt = len & 0x3;
+#else
+        /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+        blkCnt = len;
+#endif                          /* ARM_MATH_DSP */
+
+        while (blkCnt)
+        {
+            q31_t     mul = (q31_t) *pA++ * *pB++ + NN_ROUND(out_shift);
+
+            *pOut++ = (q7_t) __SSAT(arm_nn_activate(mul >> out_shift, act), 8);
+            blkCnt--;
+        }
+
+        rows--;
+    }
+}
+
+/**
+ * @} end of Elementwise group
+ */
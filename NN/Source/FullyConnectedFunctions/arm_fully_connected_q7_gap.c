@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_fully_connected_q7_gap.c
+ * Description:  Q7 global average pooling fused with a fully-connected layer
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup FC
+ * @{
+ */
+
+  /**
+   * @brief Q7 global average pooling followed by a basic fully-connected layer
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels, i.e., length of the vector
+   * @param[in]       pM          pointer to matrix weights
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * vec_buffer size: ch_im_in
+   *
+   * Same result as arm_global_avepool_q7_HWC followed by
+   * arm_fully_connected_q7, the weights are not interleaved. The channel
+   * averages are written straight into vec_buffer in the reordered q15
+   * layout the matrix loop reads, so the pooled vector never exists as q7.
+   * dim_im_in must be below 256.
+   *
+   */
+
+arm_status
+arm_fully_connected_q7_gap(const q7_t * Im_in,
+                           const uint16_t dim_im_in,
+                           const uint16_t ch_im_in,
+                           const q7_t * pM,
+                           const uint16_t num_of_rows,
+                           const uint16_t bias_shift,
+                           const uint16_t out_shift, const q7_t * bias, q7_t * pOut, q15_t * vec_buffer)
+{
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    const q7_t *pB = pM;
+    const q7_t *pB2;
+    q7_t     *pO = pOut;
+    const q7_t *pBias = bias;
+    q15_t    *pA = vec_buffer;
+    uint16_t  rowCnt = num_of_rows >> 1;
+    uint16_t  i_ch = 0;
+    int16_t   k_y, k_x;
+    arm_nn_recip recip;
+
+    arm_nn_recip_init(&recip, dim_im_in * dim_im_in);
+
+    /* average 4 channels at a time into the reordered vector */
+    for (; i_ch + 4 <= ch_im_in; i_ch += 4)
+    {
+        q31_t     sumAl = 0, sumAh = 0, sumBl = 0, sumBh = 0;
+        q31_t     outA, outB;
+
+        for (k_y = 0; k_y < dim_im_in; k_y++)
+        {
+            const q7_t *pIn = Im_in + k_y * dim_im_in * ch_im_in + i_ch;
+            q31_t     accA = 0;
+            q31_t     accB = 0;
+
+            for (k_x = 0; k_x < dim_im_in; k_x++)
+            {
+                q31_t     in = *__SIMD32(pIn);
+                accA = __SXTAB16(accA, in);
+                accB = __SXTAB16(accB, __ROR(in, 8));
+                pIn += ch_im_in;
+            }
+            sumAl += (q15_t) accA;
+            sumAh += accA >> 16;
+            sumBl += (q15_t) accB;
+            sumBh += accB >> 16;
+        }
+
+        outA = __PKHBT(arm_nn_div_recip(sumAl, &recip), arm_nn_div_recip(sumAh, &recip), 16);
+        outB = __PKHBT(arm_nn_div_recip(sumBl, &recip), arm_nn_div_recip(sumBh, &recip), 16);
+#ifndef ARM_MATH_BIG_ENDIAN
+        *__SIMD32(pA)++ = outA;
+        *__SIMD32(pA)++ = outB;
+#else
+        *__SIMD32(pA)++ = outB;
+        *__SIMD32(pA)++ = outA;
+#endif
+    }
+
+    /* the tail stays in natural order */
+    for (; i_ch < ch_im_in; i_ch++)
+    {
+        const q7_t *pIn = Im_in + i_ch;
+        q31_t     sum = 0;
+        int32_t   i;
+
+        for (i = 0; i < dim_im_in * dim_im_in; i++)
+        {
+            sum += *pIn;
+            pIn += ch_im_in;
+        }
+        *pA++ = (q15_t) arm_nn_div_recip(sum, &recip);
+    }
+
+    while (rowCnt)
+    {
+        q31_t     sum =  ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        q31_t     sum2 = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+        uint16_t  colCnt = ch_im_in >> 2;
+
+        pA = vec_buffer;
+        pB2 = pB + ch_im_in;
+
+        while (colCnt)
+        {
+            q31_t     inV, inM11, inM12, inM21, inM22;
+            pB = (q7_t *) read_and_pad_reordered((void *)pB, &inM11, &inM12);
+            pB2 = (q7_t *) read_and_pad_reordered((void *)pB2, &inM21, &inM22);
+
+            inV = *__SIMD32(pA)++;
+
+            sum = __SMLAD(inV, inM11, sum);
+            sum2 = __SMLAD(inV, inM21, sum2);
+
+            inV = *__SIMD32(pA)++;
+
+            sum = __SMLAD(inV, inM12, sum);
+            sum2 = __SMLAD(inV, inM22, sum2);
+
+            colCnt--;
+        }
+        colCnt = ch_im_in & 0x3;
+        while (colCnt)
+        {
+            q15_t     inV = *pA++;
+            q15_t     inM = *pB++;
+            q15_t     inM2 = *pB2++;
+
+            sum += inV * inM;
+            sum2 += inV * inM2;
+            colCnt--;
+        }                       /* while over colCnt */
+        *pO++ = (q7_t) (__SSAT((sum >> out_shift), 8));
+        *pO++ = (q7_t) (__SSAT((sum2 >> out_shift), 8));
+
+        /* adjust the pointers and counters */
+        pB += ch_im_in;
+        rowCnt--;
+    }
+
+    /* left-over part of the rows */
+    rowCnt = num_of_rows & 0x1;
+
+    while (rowCnt)
+    {
+        uint16_t  colCnt = ch_im_in >> 2;
+        q31_t     sum = ((q31_t)(*pBias++) << bias_shift) + NN_ROUND(out_shift);
+
+        pA = vec_buffer;
+
+        while (colCnt)
+        {
+            q31_t     inV1, inV2, inM11, inM12;
+
+            pB = (q7_t *) read_and_pad_reordered((void *)pB, &inM11, &inM12);
+
+            inV1 = *__SIMD32(pA)++;
+            sum = __SMLAD(inV1, inM11, sum);
+
+            inV2 = *__SIMD32(pA)++;
+            sum = __SMLAD(inV2, inM12, sum);
+
+            colCnt--;
+        }
+
+        /* left-over of the vector */
+        colCnt = ch_im_in & 0x3;
+        while (colCnt)
+        {
+            q15_t     inV = *pA++;
+            q15_t     inM = *pB++;
+            sum += inV * inM;
+            colCnt--;
+        }
+
+        *pO++ = (q7_t) (__SSAT((sum >> out_shift), 8));
+
+        rowCnt--;
+    }
+
+#else
+    int       i, j;
+
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+    for (j = 0; j < ch_im_in; j++)
+    {
+        int       sum = 0;
+        for (i = 0; i < dim_im_in * dim_im_in; i++)
+        {
+            sum += Im_in[j + ch_im_in * i];
+        }
+        vec_buffer[j] = sum / (dim_im_in * dim_im_in);
+    }
+
+    for (i = 0; i < num_of_rows; i++)
+    {
+        int       ip_out = ((q31_t)(bias[i]) << bias_shift) + NN_ROUND(out_shift);
+        for (j = 0; j < ch_im_in; j++)
+        {
+            ip_out += vec_buffer[j] * pM[i * ch_im_in + j];
+        }
+        pOut[i] = (q7_t) __SSAT((ip_out >> out_shift), 8);
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to ARM_MATH_SUCCESS */
+    return (ARM_MATH_SUCCESS);
+
+}
+
+/**
+ * @} end of FC group
+ */
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_fully_connected_q7_int4.c
+ * Description:  Q7 fully-connected layer with int4 packed weights
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup FC
+ * @{
+ */
+
+  /**
+   * @brief Q7 fully-connected layer function with int4 packed weights
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to the packed int4 matrix weights
+   * @param[in]       wt_shift    left-shift from int4 to q7 of each row
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * vec_buffer size: dim_vec
+   *
+   * <b>Input dimension constraints:</b>
+   *
+   * dim_vec is multiple of 8
+   *
+   * The regular (not interleaved) weight matrix is packed two weights per
+   * byte, dim_vec/2 bytes per row (see arm_nn_unpack_int4). Row i is
+   * equivalent to the q7 row w << wt_shift[i], bias_shift and out_shift
+   * are the ones of the q7 layer. Weights are read at half the bandwidth
+   * of arm_fully_connected_q7_opt, and two rows share every load of the
+   * vector.
+   *
+   */
+
+arm_status
+arm_fully_connected_q7_int4(const q7_t * pV,
+                            const q7_t * pM,
+                            const uint8_t * wt_shift,
+                            const uint16_t dim_vec,
+                            const uint16_t num_of_rows,
+                            const uint16_t bias_shift,
+                            const uint16_t out_shift,
+                            const q7_t * bias,
+                            q7_t * pOut,
+                            q15_t * vec_buffer)
+{
+    const q7_t *pB = pM;
+    uint16_t  i;
+
+    if (dim_vec % 8 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    arm_q7_to_q15_no_shift(pV, vec_buffer, dim_vec);
+
+    for (i = 0; i + 1 < num_of_rows; i += 2)
+    {
+        /* shifts of the scaled accumulators */
+        const uint16_t scale = 4 - wt_shift[i];
+        const uint16_t scale2 = 4 - wt_shift[i + 1];
+        const uint16_t row_out_shift = out_shift + scale;
+        const uint16_t row_out_shift2 = out_shift + scale2;
+
+        q31_t     sum = ((q31_t)bias[i] << (bias_shift + scale)) + NN_ROUND(row_out_shift);
+        q31_t     sum2 = ((q31_t)bias[i + 1] << (bias_shift + scale2)) + NN_ROUND(row_out_shift2);
+        const q7_t *pB2 = pB + (dim_vec >> 1);
+        const q15_t *pA = vec_buffer;
+        uint16_t  colCnt = dim_vec >> 3;
+
+        while (colCnt)
+        {
+            q31_t     inM11, inM12, inM13, inM14;
+            q31_t     inM21, inM22, inM23, inM24;
+            q31_t     inV;
+
+            pB = (q7_t *) read_and_pad_int4((void *)pB, &inM11, &inM12, &inM13, &inM14);
+            pB2 = (q7_t *) read_and_pad_int4((void *)pB2, &inM21, &inM22, &inM23, &inM24);
+
+            inV = *__SIMD32(pA)++;
+            sum = __SMLAD(inV, inM11, sum);
+            sum2 = __SMLAD(inV, inM21, sum2);
+
+            inV = *__SIMD32(pA)++;
+            sum = __SMLAD(inV, inM12, sum);
+            sum2 = __SMLAD(inV, inM22, sum2);
+
+            inV = *__SIMD32(pA)++;
+            sum = __SMLAD(inV, inM13, sum);
+            sum2 = __SMLAD(inV, inM23, sum2);
+
+            inV = *__SIMD32(pA)++;
+            sum = __SMLAD(inV, inM14, sum);
+            sum2 = __SMLAD(inV, inM24, sum2);
+
+            colCnt--;
+        }
+
+        pOut[i] = (q7_t) (__SSAT((sum >> row_out_shift), 8));
+        pOut[i + 1] = (q7_t) (__SSAT((sum2 >> row_out_shift2), 8));
+
+        /* skip the row computed with pB2 */
+        pB += dim_vec >> 1;
+    }
+
+    /* left-over row if any */
+    if (i < num_of_rows)
+    {
+        const uint16_t scale = 4 - wt_shift[i];
+        const uint16_t row_out_shift = out_shift + scale;
+
+        q31_t     sum = ((q31_t)bias[i] << (bias_shift + scale)) + NN_ROUND(row_out_shift);
+        const q15_t *pA = vec_buffer;
+        uint16_t  colCnt = dim_vec >> 3;
+
+        while (colCnt)
+        {
+            q31_t     inM11, inM12, inM13, inM14;
+
+            pB = (q7_t *) read_and_pad_int4((void *)pB, &inM11, &inM12, &inM13, &inM14);
+
+            sum = __SMLAD(*__SIMD32(pA)++, inM11, sum);
+            sum = __SMLAD(*__SIMD32(pA)++, inM12, sum);
+            sum = __SMLAD(*__SIMD32(pA)++, inM13, sum);
+            sum = __SMLAD(*__SIMD32(pA)++, inM14, sum);
+
+            colCnt--;
+        }
+
+        pOut[i] = (q7_t) (__SSAT((sum >> row_out_shift), 8));
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    for (i = 0; i < num_of_rows; i++)
+    {
+        int       ip_out = ((q31_t)(bias[i]) << bias_shift) + NN_ROUND(out_shift);
+        q7_t      w[8];
+        int       j;
+
+        for (j = 0; j < dim_vec; j++)
+        {
+            if ((j & 0x7) == 0)
+            {
+                arm_nn_unpack_int4(pB, w);
+                pB += 4;
+            }
+            ip_out += pV[j] * (w[j & 0x7] * (1 << wt_shift[i]));
+        }
+        pOut[i] = (q7_t) __SSAT((ip_out >> out_shift), 8);
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to ARM_MATH_SUCCESS */
+    return (ARM_MATH_SUCCESS);
+
+}
+
+/**
+ * @} end of FC group
+ */
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_fully_connected_q7_opt_q31_zero_skip.c
+ * Description:  Q7 opt fully-connected layer function with Q31 output that skips zero inputs
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup FC
+ * @{
+ */
+
+  /**
+   * @brief Q7 opt fully-connected layer function with Q31 output that skips zero inputs
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to matrix weights, in the arm_fully_connected_q7_opt() order
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       bias        pointer to bias
+   * @param[in]       max_nnz     largest number of non-zero inputs handled sparsely, at most dim_vec / 2
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * vec_buffer size: dim_vec
+   *
+   * Same result as arm_fully_connected_q7_opt_q31(), bit-exact. The input
+   * of a classifier comes out of ReLU and max pooling and is mostly zero,
+   * so the vector is first compacted into (weight offset, value) pairs,
+   * four inputs at a time so that zero words cost a single compare. Only
+   * the weights of the non-zero columns are then read, which also cuts
+   * the flash reads of pM in proportion.
+   *
+   * In the interleaved matrix, the four weights of column c of a group of
+   * four rows sit at offset o and o + 1 (rows 1 and 2) and o + 4 and
+   * o + 5 (rows 3 and 4) of the group, with
+   *
+   *   o = 16 * (c / 4) + 8 * (c % 2) + 2 * ((c / 2) % 2)
+   *
+   * The at most three left-over columns are stored in-order after the
+   * others and the left-over rows are not interleaved, c is recovered
+   * from o for them.
+   *
+   * When more than max_nnz inputs are non-zero the dense
+   * arm_fully_connected_q7_opt_q31() is faster and is called instead.
+   */
+
+arm_status
+arm_fully_connected_q7_opt_q31_zero_skip(const q7_t * pV,
+                                         const q7_t * pM,
+                                         const uint16_t dim_vec,
+                                         const uint16_t num_of_rows,
+                                         const uint16_t bias_shift,
+                                         const q7_t * bias,
+                                         const uint16_t max_nnz,
+                                         q31_t * pOut,
+                                         q15_t * vec_buffer)
+{
+    uint16_t *pOff = (uint16_t *) vec_buffer;
+    q15_t    *pVal = vec_buffer + max_nnz;
+    const uint16_t dim_main = dim_vec & ~0x3;
+    const q7_t *pB = pM;
+    const q7_t *pBias = bias;
+    q31_t    *pO = pOut;
+    uint16_t  nnz = 0;
+    uint16_t  rowCnt;
+    uint16_t  i, k;
+
+    /* compact the non-zero inputs of the interleaved columns */
+    for (i = 0; i < dim_main; i += 4)
+    {
+#if defined (ARM_MATH_DSP)
+        /* Run the following code for Cortex-M4 and Cortex-M7 */
+        if (*__SIMD32_CONST(pV + i) == 0)
+        {
+            continue;
+        }
+#endif
+        for (k = 0; k < 4; k++)
+        {
+            if (pV[i + k] != 0)
+            {
+                if (nnz == max_nnz)
+                {
+                    return arm_fully_connected_q7_opt_q31(pV, pM, dim_vec, num_of_rows, bias_shift, bias, pOut,
+                                                          vec_buffer);
+                }
+                pOff[nnz] = (i << 2) + ((k & 0x1) << 3) + (k & 0x2);
+                pVal[nnz] = pV[i + k];
+                nnz++;
+            }
+        }
+    }
+
+    rowCnt = num_of_rows >> 2;
+    while (rowCnt)
+    {
+        q31_t     sum =  ((q31_t)(*pBias++) << bias_shift);
+        q31_t     sum2 = ((q31_t)(*pBias++) << bias_shift);
+        q31_t     sum3 = ((q31_t)(*pBias++) << bias_shift);
+        q31_t     sum4 = ((q31_t)(*pBias++) << bias_shift);
+        const q7_t *pW;
+
+        for (k = 0; k < nnz; k++)
+        {
+            q31_t     inV = pVal[k];
+
+            pW = pB + pOff[k];
+            sum += inV * pW[0];
+            sum2 += inV * pW[1];
+            sum3 += inV * pW[4];
+            sum4 += inV * pW[5];
+        }
+
+        /* left-over columns, in-order */
+        pW = pB + 4 * dim_main;
+        for (i = dim_main; i < dim_vec; i++)
+        {
+            q31_t     inV = pV[i];
+
+            sum += inV * pW[0];
+            sum2 += inV * pW[1];
+            sum3 += inV * pW[2];
+            sum4 += inV * pW[3];
+            pW += 4;
+        }
+
+        *pO++ = sum;
+        *pO++ = sum2;
+        *pO++ = sum3;
+        *pO++ = sum4;
+
+        pB += 4 * dim_vec;
+        rowCnt--;
+    }
+
+    /* left-over rows, not interleaved */
+    rowCnt = num_of_rows & 0x3;
+    while (rowCnt)
+    {
+        q31_t     sum = ((q31_t)(*pBias++) << bias_shift);
+
+        for (k = 0; k < nnz; k++)
+        {
+            uint16_t  off = pOff[k];
+            uint16_t  col = ((off >> 4) << 2) + ((off >> 3) & 0x1) + (off & 0x2);
+
+            sum += pVal[k] * pB[col];
+        }
+        for (i = dim_main; i < dim_vec; i++)
+        {
+            sum += pV[i] * pB[i];
+        }
+
+        *pO++ = sum;
+
+        pB += dim_vec;
+        rowCnt--;
+    }
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of FC group
+ */
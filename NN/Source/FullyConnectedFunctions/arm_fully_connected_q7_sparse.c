@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_fully_connected_q7_sparse.c
+ * Description:  Q7 fully-connected layer with block-sparse weights
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup FC
+ * @{
+ */
+
+  /**
+   * @brief Q7 fully-connected layer function with block-sparse weights
+   * @param[in]       pV          pointer to input vector
+   * @param[in]       pM          pointer to the non-zero weight blocks
+   * @param[in]       blk_idx     column index (in blocks of 4) of each non-zero block
+   * @param[in]       row_ptr     index of the first block of each row, num_of_rows+1 entries
+   * @param[in]       dim_vec     length of the vector
+   * @param[in]       num_of_rows number of rows in weight matrix
+   * @param[in]       bias_shift  amount of left-shift for bias
+   * @param[in]       out_shift   amount of right-shift for output
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   pOut        pointer to output vector
+   * @param[in,out]   vec_buffer  pointer to buffer space for input
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * vec_buffer size: dim_vec
+   *
+   * <b>Input dimension constraints:</b>
+   *
+   * dim_vec is multiple of 4
+   *
+   * The regular (not interleaved) weight matrix is split into blocks of
+   * 4 consecutive columns and only the non-zero blocks are stored, row
+   * by row. Row i uses blocks row_ptr[i] to row_ptr[i+1]-1, and block b
+   * holds the weights of columns 4*blk_idx[b] to 4*blk_idx[b]+3.
+   *
+   */
+
+arm_status
+arm_fully_connected_q7_sparse(const q7_t * pV,
+                              const q7_t * pM,
+                              const uint16_t * blk_idx,
+                              const uint16_t * row_ptr,
+                              const uint16_t dim_vec,
+                              const uint16_t num_of_rows,
+                              const uint16_t bias_shift,
+                              const uint16_t out_shift,
+                              const q7_t * bias,
+                              q7_t * pOut,
+                              q15_t * vec_buffer)
+{
+    const uint16_t *pIdx = blk_idx;
+    const q7_t *pB = pM;
+    uint16_t  i;
+
+    if (dim_vec % 4 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    arm_q7_to_q15_no_shift(pV, vec_buffer, dim_vec);
+
+    for (i = 0; i < num_of_rows; i++)
+    {
+        q31_t     sum = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+        uint16_t  blkCnt = row_ptr[i + 1] - row_ptr[i];
+
+        while (blkCnt)
+        {
+            q31_t     inM11, inM12;
+            q31_t     inV1, inV2;
+            q15_t    *pA = vec_buffer + (*pIdx++ << 2);
+
+            pB = (q7_t *) read_and_pad((void *)pB, &inM11, &inM12);
+
+            inV1 = *__SIMD32(pA)++;
+            sum = __SMLAD(inV1, inM11, sum);
+            inV2 = *__SIMD32(pA);
+            sum = __SMLAD(inV2, inM12, sum);
+
+            blkCnt--;
+        }
+
+        pOut[i] = (q7_t) (__SSAT((sum >> out_shift), 8));
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    for (i = 0; i < num_of_rows; i++)
+    {
+        int       ip_out = ((q31_t)(bias[i]) << bias_shift) + NN_ROUND(out_shift);
+        uint16_t  blkCnt = row_ptr[i + 1] - row_ptr[i];
+
+        while (blkCnt)
+        {
+            const q7_t *pA = pV + (*pIdx++ << 2);
+
+            ip_out += pA[0] * pB[0] + pA[1] * pB[1] + pA[2] * pB[2] + pA[3] * pB[3];
+            pB += 4;
+
+            blkCnt--;
+        }
+        pOut[i] = (q7_t) __SSAT((ip_out >> out_shift), 8);
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
+    /* Return to ARM_MATH_SUCCESS */
+    return (ARM_MATH_SUCCESS);
+
+}
+
+/**
+ * @} end of FC group
+ */
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_bitmap_q7.c
+ * Description:  Bitmap storage of the non-zero values of a Q7 HWC tensor
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**    
+ * @ingroup groupSupport    
+ */
+
+/**
+ * @addtogroup NNBitmap
+ * @{
+ */
+
+/**
+ * @brief Lays out a bitmap tensor over a buffer
+ * @param[out]      *t            bitmap tensor to set up
+ * @param[in]       dim_im        tensor dimension
+ * @param[in]       ch_im         number of tensor channels
+ * @param[in]       *buffer       pointer to the storage, word aligned
+ * @param[in]       buffer_size   size of the storage in bytes
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ *
+ * \par
+ * The bitmap comes first, (dim_im * ch_im + 31) / 32 words per row, then
+ * the dim_im + 1 row offsets. The rest of the buffer takes the non-zero
+ * values. The buffer must at least hold the bitmap and the offsets.
+ */
+
+arm_status arm_nn_bitmap_init_q7(arm_nn_bitmap_q7 * t,
+                                 const uint16_t dim_im,
+                                 const uint16_t ch_im,
+                                 q7_t * buffer,
+                                 const uint32_t buffer_size)
+{
+    uint32_t  words = ((uint32_t) dim_im * ch_im + 31) >> 5;
+    uint32_t  head = (dim_im * words + dim_im + 1) * sizeof(uint32_t);
+
+    if (buffer_size < head)
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    t->dim = dim_im;
+    t->ch = ch_im;
+    t->bitmap = (uint32_t *) buffer;
+    t->row_start = t->bitmap + dim_im * words;
+    t->val = buffer + head;
+    t->val_size = buffer_size - head;
+    t->row_start[0] = 0;
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @brief Appends a row to a bitmap tensor
+ * @param[in,out]   *t            bitmap tensor
+ * @param[in]       y             row index, the rows are written in order
+ * @param[in]       *row          pointer to the dense row, dim * ch values
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ *
+ * \par
+ * Element e of the row is bit 31 - (e % 32) of word e / 32, so that
+ * __CLZ finds the elements in order. ARM_MATH_SIZE_MISMATCH is returned
+ * when the non-zero values no longer fit, the tensor is then unusable.
+ * On Cortex-M4 and Cortex-M7 the row must be word aligned, all-zero
+ * groups of four values are skipped with one compare.
+ */
+
+arm_status arm_nn_bitmap_put_row_q7(arm_nn_bitmap_q7 * t,
+                                    const uint16_t y,
+                                    const q7_t * row)
+{
+    uint32_t  len = (uint32_t) t->dim * t->ch;
+    uint32_t  words = (len + 31) >> 5;
+    uint32_t *pMap = t->bitmap + y * words;
+    uint32_t  n = t->row_start[y];
+    uint32_t  e;
+
+    memset(pMap, 0, words * sizeof(uint32_t));
+
+    for (e = 0; e < len; e++)
+    {
+#if defined (ARM_MATH_DSP)
+        /* Run the following code for Cortex-M4 and Cortex-M7 */
+        if ((e & 0x3) == 0 && e + 4 <= len && *__SIMD32_CONST(row + e) == 0)
+        {
+            e += 3;
+            continue;
+        }
+#endif
+        if (row[e] != 0)
+        {
+            if (n == t->val_size)
+            {
+                return ARM_MATH_SIZE_MISMATCH;
+            }
+            pMap[e >> 5] |= 0x80000000u >> (e & 0x1F);
+            t->val[n++] = row[e];
+        }
+    }
+
+    t->row_start[y + 1] = n;
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @brief Expands a row of a bitmap tensor
+ * @param[in]       *t            bitmap tensor
+ * @param[in]       y             row index
+ * @param[out]      *row          pointer to the dense row, dim * ch values
+ * @return none.
+ *
+ * \par
+ * The row is cleared and only the non-zero values are written, one
+ * __CLZ per value, so the zero words of the bitmap cost nothing.
+ */
+
+void arm_nn_bitmap_get_row_q7(const arm_nn_bitmap_q7 * t,
+                              const uint16_t y,
+                              q7_t * row)
+{
+    uint32_t  len = (uint32_t) t->dim * t->ch;
+    uint32_t  words = (len + 31) >> 5;
+    const uint32_t *pMap = t->bitmap + y * words;
+    const q7_t *pVal = t->val + t->row_start[y];
+    uint32_t  i;
+
+    memset(row, 0, len);
+
+    for (i = 0; i < words; i++)
+    {
+        uint32_t  w = pMap[i];
+
+        while (w)
+        {
+            uint32_t  b = __CLZ(w);
+
+            row[(i << 5) + b] = *pVal++;
+            w &= ~(0x80000000u >> b);
+        }
+    }
+}
+
+/**
+ * @brief Storage used by a complete bitmap tensor
+ * @param[in]       *t            bitmap tensor with all its rows written
+ * @return          bytes from the start of the buffer to the last value.
+ */
+
+uint32_t arm_nn_bitmap_size_q7(const arm_nn_bitmap_q7 * t)
+{
+    return (uint32_t) (t->val - (q7_t *) t->bitmap) + t->row_start[t->dim];
+}
+
+/**
+ * @} end of NNBitmap group
+ */
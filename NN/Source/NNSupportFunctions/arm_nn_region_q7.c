@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_region_q7.c
+ * Description:  Dirty-region helpers for incremental execution
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNRegion
+ * @{
+ */
+
+  /**
+   * @brief Finds the region of a Q7 HWC tensor that changed and updates the cache
+   * @param[in]       pIn         pointer to the new input tensor
+   * @param[in,out]   pCache      pointer to the cached tensor of the previous frame
+   * @param[in]       dim_im      tensor dimension
+   * @param[in]       ch_im       number of tensor channels
+   * @param[out]      rect        bounding rectangle of the changed pixels
+   * @return none.
+   *
+   * @details
+   *
+   * A pixel is changed when any of its channels differs from the cache.
+   * The changed pixels are copied into the cache while comparing, so after
+   * the call the cache holds the new tensor. If nothing changed the
+   * returned rectangle is empty.
+   */
+
+void arm_nn_diff_rect_q7(const q7_t * pIn,
+                         q7_t * pCache,
+                         const uint16_t dim_im,
+                         const uint16_t ch_im,
+                         arm_nn_rect * rect)
+{
+    int16_t   i_x, i_y;
+    int16_t   x0 = dim_im, y0 = dim_im, x1 = 0, y1 = 0;
+
+    for (i_y = 0; i_y < dim_im; i_y++)
+    {
+        for (i_x = 0; i_x < dim_im; i_x++)
+        {
+            if (memcmp(pIn, pCache, ch_im) != 0)
+            {
+                memcpy(pCache, pIn, ch_im);
+
+                if (i_x < x0)
+                    x0 = i_x;
+                if (i_x >= x1)
+                    x1 = i_x + 1;
+                if (i_y < y0)
+                    y0 = i_y;
+                y1 = i_y + 1;
+            }
+            pIn += ch_im;
+            pCache += ch_im;
+        }
+    }
+
+    if (x1 == 0)
+    {
+        /* nothing changed */
+        x0 = y0 = 0;
+    }
+
+    rect->x0 = x0;
+    rect->y0 = y0;
+    rect->x1 = x1;
+    rect->y1 = y1;
+}
+
+  /**
+   * @brief Propagates a dirty region through a convolution or pooling layer
+   * @param[in]       in          changed region of the layer input
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[out]      out         region of the layer output that must be recomputed
+   * @return none.
+   *
+   * @details
+   *
+   * Output pixel o reads the input pixels [o*stride-padding, o*stride-padding+dim_kernel),
+   * so it must be recomputed when that window overlaps the input region.
+   * Element-wise layers (e.g. ReLU) keep the region unchanged.
+   */
+
+void arm_nn_rect_propagate(const arm_nn_rect * in,
+                           const uint16_t dim_kernel,
+                           const uint16_t padding,
+                           const uint16_t stride,
+                           const uint16_t dim_im_out,
+                           arm_nn_rect * out)
+{
+    int32_t   lo, hi;
+
+    if (in->x0 >= in->x1 || in->y0 >= in->y1)
+    {
+        out->x0 = out->y0 = out->x1 = out->y1 = 0;
+        return;
+    }
+
+    /* first output whose window ends at or after in->x0, i.e. ceil((x0 + padding - dim_kernel + 1) / stride) */
+    lo = in->x0 + padding - dim_kernel + 1;
+    lo = lo <= 0 ? 0 : (lo + stride - 1) / stride;
+    /* last output whose window starts before in->x1, plus one */
+    hi = (in->x1 - 1 + padding) / stride + 1;
+    out->x0 = lo;
+    out->x1 = hi > dim_im_out ? dim_im_out : hi;
+
+    lo = in->y0 + padding - dim_kernel + 1;
+    lo = lo <= 0 ? 0 : (lo + stride - 1) / stride;
+    hi = (in->y1 - 1 + padding) / stride + 1;
+    out->y0 = lo;
+    out->y1 = hi > dim_im_out ? dim_im_out : hi;
+
+    if (out->x0 >= out->x1 || out->y0 >= out->y1)
+    {
+        out->x0 = out->y0 = out->x1 = out->y1 = 0;
+    }
+}
+
+/**
+ * @} end of NNRegion group
+ */
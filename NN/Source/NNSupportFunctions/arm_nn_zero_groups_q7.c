@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_zero_groups_q7.c
+ * Description:  Counts the all-zero groups of four Q7 values
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**    
+ * @ingroup groupSupport    
+ */
+
+/**
+ * @addtogroup NNBasicMath
+ * @{
+ */
+
+
+/**
+ * @brief           Q7 count of the all-zero groups of four values
+ * @param[in]       *pSrc         pointer to the input vector
+ * @param[in]       blockSize     number of samples in the vector
+ * @return          number of groups of four consecutive samples that are all zero.
+ *
+ * \par
+ * The zero groups are the ones arm_convolve_HWC_q7_fast_zero_skip() skips
+ * when the vector is the channels of a tensor. The remaining 1 to 3
+ * samples are not counted. pSrc is read one word at a time and must be
+ * word aligned.
+ */
+
+uint32_t arm_nn_zero_groups_q7(
+  const q7_t * pSrc,
+  uint32_t blockSize)
+{
+  uint32_t blkCnt = blockSize >> 2U;             /* loop counter */
+  uint32_t zeroCnt = 0;
+
+  while (blkCnt > 0U)
+  {
+    /* one compare for four samples */
+    if (*__SIMD32_CONST(pSrc) == 0)
+    {
+      zeroCnt++;
+    }
+    pSrc += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  return zeroCnt;
+}
+
+/**
+ * @} end of NNBasicMath group
+ */
@@ -29,6 +29,7 @@
  * -------------------------------------------------------------------- */
 
 #include "arm_nnsupportfunctions.h"
+#include "arm_nn_tables.h"
 
 /**
  * @brief tables for various activation functions
@@ -64,7 +65,7 @@
  * i.e., 0x0110 0000 - 0x1011 1111
  */
 
-const q7_t sigmoidTable_q7[256] = {
+ARM_NN_TABLE_CONST q7_t sigmoidTable_q7[256] = {
     0x40, 0x42, 0x44, 0x46, 0x48, 0x4a, 0x4c, 0x4e,
     0x50, 0x52, 0x53, 0x55, 0x57, 0x59, 0x5a, 0x5c,
     0x5e, 0x5f, 0x61, 0x62, 0x63, 0x65, 0x66, 0x67,
@@ -99,7 +100,7 @@ const q7_t sigmoidTable_q7[256] = {
     0x30, 0x32, 0x34, 0x36, 0x38, 0x3a, 0x3c, 0x3e,
 };
 
-const q15_t sigmoidTable_q15[256] = {
+ARM_NN_TABLE_CONST q15_t sigmoidTable_q15[256] = {
     0x4000, 0x4200, 0x43ff, 0x45fc, 0x47f5, 0x49eb, 0x4bdc, 0x4dc8,
     0x4fad, 0x518a, 0x5360, 0x552c, 0x56ef, 0x58a8, 0x5a57, 0x5bfb,
     0x5d93, 0x5f20, 0x60a1, 0x6216, 0x637f, 0x64db, 0x662b, 0x676f,
@@ -180,7 +181,7 @@ const q15_t sigmoidHTable_q15[192] = {
     0x09b6, 0x0a49, 0x0ae5, 0x0b88, 0x0c34, 0x0cea, 0x0da8, 0x0e70,
 };
 
-const q7_t tanhTable_q7[256] = {
+ARM_NN_TABLE_CONST q7_t tanhTable_q7[256] = {
     0x00, 0x08, 0x10, 0x18, 0x1f, 0x27, 0x2e, 0x35,
     0x3b, 0x41, 0x47, 0x4c, 0x51, 0x56, 0x5a, 0x5e,
     0x61, 0x65, 0x68, 0x6a, 0x6d, 0x6f, 0x71, 0x72,
@@ -215,7 +216,7 @@ const q7_t tanhTable_q7[256] = {
     0xc5, 0xcb, 0xd2, 0xd9, 0xe1, 0xe8, 0xf0, 0xf8,
 };
 
-const q15_t tanhTable_q15[256] = {
+ARM_NN_TABLE_CONST q15_t tanhTable_q15[256] = {
     0x0000, 0x07fd, 0x0feb, 0x17b9, 0x1f59, 0x26bf, 0x2ddf, 0x34ae,
     0x3b27, 0x4142, 0x46fd, 0x4c56, 0x514d, 0x55e2, 0x5a1a, 0x5df6,
     0x617c, 0x64b0, 0x6797, 0x6a37, 0x6c95, 0x6eb5, 0x709e, 0x7254,
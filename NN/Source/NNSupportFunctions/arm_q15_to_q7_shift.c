@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_q15_to_q7_shift.c
+ * Description:  Converts the elements of the Q15 vector to Q7 vector with rounding right-shift
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**    
+ * @ingroup groupSupport    
+ */
+
+/**    
+ * @addtogroup nndata_convert    
+ * @{    
+ */
+
+/**    
+ * @brief Converts the elements of the Q15 vector to Q7 vector with rounding right-shift
+ * @param[in]       *pSrc points to the Q15 input vector    
+ * @param[out]      *pDst points to the Q7 output vector   
+ * @param[in]       shift number of fractional bits to drop
+ * @param[in]       blockSize length of the input vector    
+ * @return none.    
+ *    
+ * \par Description:    
+ *    
+ * The equation used for the conversion process is:    
+ *   
+ * <pre>    
+ * 	pDst[n] = (q7_t) __SSAT((pSrc[n] + NN_ROUND(shift)) >> shift, 8);   0 <= n < blockSize.    
+ * </pre>    
+ *   
+ */
+
+void arm_q15_to_q7_shift(const q15_t * pSrc, q7_t * pDst, const uint16_t shift, uint32_t blockSize)
+{
+    const q15_t *pIn = pSrc;    /* Src pointer */
+    uint32_t  blkCnt;           /* loop counter */
+    const q31_t round = NN_ROUND(shift);
+
+#if defined (ARM_MATH_DSP)
+    q31_t     in1, in2;
+    q31_t     out1, out2, out3, out4;
+
+    /* Run the below code for Cortex-M4 and Cortex-M7 */
+
+    /*loop Unrolling */
+    blkCnt = blockSize >> 2u;
+
+    /* First part of the processing with loop unrolling.  Compute 4 outputs at a time.    
+     ** a second loop below computes the remaining 1 to 3 samples. */
+    while (blkCnt > 0u)
+    {
+        in1 = *__SIMD32(pIn)++;
+        in2 = *__SIMD32(pIn)++;
+
+#ifndef ARM_MATH_BIG_ENDIAN
+        out1 = __SSAT(((q15_t) in1 + round) >> shift, 8);
+        out2 = __SSAT(((in1 >> 16) + round) >> shift, 8);
+        out3 = __SSAT(((q15_t) in2 + round) >> shift, 8);
+        out4 = __SSAT(((in2 >> 16) + round) >> shift, 8);
+#else
+        out2 = __SSAT(((q15_t) in1 + round) >> shift, 8);
+        out1 = __SSAT(((in1 >> 16) + round) >> shift, 8);
+        out4 = __SSAT(((q15_t) in2 + round) >> shift, 8);
+        out3 = __SSAT(((in2 >> 16) + round) >> shift, 8);
+#endif
+
+        *__SIMD32(pDst)++ = __PACKq7(out1, out2, out3, out4);
+
+        /* Decrement the loop counter */
+        blkCnt--;
+    }
+
+    /* If the blockSize is not a multiple of 4, compute any remaining output samples here.    
+     ** No loop unrolling is used. */
+    blkCnt = blockSize % 0x4u;
+
+#else
+
+    /* Run the below code for Cortex-M0 and Cortex-M3 */
+
+    /* Loop over blockSize number of values */
+    blkCnt = blockSize;
+
+#endif                          /* ARM_MATH_DSP */
+
+    while (blkCnt > 0u)
+    {
+        *pDst++ = (q7_t) __SSAT((*pIn++ + round) >> shift, 8);
+
+        /* Decrement the loop counter */
+        blkCnt--;
+    }
+
+}
+
+/**    
+ * @} end of nndata_convert group   
+ */
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_maxpool_q7_HWC_bitmap.c
+ * Description:  Q7 max pooling function writing a bitmap tensor
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Pooling
+ * @{
+ */
+
+  /**
+   * @brief Q7 max pooling function with a bitmap tensor output
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for one output row
+   * @param[in,out]   Im_out      bitmap tensor set up with arm_nn_bitmap_init_q7
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size:  dim_im_out*ch_im_in
+   *
+   * Same output as arm_maxpool_q7_HWC(), computed one output row at a
+   * time in bufferA and appended to Im_out, so the dense output is never
+   * stored. Unlike arm_maxpool_q7_HWC, this function is not
+   * input-destructive: when ARM_MATH_SIZE_MISMATCH is returned because
+   * the non-zero values do not fit, the input can still be pooled densely.
+   *
+   */
+
+arm_status
+arm_maxpool_q7_HWC_to_bitmap(const q7_t * Im_in,
+                             const uint16_t dim_im_in,
+                             const uint16_t ch_im_in,
+                             const uint16_t dim_kernel,
+                             const uint16_t padding,
+                             const uint16_t stride,
+                             const uint16_t dim_im_out,
+                             q7_t * bufferA,
+                             arm_nn_bitmap_q7 * Im_out)
+{
+    int16_t   i_x, i_y;
+    int16_t   k_x, k_y;
+    int16_t   x_start, x_stop, y_start, y_stop;
+
+    if (Im_out->dim != dim_im_out || Im_out->ch != ch_im_in)
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_y = 0; i_y < dim_im_out; i_y++)
+    {
+        /* window rows clipped to the input */
+        y_start = i_y * stride - padding;
+        y_stop = y_start + dim_kernel;
+        if (y_start < 0)
+            y_start = 0;
+        if (y_stop > dim_im_in)
+            y_stop = dim_im_in;
+
+        for (i_x = 0; i_x < dim_im_out; i_x++)
+        {
+            q7_t     *target = bufferA + i_x * ch_im_in;
+
+            /* window columns clipped to the input */
+            x_start = i_x * stride - padding;
+            x_stop = x_start + dim_kernel;
+            if (x_start < 0)
+                x_start = 0;
+            if (x_stop > dim_im_in)
+                x_stop = dim_im_in;
+
+            /* first step is to copy over initial data */
+            memcpy(target, Im_in + (y_start * dim_im_in + x_start) * ch_im_in, ch_im_in);
+
+            for (k_y = y_start; k_y < y_stop; k_y++)
+            {
+                for (k_x = x_start; k_x < x_stop; k_x++)
+                {
+                    const q7_t *pCom = Im_in + (k_y * dim_im_in + k_x) * ch_im_in;
+                    q7_t     *pIn = target;
+                    uint16_t  cnt;
+
+#if defined (ARM_MATH_DSP)
+                    /* Run the following code for Cortex-M4 and Cortex-M7 */
+                    union arm_nnword in;
+                    union arm_nnword com;
+
+                    cnt = ch_im_in >> 2;
+                    while (cnt > 0u)
+                    {
+                        in.word = *__SIMD32(pIn);
+                        com.word = *__SIMD32(pCom)++;
+
+                        if (com.bytes[0] > in.bytes[0])
+                            in.bytes[0] = com.bytes[0];
+                        if (com.bytes[1] > in.bytes[1])
+                            in.bytes[1] = com.bytes[1];
+                        if (com.bytes[2] > in.bytes[2])
+                            in.bytes[2] = com.bytes[2];
+                        if (com.bytes[3] > in.bytes[3])
+                            in.bytes[3] = com.bytes[3];
+
+                        *__SIMD32(pIn)++ = in.word;
+
+                        cnt--;
+                    }
+                    cnt = ch_im_in & 0x3;
+#else
+                    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+                    cnt = ch_im_in;
+#endif                          /* ARM_MATH_DSP */
+
+                    while (cnt > 0u)
+                    {
+                        if (*pCom > *pIn)
+                            *pIn = *pCom;
+                        pIn++;
+                        pCom++;
+                        cnt--;
+                    }
+                }
+            }
+        }
+
+        if (arm_nn_bitmap_put_row_q7(Im_out, i_y, bufferA) != ARM_MATH_SUCCESS)
+        {
+            return ARM_MATH_SIZE_MISMATCH;
+        }
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of Pooling group
+ */
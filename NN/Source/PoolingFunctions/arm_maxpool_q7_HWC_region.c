@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_maxpool_q7_HWC_region.c
+ * Description:  Q7 max pooling restricted to a region of the output
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Pooling
+ * @{
+ */
+
+  /**
+   * @brief Q7 max pooling function restricted to an output region
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       region      region of the output tensor to compute
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @return none.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size:  0
+   *
+   * Unlike arm_maxpool_q7_HWC, this function is not input-destructive,
+   * as the input tensor is kept as the cache of the previous frame in
+   * incremental execution. Only the output pixels inside region are
+   * written.
+   *
+   */
+
+void
+arm_maxpool_q7_HWC_region(const q7_t * Im_in,
+                          const uint16_t dim_im_in,
+                          const uint16_t ch_im_in,
+                          const uint16_t dim_kernel,
+                          const uint16_t padding,
+                          const uint16_t stride,
+                          const uint16_t dim_im_out,
+                          const arm_nn_rect * region,
+                          q7_t * Im_out)
+{
+    int16_t   i_x, i_y;
+    int16_t   k_x, k_y;
+    int16_t   x_start, x_stop, y_start, y_stop;
+
+    for (i_y = region->y0; i_y < region->y1; i_y++)
+    {
+        /* window rows clipped to the input */
+        y_start = i_y * stride - padding;
+        y_stop = y_start + dim_kernel;
+        if (y_start < 0)
+            y_start = 0;
+        if (y_stop > dim_im_in)
+            y_stop = dim_im_in;
+
+        for (i_x = region->x0; i_x < region->x1; i_x++)
+        {
+            q7_t     *target = Im_out + (i_y * dim_im_out + i_x) * ch_im_in;
+
+            /* window columns clipped to the input */
+            x_start = i_x * stride - padding;
+            x_stop = x_start + dim_kernel;
+            if (x_start < 0)
+                x_start = 0;
+            if (x_stop > dim_im_in)
+                x_stop = dim_im_in;
+
+            /* first step is to copy over initial data */
+            memcpy(target, Im_in + (y_start * dim_im_in + x_start) * ch_im_in, ch_im_in);
+
+            for (k_y = y_start; k_y < y_stop; k_y++)
+            {
+                for (k_x = x_start; k_x < x_stop; k_x++)
+                {
+                    const q7_t *pCom = Im_in + (k_y * dim_im_in + k_x) * ch_im_in;
+                    q7_t     *pIn = target;
+                    uint16_t  cnt;
+
+#if defined (ARM_MATH_DSP)
+                    /* Run the following code for Cortex-M4 and Cortex-M7 */
+                    union arm_nnword in;
+                    union arm_nnword com;
+
+                    cnt = ch_im_in >> 2;
+                    while (cnt > 0u)
+                    {
+                        in.word = *__SIMD32(pIn);
+                        com.word = *__SIMD32(pCom)++;
+
+                        if (com.bytes[0] > in.bytes[0])
+                            in.bytes[0] = com.bytes[0];
+                        if (com.bytes[1] > in.bytes[1])
+                            in.bytes[1] = com.bytes[1];
+                        if (com.bytes[2] > in.bytes[2])
+                            in.bytes[2] = com.bytes[2];
+                        if (com.bytes[3] > in.bytes[3])
+                            in.bytes[3] = com.bytes[3];
+
+                        *__SIMD32(pIn)++ = in.word;
+
+                        cnt--;
+                    }
+                    cnt = ch_im_in & 0x3;
+#else
+                    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+                    cnt = ch_im_in;
+#endif                          /* ARM_MATH_DSP */
+
+                    while (cnt > 0u)
+                    {
+                        if (*pCom > *pIn)
+                            *pIn = *pCom;
+                        pIn++;
+                        pCom++;
+                        cnt--;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @} end of Pooling group
+ */
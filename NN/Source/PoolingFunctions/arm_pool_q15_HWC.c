@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_pool_q15_HWC.c
+ * Description:  Q15 pooling function implementations
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Pooling
+ * @{
+ */
+
+  /**
+   * @brief Q15 max pooling function
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @return none.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size:  0
+   *
+   * Each output pixel takes the maximum over its window clipped to the
+   * input, 2 channels per word. The input tensor is not modified.
+   *
+   */
+
+void
+arm_maxpool_q15_HWC(const q15_t * Im_in,
+                    const uint16_t dim_im_in,
+                    const uint16_t ch_im_in,
+                    const uint16_t dim_kernel,
+                    const uint16_t padding,
+                    const uint16_t stride,
+                    const uint16_t dim_im_out,
+                    q15_t * bufferA,
+                    q15_t * Im_out)
+{
+    int16_t   i_x, i_y;
+    int16_t   k_x, k_y;
+    int16_t   x_start, x_stop, y_start, y_stop;
+
+    for (i_y = 0; i_y < dim_im_out; i_y++)
+    {
+        /* window rows clipped to the input */
+        y_start = i_y * stride - padding;
+        y_stop = y_start + dim_kernel;
+        if (y_start < 0)
+            y_start = 0;
+        if (y_stop > dim_im_in)
+            y_stop = dim_im_in;
+
+        for (i_x = 0; i_x < dim_im_out; i_x++)
+        {
+            q15_t    *target = Im_out + (i_y * dim_im_out + i_x) * ch_im_in;
+
+            /* window columns clipped to the input */
+            x_start = i_x * stride - padding;
+            x_stop = x_start + dim_kernel;
+            if (x_start < 0)
+                x_start = 0;
+            if (x_stop > dim_im_in)
+                x_stop = dim_im_in;
+
+            /* first step is to copy over initial data */
+            memcpy(target, Im_in + (y_start * dim_im_in + x_start) * ch_im_in, sizeof(q15_t) * ch_im_in);
+
+            for (k_y = y_start; k_y < y_stop; k_y++)
+            {
+                for (k_x = x_start; k_x < x_stop; k_x++)
+                {
+                    const q15_t *pCom = Im_in + (k_y * dim_im_in + k_x) * ch_im_in;
+                    q15_t    *pIn = target;
+                    uint16_t  cnt;
+
+#if defined (ARM_MATH_DSP)
+                    /* Run the following code for Cortex-M4 and Cortex-M7 */
+                    union arm_nnword in;
+                    union arm_nnword com;
+
+                    cnt = ch_im_in >> 1;
+                    while (cnt > 0u)
+                    {
+                        in.word = *__SIMD32(pIn);
+                        com.word = *__SIMD32(pCom)++;
+
+                        if (com.half_words[0] > in.half_words[0])
+                            in.half_words[0] = com.half_words[0];
+                        if (com.half_words[1] > in.half_words[1])
+                            in.half_words[1] = com.half_words[1];
+
+                        *__SIMD32(pIn)++ = in.word;
+
+                        cnt--;
+                    }
+                    cnt = ch_im_in & 0x1;
+#else
+                    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+                    cnt = ch_im_in;
+#endif                          /* ARM_MATH_DSP */
+
+                    while (cnt > 0u)
+                    {
+                        if (*pCom > *pIn)
+                            *pIn = *pCom;
+                        pIn++;
+                        pCom++;
+                        cnt--;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @} end of Pooling group
+ */
@@ -39,16 +39,6 @@
  * 
  */
 
-static void buffer_scale_back_q15_to_q7(q15_t * buffer, q7_t * target, uint16_t length, uint16_t scale)
-{
-    int       i;
-
-    for (i = 0; i < length; i++)
-    {
-        target[i] = (q7_t) (buffer[i] / scale);
-    }
-}
-
 static void compare_and_replace_if_larger_q7(q7_t * base,   // base data
                                              q7_t * target, // compare target
                                              const uint16_t length  // data length
@@ -79,46 +69,91 @@ static void compare_and_replace_if_larger_q7(q7_t * base,   // base data
 
         cnt--;
     }
+
+    // left-over channels when length is not a multiple of 4
+    cnt = length & 0x3;
+    while (cnt > 0u)
+    {
+        if (*pCom > *pIn)
+            *pIn = *pCom;
+        pIn++;
+        pCom++;
+
+        cnt--;
+    }
 }
 
-static void accumulate_q7_to_q15(q15_t * base, q7_t * target, const uint16_t length)
+/*
+ * Averages the window [y0, y1) x [x0, x1) of every channel into pOut.
+ *
+ * 4 channels are summed at a time in two registers of q15 pairs, the
+ * pairs are widened to q31 after each window row so dim_kernel only has
+ * to stay below 256.
+ */
+static void avepool_window_q7(const q7_t * Im_in,
+                              const uint16_t dim_im_in,
+                              const uint16_t ch_im_in,
+                              const int16_t y0,
+                              const int16_t y1,
+                              const int16_t x0,
+                              const int16_t x1,
+                              const arm_nn_recip * recip,
+                              q7_t * pOut)
 {
-    q15_t    *pCnt = base;
-    q7_t     *pV = target;
-    q31_t     v1, v2, vo1, vo2;
-    uint16_t  cnt = length >> 2;
-    q31_t     in;
+    int16_t   k_x, k_y;
+    uint16_t  i_ch = 0;
 
-    while (cnt > 0u)
+    for (; i_ch + 4 <= ch_im_in; i_ch += 4)
     {
-        q31_t     value = *__SIMD32(pV)++;
-        v1 = __SXTB16(__ROR(value, 8));
-        v2 = __SXTB16(value);
-#ifndef ARM_MATH_BIG_ENDIAN
+        q31_t     sumAl = 0, sumAh = 0, sumBl = 0, sumBh = 0;
 
-        vo2 = __PKHTB(v1, v2, 16);
-        vo1 = __PKHBT(v2, v1, 16);
-
-#else
+        for (k_y = y0; k_y < y1; k_y++)
+        {
+            const q7_t *pIn = Im_in + (k_y * dim_im_in + x0) * ch_im_in + i_ch;
+            q31_t     accA = 0;
+            q31_t     accB = 0;
 
-        vo1 = __PKHTB(v1, v2, 16);
-        vo2 = __PKHBT(v2, v1, 16);
+            for (k_x = x0; k_x < x1; k_x++)
+            {
+                q31_t     in = *__SIMD32(pIn);
+                accA = __SXTAB16(accA, in);
+                accB = __SXTAB16(accB, __ROR(in, 8));
+                pIn += ch_im_in;
+            }
+            sumAl += (q15_t) accA;
+            sumAh += accA >> 16;
+            sumBl += (q15_t) accB;
+            sumBh += accB >> 16;
+        }
 
+#ifndef ARM_MATH_BIG_ENDIAN
+        *pOut++ = (q7_t) arm_nn_div_recip(sumAl, recip);
+        *pOut++ = (q7_t) arm_nn_div_recip(sumBl, recip);
+        *pOut++ = (q7_t) arm_nn_div_recip(sumAh, recip);
+        *pOut++ = (q7_t) arm_nn_div_recip(sumBh, recip);
+#else
+        *pOut++ = (q7_t) arm_nn_div_recip(sumBh, recip);
+        *pOut++ = (q7_t) arm_nn_div_recip(sumAh, recip);
+        *pOut++ = (q7_t) arm_nn_div_recip(sumBl, recip);
+        *pOut++ = (q7_t) arm_nn_div_recip(sumAl, recip);
 #endif
+    }
 
-        in = *__SIMD32(pCnt);
-        *__SIMD32(pCnt)++ = __QADD16(vo1, in);
+    for (; i_ch < ch_im_in; i_ch++)
+    {
+        q31_t     sum = 0;
 
-        in = *__SIMD32(pCnt);
-        *__SIMD32(pCnt)++ = __QADD16(vo2, in);
+        for (k_y = y0; k_y < y1; k_y++)
+        {
+            const q7_t *pIn = Im_in + (k_y * dim_im_in + x0) * ch_im_in + i_ch;
 
-        cnt--;
-    }
-    cnt = length & 0x3;
-    while (cnt > 0u)
-    {
-        *pCnt++ += *pV++;
-        cnt--;
+            for (k_x = x0; k_x < x1; k_x++)
+            {
+                sum += *pIn;
+                pIn += ch_im_in;
+            }
+        }
+        *pOut++ = (q7_t) arm_nn_div_recip(sum, recip);
     }
 }
 
@@ -287,14 +322,16 @@ arm_maxpool_q7_HWC(q7_t * Im_in,
 }
 
   /**
-   * @brief Q7 average pooling function
-   * @param[in,out]   Im_in       pointer to input tensor
+   * @brief Q7 max pooling function on strided tensors
+   * @param[in, out]  Im_in       pointer to input tensor
    * @param[in]       dim_im_in   input tensor dimention
    * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       in_pixel_stride   distance between two input pixels, at least ch_im_in
    * @param[in]       dim_kernel  filter kernel size
    * @param[in]       padding     padding sizes
    * @param[in]       stride      convolution stride
    * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       out_pixel_stride  distance between two output pixels, at least ch_im_in
    * @param[in,out]   bufferA     pointer to buffer space for input
    * @param[in,out]   Im_out      pointer to output tensor
    * @return none.
@@ -303,40 +340,47 @@ arm_maxpool_q7_HWC(q7_t * Im_in,
    *
    * <b>Buffer size:</b>
    *
-   * bufferA size:  2*dim_im_out*ch_im_in
+   * bufferA size:  0
    *
-   * The pooling function is implemented as split x-pooling then
-   * y-pooling.
+   * Same as arm_maxpool_q7_HWC() except that the pixels of the input and
+   * output tensors are in_pixel_stride and out_pixel_stride elements apart,
+   * so a channel slice of a wider tensor can be pooled in place of a copy.
+   * Point Im_in or Im_out at the first channel of the slice. The y-pooling
+   * works pixel by pixel since the rows are no longer contiguous.
    *
-   * This pooling function is input-destructive. Input data is undefined
-   * after calling this function.
+   * This pooling function is input-destructive, within the ch_im_in
+   * channels of every input pixel.
    *
    */
 
 void
-arm_avepool_q7_HWC(q7_t * Im_in,
-                   const uint16_t dim_im_in,
-                   const uint16_t ch_im_in,
-                   const uint16_t dim_kernel,
-                   const uint16_t padding,
-                   const uint16_t stride, const uint16_t dim_im_out, q7_t * bufferA, q7_t * Im_out)
+arm_maxpool_q7_HWC_ex(q7_t * Im_in,
+                      const uint16_t dim_im_in,
+                      const uint16_t ch_im_in,
+                      const uint16_t in_pixel_stride,
+                      const uint16_t dim_kernel,
+                      const uint16_t padding,
+                      const uint16_t stride,
+                      const uint16_t dim_im_out,
+                      const uint16_t out_pixel_stride,
+                      q7_t * bufferA,
+                      q7_t * Im_out)
 {
 
 #if defined (ARM_MATH_DSP)
     /* Run the following code for Cortex-M4 and Cortex-M7 */
 
-    q15_t    *buffer = (q15_t *) bufferA;
-    int16_t   i_x, i_y;
-    int16_t   count = 0;
+    int16_t   i_x, i_y, k_y;
 
     /* first does the pooling along x axis */
     for (i_y = 0; i_y < dim_im_in; i_y++)
     {
+        q7_t     *row = Im_in + i_y * dim_im_in * in_pixel_stride;
 
         for (i_x = 0; i_x < dim_im_out; i_x++)
         {
             /* for each output pixel */
-            q7_t     *target = Im_in + (i_y * dim_im_in + i_x) * ch_im_in;
+            q7_t     *target = row + i_x * in_pixel_stride;
             q7_t     *win_start;
             q7_t     *win_stop;
             if (i_x * stride - padding < 0)
@@ -344,69 +388,175 @@ arm_avepool_q7_HWC(q7_t * Im_in,
                 win_start = target;
             } else
             {
-                win_start = Im_in + (i_y * dim_im_in + i_x * stride - padding) * ch_im_in;
+                win_start = row + (i_x * stride - padding) * in_pixel_stride;
             }
 
             if (i_x * stride - padding + dim_kernel >= dim_im_in)
             {
-                win_stop = Im_in + (i_y * dim_im_in + dim_im_in) * ch_im_in;
+                win_stop = row + dim_im_in * in_pixel_stride;
             } else
             {
-                win_stop = Im_in + (i_y * dim_im_in + i_x * stride - padding + dim_kernel) * ch_im_in;
+                win_stop = row + (i_x * stride - padding + dim_kernel) * in_pixel_stride;
             }
 
             /* first step is to copy over initial data */
-            arm_q7_to_q15_no_shift(win_start, buffer, ch_im_in);
-            count = 1;
+            memmove(target, win_start, ch_im_in);
 
             /* start the max operation from the second part */
-            win_start += ch_im_in;
-            for (; win_start < win_stop; win_start += ch_im_in)
+            win_start += in_pixel_stride;
+            for (; win_start < win_stop; win_start += in_pixel_stride)
             {
-                accumulate_q7_to_q15(buffer, win_start, ch_im_in);
-                count++;
+                compare_and_replace_if_larger_q7(target, win_start, ch_im_in);
             }
-            buffer_scale_back_q15_to_q7(buffer, target, ch_im_in, count);
         }
     }
 
     /* then does the pooling along y axis */
     for (i_y = 0; i_y < dim_im_out; i_y++)
     {
-        /* for each output row */
-        q7_t     *target = Im_out + i_y * dim_im_out * ch_im_in;
-        q7_t     *row_start;
-        q7_t     *row_end;
-        /* setting the starting row */
-        if (i_y * stride - padding < 0)
+        int16_t   row_first = i_y * stride - padding;
+        int16_t   row_last = i_y * stride - padding + dim_kernel;
+
+        if (row_first < 0)
         {
-            row_start = Im_in;
-        } else
+            row_first = 0;
+        }
+        if (row_last > dim_im_in)
         {
-            row_start = Im_in + (i_y * stride - padding) * dim_im_in * ch_im_in;
+            row_last = dim_im_in;
         }
-        /* setting the stopping row */
-        if (i_y * stride - padding + dim_kernel >= dim_im_in)
+
+        for (i_x = 0; i_x < dim_im_out; i_x++)
         {
-            row_end = Im_in + dim_im_in * dim_im_in * ch_im_in;
-        } else
+            q7_t     *target = Im_out + (i_y * dim_im_out + i_x) * out_pixel_stride;
+
+            /* copy over the first row */
+            memmove(target, Im_in + (row_first * dim_im_in + i_x) * in_pixel_stride, ch_im_in);
+
+            for (k_y = row_first + 1; k_y < row_last; k_y++)
+            {
+                compare_and_replace_if_larger_q7(target, Im_in + (k_y * dim_im_in + i_x) * in_pixel_stride, ch_im_in);
+            }
+        }
+    }
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    int16_t   i_ch_in, i_x, i_y;
+    int16_t   k_x, k_y;
+
+    for (i_ch_in = 0; i_ch_in < ch_im_in; i_ch_in++)
+    {
+        for (i_y = 0; i_y < dim_im_out; i_y++)
         {
-            row_end = Im_in + (i_y * stride - padding + dim_kernel) * dim_im_in * ch_im_in;
+            for (i_x = 0; i_x < dim_im_out; i_x++)
+            {
+                int       max = -129;
+                for (k_y = i_y * stride - padding; k_y < i_y * stride - padding + dim_kernel; k_y++)
+                {
+                    for (k_x = i_x * stride - padding; k_x < i_x * stride - padding + dim_kernel; k_x++)
+                    {
+                        if (k_y >= 0 && k_x >= 0 && k_y < dim_im_in && k_x < dim_im_in)
+                        {
+                            if (Im_in[i_ch_in + in_pixel_stride * (k_x + k_y * dim_im_in)] > max)
+                            {
+                                max = Im_in[i_ch_in + in_pixel_stride * (k_x + k_y * dim_im_in)];
+                            }
+                        }
+                    }
+                }
+                Im_out[i_ch_in + out_pixel_stride * (i_x + i_y * dim_im_out)] = max;
+            }
         }
+    }
 
-        /* copy over the first row */
-        arm_q7_to_q15_no_shift(row_start, buffer, dim_im_out * ch_im_in);
-        count = 1;
+#endif                          /* ARM_MATH_DSP */
 
-        /* move over to next row */
-        row_start += ch_im_in * dim_im_in;
+}
 
-        for (; row_start < row_end; row_start += dim_im_in * ch_im_in)
+  /**
+   * @brief Q7 average pooling function
+   * @param[in,out]   Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       padding     padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @return none.
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size:  0
+   *
+   * Every output pixel sums its whole window in one pass and divides
+   * with a reciprocal multiply, which rounds toward zero like the
+   * reference implementation. The reciprocal is only recomputed when
+   * the window is clipped by the border.
+   *
+   * The input tensor is not modified. dim_kernel must be below 256.
+   *
+   */
+
+void
+arm_avepool_q7_HWC(q7_t * Im_in,
+                   const uint16_t dim_im_in,
+                   const uint16_t ch_im_in,
+                   const uint16_t dim_kernel,
+                   const uint16_t padding,
+                   const uint16_t stride, const uint16_t dim_im_out, q7_t * bufferA, q7_t * Im_out)
+{
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    int16_t   i_x, i_y;
+    arm_nn_recip recip;
+    int32_t   count = 0;
+
+    for (i_y = 0; i_y < dim_im_out; i_y++)
+    {
+        int16_t   y0 = i_y * stride - padding;
+        int16_t   y1 = y0 + dim_kernel;
+
+        if (y0 < 0)
         {
-            accumulate_q7_to_q15(buffer, row_start, dim_im_out * ch_im_in);
-            count++;
+            y0 = 0;
+        }
+        if (y1 > dim_im_in)
+        {
+            y1 = dim_im_in;
+        }
+
+        for (i_x = 0; i_x < dim_im_out; i_x++)
+        {
+            int16_t   x0 = i_x * stride - padding;
+            int16_t   x1 = x0 + dim_kernel;
+
+            if (x0 < 0)
+            {
+                x0 = 0;
+            }
+            if (x1 > dim_im_in)
+            {
+                x1 = dim_im_in;
+            }
+
+            /* the divisor only changes at the borders */
+            if ((y1 - y0) * (x1 - x0) != count)
+            {
+                count = (y1 - y0) * (x1 - x0);
+                arm_nn_recip_init(&recip, count);
+            }
+
+            avepool_window_q7(Im_in, dim_im_in, ch_im_in, y0, y1, x0, x1, &recip,
+                              Im_out + (i_y * dim_im_out + i_x) * ch_im_in);
         }
-        buffer_scale_back_q15_to_q7(buffer, target, dim_im_out * ch_im_in, count);
     }
 
 #else
@@ -441,6 +591,57 @@ arm_avepool_q7_HWC(q7_t * Im_in,
 
 #endif                          /* ARM_MATH_DSP */
 
+}
+
+  /**
+   * @brief Q7 global average pooling function
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimention
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in,out]   Im_out      pointer to output vector
+   * @return none.
+   *
+   * @details
+   *
+   * Averages every channel over the whole image into a vector of
+   * ch_im_in values, the same as arm_avepool_q7_HWC with dim_kernel
+   * equal to dim_im_in. dim_im_in must be below 256.
+   *
+   */
+
+void
+arm_global_avepool_q7_HWC(const q7_t * Im_in,
+                          const uint16_t dim_im_in,
+                          const uint16_t ch_im_in,
+                          q7_t * Im_out)
+{
+
+#if defined (ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    arm_nn_recip recip;
+
+    arm_nn_recip_init(&recip, dim_im_in * dim_im_in);
+    avepool_window_q7(Im_in, dim_im_in, ch_im_in, 0, dim_im_in, 0, dim_im_in, &recip, Im_out);
+
+#else
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+
+    int16_t   i_ch_in;
+    int32_t   i;
+
+    for (i_ch_in = 0; i_ch_in < ch_im_in; i_ch_in++)
+    {
+        int       sum = 0;
+        for (i = 0; i < dim_im_in * dim_im_in; i++)
+        {
+            sum += Im_in[i_ch_in + ch_im_in * i];
+        }
+        Im_out[i_ch_in] = sum / (dim_im_in * dim_im_in);
+    }
+
+#endif                          /* ARM_MATH_DSP */
+
 }
 
 /**
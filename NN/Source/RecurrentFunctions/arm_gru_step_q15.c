@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_gru_step_q15.c
+ * Description:  Mixed Q15-Q7 GRU cell step
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Recurrent
+ * @{
+ */
+
+  /**
+   * @brief Mixed Q15-Q7 GRU cell step
+   * @param[in]       x               pointer to input vector
+   * @param[in]       dim_x           length of the input vector
+   * @param[in]       dim_h           number of cells
+   * @param[in]       gate_wt         pointer to the concatenated update and reset gate weights
+   * @param[in]       gate_bias       pointer to the concatenated update and reset gate bias
+   * @param[in]       cand_wt         pointer to the candidate weights
+   * @param[in]       cand_bias       pointer to the candidate bias
+   * @param[in]       bias_shift      amount of left-shift for bias
+   * @param[in]       out_shift       amount of right-shift for the pre-activations
+   * @param[in]       gate_int_width  integer bits of the pre-activations, at most 3
+   * @param[in,out]   h               pointer to hidden state, q0.15
+   * @param[in,out]   bufferA         pointer to buffer space for the gates
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size: dim_x + 4 * dim_h
+   *
+   * One time step of
+   *
+   *   z = sigmoid(W_z [x, h] + b_z)
+   *   r = sigmoid(W_r [x, h] + b_r)
+   *   n = tanh(W_n [x, r * h] + b_n)
+   *   h = z * h + (1 - z) * n
+   *
+   * The reset gate is applied before the candidate product, as in the
+   * original formulation (reset_after=False in Keras).
+   *
+   * x and h are copied next to each other in bufferA, so z and r come out
+   * of a single arm_fully_connected_mat_q7_vec_q15_opt() pass over gate_wt,
+   * the 2 * dim_h by (dim_x + dim_h) matrix with the z rows followed by the
+   * r rows. The h part of bufferA is then overwritten with r * h for the
+   * candidate pass over cand_wt, dim_h by (dim_x + dim_h). Each matrix has
+   * the x columns first and is reordered for the opt kernel on its own.
+   *
+   * h is updated in place, so the same state buffer is passed at every
+   * time step.
+   */
+
+arm_status
+arm_gru_step_q15(const q15_t * x,
+                 const uint16_t dim_x,
+                 const uint16_t dim_h,
+                 const q7_t * gate_wt,
+                 const q7_t * gate_bias,
+                 const q7_t * cand_wt,
+                 const q7_t * cand_bias,
+                 const uint16_t bias_shift,
+                 const uint16_t out_shift,
+                 const uint16_t gate_int_width,
+                 q15_t * h,
+                 q15_t * bufferA)
+{
+    q15_t    *xh = bufferA;
+    q15_t    *gate_z = xh + dim_x + dim_h;
+    q15_t    *gate_r = gate_z + dim_h;
+    q15_t    *cand = gate_r + dim_h;
+    uint16_t  i;
+
+    memcpy(xh, x, dim_x * sizeof(q15_t));
+    memcpy(xh + dim_x, h, dim_h * sizeof(q15_t));
+
+    arm_fully_connected_mat_q7_vec_q15_opt(xh, gate_wt, dim_x + dim_h, 2 * dim_h, bias_shift, out_shift, gate_bias, gate_z, NULL);
+    arm_nn_activations_fast_q15(gate_z, 2 * dim_h, gate_int_width, ARM_SIGMOID);
+
+    arm_nn_mult_q15(gate_r, h, xh + dim_x, 15, dim_h);
+
+    arm_fully_connected_mat_q7_vec_q15_opt(xh, cand_wt, dim_x + dim_h, dim_h, bias_shift, out_shift, cand_bias, cand, NULL);
+    arm_nn_activations_fast_q15(cand, dim_h, gate_int_width, ARM_TANH);
+
+    /* h = z * h + (1 - z) * n, r is free again and holds 1 - z */
+    for (i = 0; i < dim_h; i++)
+    {
+        gate_r[i] = 0x7FFF - gate_z[i];
+    }
+    arm_nn_mult_q15(gate_z, h, h, 15, dim_h);
+    arm_nn_mult_q15(gate_r, cand, cand, 15, dim_h);
+    arm_nn_add_q15(h, cand, h, dim_h);
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of Recurrent group
+ */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_lstm_step_q15.c
+ * Description:  Mixed Q15-Q7 LSTM cell step
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Recurrent
+ * @{
+ */
+
+  /**
+   * @brief Mixed Q15-Q7 LSTM cell step
+   * @param[in]       x               pointer to input vector
+   * @param[in]       dim_x           length of the input vector
+   * @param[in]       dim_h           number of cells
+   * @param[in]       wt              pointer to the concatenated gate weights
+   * @param[in]       bias            pointer to the concatenated gate bias
+   * @param[in]       bias_shift      amount of left-shift for bias
+   * @param[in]       out_shift       amount of right-shift for the gate pre-activations
+   * @param[in]       gate_int_width  integer bits of the gate pre-activations, at most 3
+   * @param[in]       cell_int_width  integer bits of the cell state, at most 3
+   * @param[in,out]   h               pointer to hidden state, q0.15
+   * @param[in,out]   c               pointer to cell state
+   * @param[in,out]   bufferA         pointer to buffer space for the gates
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * @details
+   *
+   * <b>Buffer size:</b>
+   *
+   * bufferA size: dim_x + 5 * dim_h
+   *
+   * One time step of
+   *
+   *   i = sigmoid(W_i [x, h] + b_i)
+   *   f = sigmoid(W_f [x, h] + b_f)
+   *   g = tanh(W_g [x, h] + b_g)
+   *   o = sigmoid(W_o [x, h] + b_o)
+   *   c = f * c + i * g
+   *   h = o * tanh(c)
+   *
+   * x and h are copied next to each other in bufferA, so the four gates
+   * come out of a single arm_fully_connected_mat_q7_vec_q15_opt() pass.
+   * wt is the 4 * dim_h by (dim_x + dim_h) matrix with the rows of the
+   * i, f, g and o gates stacked in that order and each row holding the x
+   * columns followed by the h columns, reordered as a whole for the opt
+   * kernel. All gates therefore share bias_shift and out_shift.
+   *
+   * h and c are updated in place, so the same state buffers are passed
+   * at every time step.
+   */
+
+arm_status
+arm_lstm_step_q15(const q15_t * x,
+                  const uint16_t dim_x,
+                  const uint16_t dim_h,
+                  const q7_t * wt,
+                  const q7_t * bias,
+                  const uint16_t bias_shift,
+                  const uint16_t out_shift,
+                  const uint16_t gate_int_width,
+                  const uint16_t cell_int_width,
+                  q15_t * h,
+                  q15_t * c,
+                  q15_t * bufferA)
+{
+    q15_t    *xh = bufferA;
+    q15_t    *gate_i = xh + dim_x + dim_h;
+    q15_t    *gate_f = gate_i + dim_h;
+    q15_t    *gate_g = gate_f + dim_h;
+    q15_t    *gate_o = gate_g + dim_h;
+
+    memcpy(xh, x, dim_x * sizeof(q15_t));
+    memcpy(xh + dim_x, h, dim_h * sizeof(q15_t));
+
+    arm_fully_connected_mat_q7_vec_q15_opt(xh, wt, dim_x + dim_h, 4 * dim_h, bias_shift, out_shift, bias, gate_i, NULL);
+
+    /* i and f are adjacent */
+    arm_nn_activations_fast_q15(gate_i, 2 * dim_h, gate_int_width, ARM_SIGMOID);
+    arm_nn_activations_fast_q15(gate_g, dim_h, gate_int_width, ARM_TANH);
+    arm_nn_activations_fast_q15(gate_o, dim_h, gate_int_width, ARM_SIGMOID);
+
+    /* c = f * c + i * g, the gates are q0.15 and i * g is brought to the format of c */
+    arm_nn_mult_q15(gate_f, c, c, 15, dim_h);
+    arm_nn_mult_q15(gate_i, gate_g, gate_g, 15 + cell_int_width, dim_h);
+    arm_nn_add_q15(c, gate_g, c, dim_h);
+
+    /* h = o * tanh(c), g is free again */
+    memcpy(gate_g, c, dim_h * sizeof(q15_t));
+    arm_nn_activations_fast_q15(gate_g, dim_h, cell_int_width, ARM_TANH);
+    arm_nn_mult_q15(gate_o, gate_g, h, 15, dim_h);
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of Recurrent group
+ */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_topk_q31.c
+ * Description:  Top-k selection on Q31 scores
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Softmax
+ * @{
+ */
+
+  /**
+   * @brief Top-k selection on Q31 scores
+   * @param[in]       vec_in      pointer to input vector
+   * @param[in]       dim_vec     input vector dimention
+   * @param[in]       k           number of indices to return, 0 < k <= dim_vec
+   * @param[out]      p_idx       pointer to the k indices, best first
+   * @param[out]      p_margin    pointer to the k margins, or NULL
+   * @return none.
+   *
+   * @details
+   *
+   *  Finds the k largest scores in a single pass, e.g. on the output of
+   *  arm_fully_connected_q7_opt_q31, so that a classifier does not need
+   *  to requantize to q7 and run the softmax to know the winning classes.
+   *  Equal scores keep the lower index first.
+   *
+   *  p_margin[i] is the score of p_idx[i] minus the score of the next
+   *  best index, i.e. p_margin[0] is how far the winner is ahead of the
+   *  runner-up. The last margin is 0 when k equals dim_vec. The
+   *  subtraction saturates.
+   *
+   */
+
+void arm_nn_topk_q31(const q31_t * vec_in,
+                     const uint16_t dim_vec,
+                     const uint16_t k,
+                     uint16_t * p_idx,
+                     q31_t * p_margin)
+{
+    uint16_t  i, j;
+    uint16_t  found = 0;
+    q31_t     next = 0;
+    uint8_t   next_valid = 0;
+
+    for (i = 0; i < dim_vec; i++)
+    {
+        q31_t     value = vec_in[i];
+
+        if (found == k)
+        {
+            /* list is full: it only takes values above its last entry */
+            if (value <= vec_in[p_idx[k - 1]])
+            {
+                if (!next_valid || value > next)
+                {
+                    next = value;
+                    next_valid = 1;
+                }
+                continue;
+            }
+            /* the last entry drops out and becomes a candidate for next */
+            if (!next_valid || vec_in[p_idx[k - 1]] > next)
+            {
+                next = vec_in[p_idx[k - 1]];
+                next_valid = 1;
+            }
+            j = k - 1;
+        } else
+        {
+            j = found++;
+        }
+
+        /* insertion, strictly greater so that earlier indices stay ahead */
+        while (j > 0 && value > vec_in[p_idx[j - 1]])
+        {
+            p_idx[j] = p_idx[j - 1];
+            j--;
+        }
+        p_idx[j] = i;
+    }
+
+    if (p_margin != NULL)
+    {
+        for (i = 0; i + 1 < k; i++)
+        {
+            p_margin[i] = __QSUB(vec_in[p_idx[i]], vec_in[p_idx[i + 1]]);
+        }
+        p_margin[k - 1] = next_valid ? __QSUB(vec_in[p_idx[k - 1]], next) : 0;
+    }
+}
+
+/**
+ * @} end of Softmax group
+ */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_softmax_q31_q7.c
+ * Description:  Q7 softmax function on Q31 scores
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Softmax
+ * @{
+ */
+
+  /**
+   * @brief Q7 softmax function on Q31 scores
+   * @param[in]       vec_in      pointer to input vector
+   * @param[in]       dim_vec     input vector dimention
+   * @param[in]       out_shift   amount of right-shift to bring the input to q7
+   * @param[out]      p_out       pointer to output vector
+   * @return none.
+   *
+   * @details
+   *
+   *  Rounds, shifts and saturates the scores to q7 as the q7 output of
+   *  the layer would have been, then runs arm_softmax_q7. Together with
+   *  arm_fully_connected_q7_opt_q31 this gives the same probabilities as
+   *  arm_fully_connected_q7_opt followed by arm_softmax_q7, but only
+   *  when they are asked for.
+   *
+   */
+
+void arm_softmax_q31_q7(const q31_t * vec_in, const uint16_t dim_vec, const uint16_t out_shift, q7_t * p_out)
+{
+    int16_t   i;
+
+    for (i = 0; i < dim_vec; i++)
+    {
+        p_out[i] = (q7_t) __SSAT(((vec_in[i] + NN_ROUND(out_shift)) >> out_shift), 8);
+    }
+
+    arm_softmax_q7(p_out, dim_vec, p_out);
+}
+
+/**
+ * @} end of Softmax group
+ */
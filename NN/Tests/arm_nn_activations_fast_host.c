@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2010-2018 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_activations_fast_host.c
+ * Description:  Host test of the paired and word-wide table look-up activations
+ *
+ * $Date:        19. October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  x86 hosts
+ *
+ * -------------------------------------------------------------------- */
+
+/*
+ * Checks arm_nn_activations_fast_q15() and arm_nn_activations_fast_q7()
+ * against the scalar look-up of arm_nn_activations_direct_q15() and
+ * arm_nn_activations_direct_q7(), bit for bit, on every input value, for
+ * both activations and every int_width, with sizes that leave each tail
+ * length of the vector loops. Build it once per vector path, with an
+ * arm_math.h for the host:
+ *
+ *   gcc -O2 -msse2 -I<arm_math> -INN/Include NN/Tests/arm_nn_activations_fast_host.c \
+ *       NN/Source/ActivationFunctions/arm_nn_activations_*.c NN/Source/NNSupportFunctions/arm_nntables.c
+ *   gcc -O2 -mavx2 ...
+ *
+ * and with -DARM_MATH_DSP where arm_math.h emulates the DSP intrinsics.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+
+/* every q15 value twice, so each size below reaches all of them */
+#define TEST_Q15_LEN    (2 * 65536 + 16)
+#define TEST_Q7_LEN     (2 * 256 + 32)
+
+static q15_t in_q15[TEST_Q15_LEN], ref_q15[TEST_Q15_LEN], out_q15[TEST_Q15_LEN];
+static q7_t  in_q7[TEST_Q7_LEN], ref_q7[TEST_Q7_LEN], out_q7[TEST_Q7_LEN];
+
+static const char *const type_name[] = { "sigmoid", "tanh" };
+
+/**
+ * @brief Compares the fast q15 look-up with the direct one
+ * @param[in]       type        type of activation functions
+ * @param[in]       int_width   bit-width of the integer part
+ * @param[in]       offset      first element, shifts the vector alignment
+ * @param[in]       size        number of elements
+ * @return number of elements that differ.
+ */
+
+static uint32_t test_q15(arm_nn_activation_type type, uint16_t int_width, uint32_t offset, uint16_t size)
+{
+    uint32_t  errors = 0;
+    uint32_t  i;
+
+    memcpy(ref_q15, in_q15, sizeof(in_q15));
+    memcpy(out_q15, in_q15, sizeof(in_q15));
+    arm_nn_activations_direct_q15(ref_q15 + offset, size, int_width, type);
+    arm_nn_activations_fast_q15(out_q15 + offset, size, int_width, type);
+
+    for (i = 0; i < TEST_Q15_LEN; i++)
+    {
+        if (out_q15[i] != ref_q15[i])
+        {
+            if (errors++ == 0)
+            {
+                printf("q15 %s int_width %u size %u: in %d out %d expected %d\n", type_name[type],
+                       int_width, size, in_q15[i], out_q15[i], ref_q15[i]);
+            }
+        }
+    }
+    return errors;
+}
+
+/**
+ * @brief Compares the fast q7 look-up with the direct one
+ * @param[in]       type        type of activation functions
+ * @param[in]       int_width   bit-width of the integer part
+ * @param[in]       offset      first element, shifts the vector alignment
+ * @param[in]       size        number of elements
+ * @return number of elements that differ.
+ */
+
+static uint32_t test_q7(arm_nn_activation_type type, uint16_t int_width, uint32_t offset, uint16_t size)
+{
+    uint32_t  errors = 0;
+    uint32_t  i;
+
+    memcpy(ref_q7, in_q7, sizeof(in_q7));
+    memcpy(out_q7, in_q7, sizeof(in_q7));
+    arm_nn_activations_direct_q7(ref_q7 + offset, size, int_width, type);
+    arm_nn_activations_fast_q7(out_q7 + offset, size, int_width, type);
+
+    for (i = 0; i < TEST_Q7_LEN; i++)
+    {
+        if (out_q7[i] != ref_q7[i])
+        {
+            if (errors++ == 0)
+            {
+                printf("q7 %s int_width %u size %u: in %d out %d expected %d\n", type_name[type],
+                       int_width, size, in_q7[i], out_q7[i], ref_q7[i]);
+            }
+        }
+    }
+    return errors;
+}
+
+int main(void)
+{
+    uint32_t  errors = 0;
+    uint32_t  checked = 0;
+    uint32_t  i;
+    uint16_t  int_width;
+    uint16_t  tail;
+    int       type;
+
+    for (i = 0; i < TEST_Q15_LEN; i++)
+    {
+        in_q15[i] = (q15_t) (i * 40503u);
+    }
+    for (i = 0; i < TEST_Q7_LEN; i++)
+    {
+        in_q7[i] = (q7_t) (i * 167u);
+    }
+
+    for (type = ARM_SIGMOID; type <= ARM_TANH; type++)
+    {
+        for (int_width = 0; int_width < 3; int_width++)
+        {
+            /* sizes are uint16_t, so the q15 runs cover the values in two halves */
+            for (tail = 0; tail < 16; tail++)
+            {
+                uint16_t  size_lo = 65535 - tail;
+                uint16_t  size_hi = 65521 + tail;
+                uint16_t  size_q7 = 2 * 256 + tail;
+
+                errors += test_q15((arm_nn_activation_type) type, int_width, tail, size_lo);
+                errors += test_q15((arm_nn_activation_type) type, int_width, 65535, size_hi);
+                errors += test_q7((arm_nn_activation_type) type, int_width, tail, size_q7);
+                checked += (uint32_t) size_lo + size_hi + size_q7;
+            }
+        }
+    }
+
+    printf("%u elements, %u mismatches %s\n", checked, errors, errors == 0 ? "OK" : "FAILED");
+    return errors == 0 ? 0 : 1;
+}